@@ -2,6 +2,8 @@ import argparse
 import os
 import shutil
 
+from data_schema import generate_data_schemas
+
 try:
     import yaml
 
@@ -133,8 +135,8 @@ def get_branch_name():
         return None
 
 
-def create_build(source_folder, emulator_folder):
-    build_folder = "build/"
+def create_build(source_folder, emulator_folder, build_root="build/"):
+    build_folder = build_root
     # avoid deleting the whole sd so we can simulate a proper reboot
     if os.path.exists(os.path.join(build_folder, "lib/")):
         shutil.rmtree(os.path.join(build_folder, "lib/"))
@@ -187,7 +189,7 @@ def create_build(source_folder, emulator_folder):
     # shutil.copy2("flight/core/data_handler.py", "build/lib/core/data_handler.py")
     with open("flight/core/data_handler.py", "r") as file:
         updated_content = file.read().replace('_HOME_PATH = "/sd"', '_HOME_PATH = "sd"')
-    with open("build/lib/core/data_handler.py", "w") as file:
+    with open(os.path.join(build_folder, "core/data_handler.py"), "w") as file:
         file.write(updated_content)
 
     # Create main.py file with single import statement "import main_module"
@@ -227,6 +229,14 @@ if __name__ == "__main__":
         help="emulator folder path",
         required=False,
     )
+    parser.add_argument(
+        "-b",
+        "--build_folder",
+        type=str,
+        default="build/",
+        help="Build folder path, one per concurrent emulator instance",
+        required=False,
+    )
     parser.add_argument(
         "--flight",
         action="store_true",
@@ -238,6 +248,7 @@ if __name__ == "__main__":
     emulator_folder = args.emulator_folder
 
     generate_satellite_config(source_folder, use_flight_config=args.flight)
+    generate_data_schemas(source_folder)
 
     GIT_BRANCH = get_branch_name()
     GIT_COMMIT = get_commit_hash()
@@ -246,4 +257,4 @@ if __name__ == "__main__":
     if GIT_COMMIT:
         print(f"Commit: {GIT_COMMIT}")
 
-    build_folder = create_build(source_folder, emulator_folder)
+    build_folder = create_build(source_folder, emulator_folder, args.build_folder)
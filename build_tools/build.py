@@ -10,6 +10,8 @@ import re
 import shutil
 import sys
 
+from data_schema import generate_data_schemas
+
 try:
     import yaml
 
@@ -241,10 +243,49 @@ def generate_satellite_config(source_folder, use_flight_config=False):
         print(f"Failed to generate satellite_config.py from {yaml_path}: {e}")
 
 
-def create_build(source_folder, flight_build):
+# Frozen flight core variant: these packages are staged as .py sources in FROZEN_BUILD_FOLDER for FROZEN_MPY_DIRS
+# (see firmware/Mainboard v4/mpconfigboard.mk) instead of being compiled to .mpy files on the filesystem.
+# MicroPython can not split a package between the firmware and the filesystem, so the mission-configurable modules
+# of a frozen package (configuration, and the tunable gains and thresholds) are kept on flash as top-level modules,
+# and the frozen package gets a stub importing them. They can be changed without a firmware rebuild.
+FROZEN_BUILD_FOLDER = "build_frozen/"
+FROZEN_PACKAGES = ("core", "hal", "apps")
+FROZEN_ON_FLASH = {
+    os.path.join("core", "satellite_config.py"): "satellite_config",
+    os.path.join("core", "task_configuration.py"): "task_configuration",
+    os.path.join("apps", "adcs", "consts.py"): "adcs_consts",  # controller gains, mode thresholds, bus parameters
+    os.path.join("apps", "eps", "eps.py"): "eps_consts",  # SOC, temperature and power thresholds
+}
+
+
+def stage_frozen_module(source_path, relative_path):
+    """
+    Stage a module of a frozen package for the firmware build.
+
+    Returns the build path of the module when it stays on flash, or None once it has been staged.
+    """
+    frozen_path = os.path.join(FROZEN_BUILD_FOLDER, relative_path)
+    os.makedirs(os.path.dirname(frozen_path), exist_ok=True)
+
+    if relative_path in FROZEN_ON_FLASH:
+        module_name = FROZEN_ON_FLASH[relative_path]
+        with open(frozen_path, "w") as f:
+            f.write("# Frozen stub - the module is kept on flash to stay configurable without a firmware rebuild\n")
+            f.write(f"from {module_name} import *  # noqa: F401,F403\n")
+        print(f"Staged stub {frozen_path} for {module_name}.py on flash")
+        return module_name + ".py"
+
+    shutil.copy2(source_path, frozen_path)
+    print(f"Staged {source_path} to {frozen_path}")
+    return None
+
+
+def create_build(source_folder, flight_build, frozen_build=False):
     build_folder = "build/"
     if os.path.exists(build_folder):
         shutil.rmtree(build_folder)
+    if os.path.exists(FROZEN_BUILD_FOLDER):
+        shutil.rmtree(FROZEN_BUILD_FOLDER)
 
     build_folder = os.path.join(build_folder, "lib/")
 
@@ -265,8 +306,14 @@ def create_build(source_folder, flight_build):
         for file in files:
             if file.endswith(".py") or file.endswith(".mpy"):
                 source_path = os.path.join(root, file)
+                relative_path = os.path.relpath(source_path, source_folder)
+
+                if frozen_build and relative_path.split(os.sep)[0] in FROZEN_PACKAGES and file.endswith(".py"):
+                    relative_path = stage_frozen_module(source_path, relative_path)
+                    if relative_path is None:
+                        continue
 
-                build_path = os.path.join(build_folder, os.path.relpath(source_path, source_folder))
+                build_path = os.path.join(build_folder, relative_path)
 
                 os.makedirs(os.path.dirname(build_path), exist_ok=True)
                 shutil.copy2(source_path, build_path)
@@ -282,8 +329,8 @@ def create_build(source_folder, flight_build):
                     os.rename("main.py", "main_module.py")
                     file_name = "main_module.py"
                 else:
-                    # Extract file name
-                    file_name = os.path.basename(file)
+                    # Extract file name (renamed for the modules of frozen packages kept on flash)
+                    file_name = os.path.basename(build_path)
 
                 if file_name.endswith(".py"):
                     try:
@@ -302,6 +349,8 @@ def create_build(source_folder, flight_build):
         f.write('print("")\n')
         f.write('print("################################")\n')
         f.write(f'print("Build Config: {"FLIGHT" if flight_build else "GROUND"}")\n')
+        if frozen_build:
+            f.write(f'print("Frozen flight core: {", ".join(FROZEN_PACKAGES)}")\n')
         if GIT_BRANCH:
             f.write(f'print("Branch: {GIT_BRANCH}")\n')
         if GIT_COMMIT:
@@ -334,6 +383,11 @@ if __name__ == "__main__":
         action="store_true",
         help="Use flight.yaml configuration instead of ground.yaml",
     )
+    parser.add_argument(
+        "--frozen",
+        action="store_true",
+        help="Stage the flight core for a frozen firmware build and keep only the rest on the filesystem",
+    )
     args = parser.parse_args()
 
     source_folder = args.source_folder
@@ -342,6 +396,7 @@ if __name__ == "__main__":
     check_directory_location(source_folder)
 
     generate_satellite_config(source_folder, use_flight_config=flight_build)
+    generate_data_schemas(source_folder)
 
     if GIT_BRANCH:
         print(f"Branch: {GIT_BRANCH}")
@@ -355,4 +410,4 @@ if __name__ == "__main__":
     print(f"CircuitPython version: {CPY_VERSION}")
     print(f"Board ID: {BOARD_ID}")
 
-    create_build(source_folder, flight_build)
+    create_build(source_folder, flight_build, frozen_build=args.frozen)
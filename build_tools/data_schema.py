@@ -0,0 +1,125 @@
+"""
+Data process schema generation for Argus
+
+Compiles configuration/data_schema.yaml into one core/schemas/<tag>.py module per data process, so the index
+constants, struct formats and byte offsets of every record are fixed at build time instead of being kept in sync
+by hand and parsed again on the satellite.
+"""
+
+import os
+import shutil
+import struct
+
+try:
+    import yaml
+
+    _HAS_YAML = True
+except Exception:
+    yaml = None
+    _HAS_YAML = False
+
+SCHEMA_FILE = "data_schema.yaml"
+
+# Same characters and sizes as DataProcess._FORMAT
+_FORMAT_CHARACTERS = "bBhHiIlLqQfde"
+
+
+def load_data_schema(yaml_path):
+    """
+    Load the data process schemas.
+
+    Args:
+        yaml_path: Path to data_schema.yaml
+
+    Returns:
+        {tag: [(field name, format character), ...]} in record order
+    """
+    with open(yaml_path, "r") as yf:
+        schema_data = yaml.safe_load(yf) or {}
+
+    schemas = {}
+    for tag, fields in schema_data.items():
+        if not isinstance(fields, dict) or not fields:
+            raise ValueError(f"Data process {tag} has no fields")
+        for name, c in fields.items():
+            if not isinstance(c, str) or len(c) != 1 or c not in _FORMAT_CHARACTERS:
+                raise ValueError(f"Invalid format character {c!r} for {tag}.{name}")
+        schemas[tag] = list(fields.items())
+    return schemas
+
+
+def schema_module_lines(tag, fields, schema_file=SCHEMA_FILE):
+    """
+    Source lines of the schema module of one data process.
+    """
+    data_format = "".join(c for _, c in fields)
+    offsets = []
+    offset = 0
+    for _, c in fields:
+        offsets.append(offset)
+        offset += struct.calcsize("<" + c)
+
+    lines = [
+        "# Auto-generated from " + schema_file,
+        "# Do not edit - changes will be overwritten by the build system.",
+        "",
+        "from micropython import const",
+        "",
+        f'TAG = "{tag}"',
+        f'FORMAT = "{data_format}"',
+        f"BYTESIZE = const({offset})",
+        "",
+        "",
+        f"class {tag.upper()}_IDX:",
+    ]
+    lines += [f"    {name} = const({i})" for i, (name, _) in enumerate(fields)]
+    lines += ["", "", "# pack_into/unpack_from format of each field, in index order", "FIELD_FORMATS = ("]
+    lines += [f'    "<{c}",' for _, c in fields]
+    lines += [")", "", "# Byte offset of each field in the record, in index order", "OFFSETS = ("]
+    lines += [f"    {o}," for o in offsets]
+    lines += [")", ""]
+    return lines
+
+
+def generate_data_schemas(source_folder):
+    """
+    Generate the core/schemas modules from data_schema.yaml.
+
+    Args:
+        source_folder: Path to the flight source folder
+    """
+    if not _HAS_YAML:
+        raise ImportError("PyYAML is not installed; cannot generate the data process schemas")
+
+    yaml_path = os.path.join(source_folder, "configuration", SCHEMA_FILE)
+    if not os.path.exists(yaml_path):
+        raise FileNotFoundError(f"Schema file {yaml_path} not found; cannot generate the data process schemas")
+
+    schemas = load_data_schema(yaml_path)
+
+    # Written next to core/schemas and swapped in once complete, a failed build leaves the previous modules in place
+    schemas_folder = os.path.join(source_folder, "core", "schemas")
+    staging_folder = schemas_folder + ".tmp"
+    if os.path.exists(staging_folder):
+        shutil.rmtree(staging_folder)  # left over by an interrupted build
+    os.makedirs(staging_folder)
+    try:
+        with open(os.path.join(staging_folder, "__init__.py"), "w") as py_file:
+            py_file.write(
+                "# Auto-generated from " + SCHEMA_FILE + "\n"
+                "# Do not edit - changes will be overwritten by the build system.\n"
+                "# One schema module per data process: " + ", ".join(schemas) + "\n"
+            )
+
+        for tag, fields in schemas.items():
+            with open(os.path.join(staging_folder, f"{tag}.py"), "w") as py_file:
+                py_file.write("\n".join(schema_module_lines(tag, fields)))
+
+        if os.path.exists(schemas_folder):
+            shutil.rmtree(schemas_folder)  # drop the modules of removed processes
+        os.rename(staging_folder, schemas_folder)
+    finally:
+        if os.path.exists(staging_folder):
+            shutil.rmtree(staging_folder)
+
+    print(f"Generated {len(schemas)} data process schemas in {schemas_folder} from {SCHEMA_FILE}")
@@ -1,19 +1,33 @@
 """
 This module provides a custom accelerated time module for the emulator for testing purposes.
 
+Two modes are available:
+    - Accelerated (default): wall time scaled by SIM_REAL_SPEEDUP.
+    - Lockstep (SIM_LOCKSTEP=1): a virtual clock decoupled from the wall clock. sleep() jumps the clock forward
+      instead of blocking, so the scheduler goes straight to the next task resume time and runs as fast as the
+      host allows. Every clock read advances the clock by a fixed tick so time is strictly increasing and the
+      run is reproducible. SIM_LOCKSTEP_DURATION (virtual seconds) ends the process once reached.
+
+SIM_FAST_BOOT=1 additionally turns hardware settle delays (settle(), reached through TPM.settle) into no-ops,
+so boot and power sequencing take no time at all. Combined with lockstep this is the headless fast-boot mode
+of `./run.sh emulate fast`.
+
 Author: Ibrahima S. Sow, Karthik Karumanchi
 
 """
 
 import os
+import sys
 import time as real_time
 
 real_time_module = real_time
 
+_LOCKSTEP_TICK_NS = 1000  # virtual time consumed by each clock read in lockstep mode
+
 
 class MockTime:
     def __init__(self):
-        self.acceleration = int(os.environ["SIM_REAL_SPEEDUP"])
+        self.acceleration = int(os.getenv("SIM_REAL_SPEEDUP", 1))
 
         # Datum references for Speedup
         self.start_real_time = real_time.time_ns() / 1.0e9
@@ -27,28 +41,60 @@ class MockTime:
 
         self.start_simulated_time = real_time.time()
 
+        # Lockstep virtual clock, elapsed nanoseconds since start
+        self.lockstep = bool(int(os.getenv("SIM_LOCKSTEP", 0)))
+        self.virtual_ns = 0
+        duration = os.getenv("SIM_LOCKSTEP_DURATION")
+        self.lockstep_stop_ns = int(float(duration) * 1e9) if duration else None
+
+        self.fast_boot = bool(int(os.getenv("SIM_FAST_BOOT", 0)))
+
+    def _virtual_elapsed_ns(self):
+        self.virtual_ns += _LOCKSTEP_TICK_NS
+        return self.virtual_ns
+
     def time(self):
+        if self.lockstep:
+            return self.start_real_time + self._virtual_elapsed_ns() / 1.0e9
         real_elapsed = real_time.time_ns() / 1.0e9 - self.start_real_time
         self.spedup_time = self.start_real_time + real_elapsed * self.acceleration
         return self.spedup_time
 
     def time_ns(self):
+        if self.lockstep:
+            return self.start_real_time_ns + self._virtual_elapsed_ns()
         real_elapsed = real_time.time_ns() - self.start_real_time_ns
         self.spedup_time_ns = self.start_real_time_ns + real_elapsed * self.acceleration
         return self.spedup_time_ns
 
     def sleep(self, seconds):
+        if self.lockstep:
+            if seconds > 0:
+                self.virtual_ns += int(round(seconds * 1e9))
+            if self.lockstep_stop_ns is not None and self.virtual_ns >= self.lockstep_stop_ns:
+                print(f"Lockstep simulation reached {self.virtual_ns / 1e9:.1f} s, stopping")
+                sys.exit(0)
+            return
         real_time.sleep(seconds / self.acceleration)
 
+    def settle(self, seconds):
+        # Pure hardware settle delay (power rails, pin sequencing), nothing to wait for in fast-boot mode
+        if not self.fast_boot:
+            self.sleep(seconds)
+
     def localtime(self, secs=None):
         simulated_secs = self.time() if secs is None else secs
         return real_time.localtime(simulated_secs)
 
     def monotonic(self):
+        if self.lockstep:
+            return self._virtual_elapsed_ns() / 1.0e9
         real_elapsed = real_time.monotonic_ns() / 1.0e9 - self.start_real_time_monotonic
         return real_elapsed * self.acceleration
 
     def monotonic_ns(self):
+        if self.lockstep:
+            return self._virtual_elapsed_ns()
         real_elapsed = real_time.monotonic_ns() - self.start_real_time_monotonic_ns
         return real_elapsed * self.acceleration
 
@@ -67,6 +113,8 @@ class MockTime:
             return self.time
         if name == "sleep":
             return self.sleep
+        if name == "settle":
+            return self.settle
         if name == "localtime":
             return self.localtime
         if name == "monotonic":
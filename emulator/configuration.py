@@ -11,6 +11,9 @@ from hal.emulator import EmulatedSatellite
 DEBUG_MODE = True
 SIMULATION = bool(int(os.getenv("ARGUS_SIMULATION_FLAG", 0)))
 SOCKET_RADIO = False
+# Shared RF channel broker (sil/rf_broker.py) "host:port", and the name of this node on it
+RF_CHANNEL = os.getenv("ARGUS_RF_CHANNEL")
+RF_NODE_NAME = os.getenv("ARGUS_RF_NODE", "sat")
 
 SimulatedSpacecraft = None
 if SIMULATION:
@@ -23,6 +26,15 @@ if SIMULATION:
     trial = int(os.getenv("ARGUS_SIMULATION_TRIAL", random.randint(0, 100)))
     trial_date = os.getenv("ARGUS_SIMULATION_DATE", datetime.now().strftime("%Y-%m-%d_%H-%M-%S"))
     sim_set_name = os.getenv("ARGUS_SIMULATION_SET_NAME", "sil_set_1")
+    if bool(int(os.getenv("SIM_LOCKSTEP", 0))):
+        # Lockstep runs are meant to be reproducible, seed the emulated device noise with the trial
+        random.seed(trial)
     SimulatedSpacecraft = Simulator(trial=trial, trial_date=trial_date, sim_set_name=sim_set_name)
 
-SATELLITE: CubeSat = EmulatedSatellite(debug=DEBUG_MODE, simulator=SimulatedSpacecraft, use_socket=SOCKET_RADIO)
+SATELLITE: CubeSat = EmulatedSatellite(
+    debug=DEBUG_MODE,
+    simulator=SimulatedSpacecraft,
+    use_socket=SOCKET_RADIO,
+    rf_channel=RF_CHANNEL,
+    rf_node_name=RF_NODE_NAME,
+)
@@ -1,4 +1,5 @@
 import time
+import tracemalloc
 
 enabled = True
 
@@ -8,6 +9,8 @@ def collect():
     emulate gc.collect() by waiting a short time
     """
     time.sleep(0.001)
+    if tracemalloc.is_tracing():
+        tracemalloc.reset_peak()
 
 
 def mem_free():
@@ -20,7 +23,13 @@ def mem_free():
 def mem_alloc():
     """
     just returns a constant value for now
+
+    When memory profiling (SIM_MEM_PROFILE=1, see mem_profiler.py) it is the traced memory high-water mark since the
+    last collect(). CPython frees most objects as soon as they are dropped, while CircuitPython keeps them allocated
+    until the next collection, so the high-water mark is what grows like mem_alloc() does on the board.
     """
+    if tracemalloc.is_tracing():
+        return tracemalloc.get_traced_memory()[1]
     return 20000
 
 
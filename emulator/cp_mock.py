@@ -12,3 +12,8 @@ sys.modules["rtc"] = __import__("rtc_mock")
 sys.modules["gc"] = __import__("gc_mock")
 sys.modules["microcontroller"] = __import__("microcontroller_mock")
 sys.modules["supervisor"] = __import__("supervisor_mock")
+
+if os.getenv("SIM_MEM_PROFILE") == "1":
+    from . import mem_profiler
+
+    mem_profiler.start()
@@ -280,6 +280,16 @@ class CubeSat:
         """
         return self.key_in_device_list("LIGHT_" + dir) and self.__device_list["LIGHT_" + dir].device is not None
 
+    def READ_LIGHT_SENSORS(self, faces, lux, counters) -> int:
+        """Returns the latest simulated reading of the light sensor of each face into lux and counters, and the
+        bitmask of the faces read (simulated results always pass their CRC)."""
+        read = 0
+        for i, face in enumerate(faces):
+            if self.LIGHT_SENSOR_AVAILABLE(face):
+                lux[i], counters[i], _ = self.__device_list["LIGHT_" + face].device.read_latest()
+                read |= 1 << i
+        return read
+
     @property
     def RTC(self):
         """RTC: Returns the RTC object
@@ -23,12 +23,13 @@ class GPS:
         self.hdop = 0
         self.vdop = 0
         self.tdop = 0
-        self.ecef_x = 24161658
-        self.ecef_y = -64844741
-        self.ecef_z = 21809692
-        self.ecef_vx = 66390526
-        self.ecef_vy = 24738890
-        self.ecef_vz = -73684928
+        # ECEF state in m and m/s, like the flight driver
+        self.ecef_x = 241616.58
+        self.ecef_y = -648447.41
+        self.ecef_z = 218096.92
+        self.ecef_vx = 663905.26
+        self.ecef_vy = 247388.90
+        self.ecef_vz = -736849.28
 
     def has_fix(self):
         """True if a current fix for location information is available."""
@@ -44,12 +45,13 @@ class GPS:
             # Simualte all other fields
             ecef_state = self.__simulator.gps()
             self.unix_time = int(ecef_state[0])
-            self.ecef_x = int(ecef_state[1])
-            self.ecef_y = int(ecef_state[2])
-            self.ecef_z = int(ecef_state[3])
-            self.ecef_vx = int(ecef_state[4])
-            self.ecef_vy = int(ecef_state[5])
-            self.ecef_vz = int(ecef_state[6])
+            # Simulator reports cm and cm/s
+            self.ecef_x = float(ecef_state[1]) / 100
+            self.ecef_y = float(ecef_state[2]) / 100
+            self.ecef_z = float(ecef_state[3]) / 100
+            self.ecef_vx = float(ecef_state[4]) / 100
+            self.ecef_vy = float(ecef_state[5]) / 100
+            self.ecef_vz = float(ecef_state[6]) / 100
 
     def enable(self):
         self.__enable = True
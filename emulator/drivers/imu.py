@@ -26,6 +26,8 @@ class IMU:
         self.drop_cmd_err = False
         self.fatal_err = False
 
+        self.fifo_frames = 0
+
     def accel(self):
         return self.__accel if self.__enable else None
 
@@ -41,6 +43,17 @@ class IMU:
             return self.__simulator.gyro()
         return self.__gyro if self.__enable else None
 
+    # The emulated IMU has no FIFO: every drain yields a single frame holding the current sample
+    def drain_fifo(self, max_frames=None):
+        self.fifo_frames = 1 if (self.__simulator or self.__enable) else 0
+        return self.fifo_frames
+
+    def fifo_gyro(self):
+        return self.gyro()
+
+    def fifo_mag(self):
+        return self.mag()
+
     def temperature(self):
         return self.__temp if self.__enable else None
 
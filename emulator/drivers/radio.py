@@ -1,8 +1,11 @@
 import queue
 import random
 import socket
+import threading
 import time
 
+from hal.rf_channel import FRAME_HELLO, FRAME_RX, FRAME_TX, decode_frames, encode_frame, time_on_air
+
 
 class RadioDebug:
     def __init__(self, radio):
@@ -32,7 +35,7 @@ class MockAttribute:
 
 
 class Radio:
-    def __init__(self, use_socket):
+    def __init__(self, use_socket, rf_channel=None, node_name="sat"):
         self.use_socket = use_socket
 
         self.node = 0
@@ -54,6 +57,31 @@ class Radio:
 
         self.test = RadioDebug(self)
 
+        # Shared RF channel (sil/rf_broker.py), "host:port"
+        self._channel = None
+        if rf_channel:
+            self._connect_channel(rf_channel, node_name)
+
+    def _connect_channel(self, rf_channel, node_name):
+        host, port = rf_channel.rsplit(":", 1)
+        self._channel = socket.create_connection((host, int(port)))
+        self._channel.sendall(encode_frame(FRAME_HELLO, f"fsw:{node_name}".encode()))
+        threading.Thread(target=self._channel_rx_loop, daemon=True).start()
+
+    def _channel_rx_loop(self):
+        buffer = b""
+        while True:
+            try:
+                data = self._channel.recv(4096)
+            except OSError:
+                return
+            if not data:
+                return
+            frames, buffer = decode_frames(buffer + data)
+            for frame_type, payload in frames:
+                if frame_type == FRAME_RX:
+                    self._rx_queue.put(payload)
+
     def RX_available(self):
         return not self._rx_queue.empty()
 
@@ -84,8 +112,26 @@ class Radio:
     def startReceive(self, timeout=0xFFFFFF):
         return  # no need to do anything here
 
+    def startReceiveDutyCycle(self, rxPeriod, sleepPeriod):
+        return  # no need to do anything here
+
+    def startReceiveDutyCycleAuto(self, senderPreambleLength=0, minSymbols=8):
+        return  # no need to do anything here
+
+    def recv(self, len=0, timeout_en=False, timeout_ms=0):
+        # Driver convention: (packet, error code), packet is None if the FIFO is empty
+        if self._rx_queue.empty():
+            return None, 0
+        return self._rx_queue.get(), 0
+
     def send(self, packet, destination=0x00, keep_listening=True):
-        if self.use_socket:
+        if self._channel is not None:
+            # The radio is busy for the whole time on air, the broker models the channel
+            self._channel.sendall(encode_frame(FRAME_TX, packet))
+            self.test.last_tx_packet = packet
+            time.sleep(time_on_air(len(packet)))
+            return True
+        elif self.use_socket:
             tx_time = self._tx_time_bias + (random.random() - 0.5) * self._tx_time_dev
             time.sleep(tx_time)
             payload = bytearray(len(packet) + 4)
@@ -4,12 +4,15 @@ from ulab import numpy as np
 
 _scale_ = sun_sensor_prob.scale
 
+_CONVERSION_PERIOD = 0.1  # [s], continuous mode conversion time of the light sensors on the board
+
 
 class LightSensor:
     def __init__(self, id, simulator=None) -> None:
         self.__simulator = simulator
         self.__lux = 0
         self.__id = id
+        self.__counter = 0
 
         # Faults
         self._all_faults = np.array([False] * 3)
@@ -25,6 +28,15 @@ class LightSensor:
             return self.__simulator.sun_lux(self.__id)
         return self.__lux
 
+    def read_latest(self):
+        # Conversion counter of the continuous mode, advancing once per conversion period of simulated time
+        lux = self.lux()
+        if self.__simulator is not None:
+            self.__counter = int(self.__simulator.sim_time / _CONVERSION_PERIOD) & 0x0F
+        else:
+            self.__counter = (self.__counter + 1) & 0x0F
+        return lux, self.__counter, True
+
     ######################## ERROR HANDLING ########################
     def simulate_fault(self):
         time_since_boot = self.__simulator.sim_time
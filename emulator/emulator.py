@@ -42,7 +42,7 @@ class device:
 
 
 class EmulatedSatellite(CubeSat):
-    def __init__(self, debug: bool, simulator, use_socket) -> None:
+    def __init__(self, debug: bool, simulator, use_socket, rf_channel=None, rf_node_name="sat") -> None:
         self.__debug = debug
         self.__use_socket = use_socket
         self.__simulated_spacecraft = simulator
@@ -50,7 +50,7 @@ class EmulatedSatellite(CubeSat):
         super().__init__()
 
         # Radio
-        self.append_device("RADIO", None, Radio(self.__use_socket), ASIL=4)
+        self.append_device("RADIO", None, Radio(self.__use_socket, rf_channel, rf_node_name), ASIL=4)
 
         # SD Card
         self.append_device("SDCARD", None, SD(), ASIL=1)
@@ -118,6 +118,11 @@ class EmulatedSatellite(CubeSat):
                 return
             self.DEVICE_LIST["TORQUE_" + dir].device.set_throttle(dir, ctrl)
 
+    def APPLY_MAGNETIC_CONTROLS(self, dirs, ctrls) -> None:
+        """Applies ctrls[i] to the coil of dirs[i] for all coils in one update."""
+        for i, dir in enumerate(dirs):
+            self.APPLY_MAGNETIC_CONTROL(dir, ctrls[i])
+
     def set_fsw_state(self, state):
         self.__simulated_spacecraft.set_fsw_state(state)
 
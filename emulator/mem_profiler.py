@@ -0,0 +1,117 @@
+"""
+Emulator heap profiler, attributing the memory the flight software holds to source lines.
+
+Enabled with SIM_MEM_PROFILE=1 (imported by cp_mock). It starts tracemalloc, which also makes gc_mock.mem_alloc()
+track real allocations so the per-task heap profile of TemplateTask._run (the mem data process) is meaningful in the
+emulator. A baseline snapshot is taken SIM_MEM_PROFILE_WARMUP wall seconds (default 10) after start, past boot,
+and when the emulator exits mem_profile.txt is written to the build folder with, for the flight software code:
+    - the lines holding the most memory at exit, and their growth since the baseline
+    - the same per task, attributing each allocation to the task module (tasks/<name>.py) on its call stack
+
+Growth since the baseline is what fragments the board heap over a long mission; allocations freed within a task
+cycle are only seen in the per-task peaks of the mem data process.
+"""
+
+import atexit
+import os
+import signal
+import sys
+import threading
+import tracemalloc
+
+_FRAMES = 32
+_TOP_LINES = 25
+
+_lib_folder = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+_baseline = None
+
+
+def _flight_frames(traceback):
+    """
+    (innermost flight software frame, task module name or None) of an allocation traceback.
+    Module imports (code objects, module globals) and the profiler's own allocations are left out. The whole
+    emulator runs inside the import of main_module, so only the frames after the innermost import are looked at.
+    """
+    frames = list(traceback)  # oldest frame first
+    for i in range(len(frames) - 1, -1, -1):
+        if frames[i].filename.startswith("<frozen importlib"):
+            frames = frames[i + 1 :]
+            break
+    line = None
+    task = None
+    for frame in frames:
+        if frame.filename == __file__:
+            return None, None
+        filename = os.path.abspath(frame.filename)
+        if not filename.startswith(_lib_folder):
+            continue
+        line = (os.path.relpath(filename, _lib_folder), frame.lineno)
+        if task is None and os.path.basename(os.path.dirname(filename)) == "tasks":
+            task = os.path.splitext(os.path.basename(filename))[0]
+    if line is not None and line[0] == "main_module.py":
+        # Import statements of main_module itself
+        return None, None
+    return line, task
+
+
+def _line_sizes(snapshot):
+    """{(task, (file, line)): bytes} of the flight software allocations of a snapshot."""
+    sizes = {}
+    for trace in snapshot.traces:
+        line, task = _flight_frames(trace.traceback)
+        if line is None:
+            continue
+        key = (task, line)
+        sizes[key] = sizes.get(key, 0) + trace.size
+    return sizes
+
+
+def _take_baseline():
+    global _baseline
+    _baseline = _line_sizes(tracemalloc.take_snapshot())
+
+
+def _format(rows, title):
+    lines = [title, f"{'size [B]':>10}{'growth [B]':>12}  line"]
+    for (task, (filename, lineno)), size, growth in rows[:_TOP_LINES]:
+        lines.append(f"{size:>10}{growth:>12}  {filename}:{lineno}")
+    return lines
+
+
+def write_report(path="mem_profile.txt"):
+    if not tracemalloc.is_tracing():
+        return
+    sizes = _line_sizes(tracemalloc.take_snapshot())
+    baseline = _baseline or {}
+    rows = [(key, size, size - baseline.get(key, 0)) for key, size in sizes.items()]
+
+    by_line = {}
+    for (task, line), size, growth in rows:
+        total_size, total_growth = by_line.get(line, (0, 0))
+        by_line[line] = (total_size + size, total_growth + growth)
+    line_rows = [((None, line), size, growth) for line, (size, growth) in by_line.items()]
+
+    report = []
+    report += _format(sorted(line_rows, key=lambda row: row[1], reverse=True), "Flight software memory by line")
+    report.append("")
+    report += _format(sorted(line_rows, key=lambda row: row[2], reverse=True), "Growth since baseline by line")
+    for task in sorted({key[0] for key, _, _ in rows if key[0] is not None}):
+        task_rows = sorted((row for row in rows if row[0][0] == task), key=lambda row: row[2], reverse=True)
+        total = sum(row[1] for row in task_rows)
+        growth = sum(row[2] for row in task_rows)
+        report.append("")
+        report += _format(task_rows, f"Task {task}: {total} B, growth {growth} B")
+
+    with open(path, "w") as file:
+        file.write("\n".join(report) + "\n")
+    print(f"Memory profile written to {os.path.abspath(path)}")
+
+
+def start():
+    tracemalloc.start(_FRAMES)
+    timer = threading.Timer(float(os.getenv("SIM_MEM_PROFILE_WARMUP", 10)), _take_baseline)
+    timer.daemon = True
+    timer.start()
+    atexit.register(write_report)
+    # Stopping the emulator with SIGTERM should still write the report
+    signal.signal(signal.SIGTERM, lambda signum, frame: sys.exit(0))
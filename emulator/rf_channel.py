@@ -0,0 +1,80 @@
+"""
+Shared RF channel definitions for the emulator.
+
+Used on both sides of the local RF channel broker (sil/rf_broker.py): by the emulated radio inside each FSW
+instance (as hal.rf_channel) and by the broker itself (as emulator.rf_channel). Standard library only.
+
+Frames on the broker TCP connections: [type (1B)][payload length (2B, big endian)][payload].
+"""
+
+import struct
+
+FRAME_HELLO = 0x01  # node -> broker, payload: b"<kind>:<name>"
+FRAME_TX = 0x02  # node -> broker, payload: packet put on the air
+FRAME_RX = 0x03  # broker -> node, payload: packet received from the air
+
+_FRAME_HEADER = ">BH"
+FRAME_HEADER_SIZE = struct.calcsize(_FRAME_HEADER)
+
+# Modulation of the flight radio (ArgusV4.__radio_boot)
+LORA_SF = 7
+LORA_BW_KHZ = 125
+LORA_CR = 5  # 4/5
+LORA_PREAMBLE = 8
+LORA_CRC = True
+LORA_EXPLICIT_HEADER = True
+
+
+def time_on_air_us(
+    length,
+    sf=LORA_SF,
+    bw_khz=LORA_BW_KHZ,
+    cr=LORA_CR,
+    preamble=LORA_PREAMBLE,
+    crc=LORA_CRC,
+    explicit_header=LORA_EXPLICIT_HEADER,
+):
+    """LoRa time on air in microseconds of a packet of length bytes, same computation as SX126X.getTimeOnAir."""
+    symbol_length_us = int(((1000 * 10) << sf) / (bw_khz * 10))
+    sf_coeff1_x4 = 17
+    sf_coeff2 = 8
+    if sf == 5 or sf == 6:
+        sf_coeff1_x4 = 25
+        sf_coeff2 = 0
+    sf_divisor = 4 * sf
+    if symbol_length_us >= 16000:
+        sf_divisor = 4 * (sf - 2)
+    n_symbol_header = 20 if explicit_header else 0
+
+    bit_count = int(8 * length + int(crc) * 16 - 4 * sf + sf_coeff2 + n_symbol_header)
+    if bit_count < 0:
+        bit_count = 0
+    n_pre_coded_symbols = int((bit_count + (sf_divisor - 1)) / sf_divisor)
+    n_symbol_x4 = int((preamble + 8) * 4 + sf_coeff1_x4 + n_pre_coded_symbols * cr * 4)
+    return int((symbol_length_us * n_symbol_x4) / 4)
+
+
+def time_on_air(length, **modulation):
+    """LoRa time on air in seconds."""
+    return time_on_air_us(length, **modulation) / 1.0e6
+
+
+def encode_frame(frame_type, payload=b""):
+    return struct.pack(_FRAME_HEADER, frame_type, len(payload)) + bytes(payload)
+
+
+def decode_frames(buffer):
+    """
+    Splits complete frames off the front of a receive buffer.
+    Returns ([(type, payload), ...], remaining bytes).
+    """
+    frames = []
+    offset = 0
+    while len(buffer) - offset >= FRAME_HEADER_SIZE:
+        frame_type, length = struct.unpack_from(_FRAME_HEADER, buffer, offset)
+        end = offset + FRAME_HEADER_SIZE + length
+        if end > len(buffer):
+            break
+        frames.append((frame_type, bytes(buffer[offset + FRAME_HEADER_SIZE : end])))
+        offset = end
+    return frames, buffer[offset:]
@@ -21,7 +21,8 @@ from argusim.simulation_manager.sim import Simulator as cppSim
 
 ARGUS_ROOT = os.getenv("ARGUS_ROOT", os.path.join(os.getcwd(), "../"))
 RESULTS_ROOT_FOLDER = os.path.join(ARGUS_ROOT, "sil/results")
-CONFIG_FILE = os.path.join(ARGUS_ROOT, "sil/configs/params.yaml")
+LOCKSTEP = bool(int(os.getenv("SIM_LOCKSTEP", 0)))
+CONFIG_FILE = os.getenv("ARGUS_SIMULATION_CONFIG", os.path.join(ARGUS_ROOT, "sil/configs/params.yaml"))
 
 
 class Simulator:  # will be passed by reference to the emulated HAL
@@ -43,6 +44,10 @@ class Simulator:  # will be passed by reference to the emulated HAL
         self.base_dt = self.cppsim.params.dt
         self.sim_time = 0
 
+        # Lockstep bookkeeping in integer nanoseconds so the number of physics steps is exact
+        self.base_dt_ns = int(round(self.base_dt * 1e9))
+        self.latest_virtual_ns = time.monotonic_ns()
+
         # Measurement labels
         self.gps_idx = slice(0, 6)
         self.gyro_idx = slice(6, 9)
@@ -162,6 +167,15 @@ class Simulator:  # will be passed by reference to the emulated HAL
         """
         Advance in steps of 'dt' to reach the current FSW time
         """
+        if LOCKSTEP:
+            # FSW time is virtual: take every step owed, no catch-up cap
+            iters = (time.monotonic_ns() - self.latest_virtual_ns) // self.base_dt_ns
+            self.latest_virtual_ns += iters * self.base_dt_ns
+            for _ in range(iters):
+                self.measurement = self.cppsim.step(self.sim_time, self.base_dt)
+                self.sim_time += self.base_dt
+            return
+
         time_diff = self.get_time_diff_since_last()
         iters = int(time_diff / self.base_dt)
 
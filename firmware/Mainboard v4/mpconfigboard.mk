@@ -17,3 +17,15 @@ FROZEN_MPY_DIRS += $(TOP)/frozen/Adafruit_CircuitPython_BusDevice
 FROZEN_MPY_DIRS += $(TOP)/frozen/Adafruit_CircuitPython_Register
 FROZEN_MPY_DIRS += $(TOP)/frozen/Adafruit_CircuitPython_SD
 FROZEN_MPY_DIRS += $(TOP)/frozen/Adafruit_CircuitPython_NeoPixel
+
+# Frozen flight core variant, staged by build_tools/build.py --frozen:
+# make BOARD=ArgusV4 ARGUS_FROZEN_FSW=<FSW repo>/build_frozen -j$(nproc)
+ifneq ($(ARGUS_FROZEN_FSW),)
+FROZEN_MPY_DIRS += $(ARGUS_FROZEN_FSW)
+endif
+
+# Native modules of the FSW repo (opt4001_decode, light sensor result decoding):
+# make BOARD=ArgusV4 ARGUS_USER_C_MODULES=<FSW repo>/firmware/usermod -j$(nproc)
+ifneq ($(ARGUS_USER_C_MODULES),)
+USER_C_MODULES = $(ARGUS_USER_C_MODULES)
+endif
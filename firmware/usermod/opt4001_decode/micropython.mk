@@ -0,0 +1,3 @@
+OPT4001_DECODE_MOD_DIR := $(USERMOD_DIR)
+
+SRC_USERMOD_C += $(OPT4001_DECODE_MOD_DIR)/opt4001_decode.c
@@ -0,0 +1,84 @@
+// Native decoding of OPT4001/OPT4003 result registers for the Argus light sensor array
+//
+// SPDX-License-Identifier: MIT
+//
+// Bit-exact port of decode_results in flight/hal/drivers/opt4001.py, which is used when this module is not in the
+// firmware. Each result is the 4 bytes of a RESULT_H, RESULT_L register pair as read over I2C:
+//     15-12 EXPONENT, 11-0 RESULT_MSB | 15-8 RESULT_LSB, 7-4 COUNTER, 3-0 CRC
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#define OPT4001_MAX_RESULTS (30)  // valid flags returned as a small int bitmask
+
+static inline uint32_t parity(uint32_t x) {
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return x & 1;
+}
+
+// CRC bits of a result, page 18 of the datasheet
+static uint32_t result_crc(uint32_t exponent, uint32_t mantissa, uint32_t counter) {
+    uint32_t x0 = parity(exponent ^ mantissa ^ counter);
+    uint32_t x1 = parity((exponent & 0xA) ^ (mantissa & 0xAAAAA) ^ (counter & 0xA));
+    uint32_t x2 = parity((exponent & 0x8) ^ (mantissa & 0x88888) ^ (counter & 0x8));
+    uint32_t x3 = parity(mantissa & 0x80808);
+    return x3 << 3 | x2 << 2 | x1 << 1 | x0;
+}
+
+// decode_results(raw, scales, lux, counters) -> valid bitmask
+//   raw:      n results of 4 bytes
+//   scales:   array('f') of n lux per ADC code
+//   lux:      array('f') of n, written
+//   counters: bytearray of n, written
+// Bit i of the returned mask is set when the CRC of result i matches.
+static mp_obj_t opt4001_decode_results(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t raw, scales, lux, counters;
+    mp_get_buffer_raise(args[0], &raw, MP_BUFFER_READ);
+    mp_get_buffer_raise(args[1], &scales, MP_BUFFER_READ);
+    mp_get_buffer_raise(args[2], &lux, MP_BUFFER_WRITE);
+    mp_get_buffer_raise(args[3], &counters, MP_BUFFER_WRITE);
+
+    size_t n = raw.len / 4;
+    if (n > OPT4001_MAX_RESULTS || scales.typecode != 'f' || lux.typecode != 'f' ||
+        scales.len < n * sizeof(float) || lux.len < n * sizeof(float) || counters.len < n) {
+        mp_raise_ValueError(MP_ERROR_TEXT("result buffers do not match"));
+    }
+
+    const uint8_t *r = raw.buf;
+    const float *scale = scales.buf;
+    float *out_lux = lux.buf;
+    uint8_t *out_counter = counters.buf;
+    mp_uint_t valid = 0;
+
+    for (size_t i = 0; i < n; i++, r += 4) {
+        uint32_t exponent = r[0] >> 4;
+        uint32_t mantissa = (uint32_t)(r[0] & 0x0F) << 16 | (uint32_t)r[1] << 8 | r[2];
+        uint32_t counter = r[3] >> 4;
+
+        // mantissa * 2^exponent is exact in a float, so the lux is rounded once, like the Python fallback
+        out_lux[i] = (float)mantissa * (float)(1UL << exponent) * scale[i];
+        out_counter[i] = counter;
+        if (result_crc(exponent, mantissa, counter) == (r[3] & 0x0FU)) {
+            valid |= 1U << i;
+        }
+    }
+    return MP_OBJ_NEW_SMALL_INT(valid);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(opt4001_decode_results_obj, 4, 4, opt4001_decode_results);
+
+static const mp_rom_map_elem_t opt4001_decode_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_opt4001_decode) },
+    { MP_ROM_QSTR(MP_QSTR_decode_results), MP_ROM_PTR(&opt4001_decode_results_obj) },
+};
+static MP_DEFINE_CONST_DICT(opt4001_decode_module_globals, opt4001_decode_module_globals_table);
+
+const mp_obj_module_t opt4001_decode_user_cmodule = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&opt4001_decode_module_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_opt4001_decode, opt4001_decode_user_cmodule);
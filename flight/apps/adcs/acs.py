@@ -4,7 +4,10 @@ Attitude Control Module for the Attitude Determination and Control Subsystem (AD
 This module is responsible for computing voltage allocations to each of ARGUS' 6 magnetorquer coils.
 """
 
+import time
+
 from apps.adcs.consts import ControllerConst, MCMConst, PhysicalConst
+from apps.adcs.shared_state import ADCSState
 from hal.configuration import SATELLITE
 from ulab import numpy as np
 
@@ -118,15 +121,14 @@ def mcm_coil_allocator(u: np.ndarray, b: np.ndarray) -> np.ndarray:
     u_throttle = u_throttle / max(1.0, np.max(abs(u_throttle)))
     # u_throttle = np.clip(u_throttle, -1, 1)
 
-    # Apply Coil Voltages
-    for n in range(MCMConst.N_MCM):
-        if coil_status[n]:
-            SATELLITE.APPLY_MAGNETIC_CONTROL(MCMConst.MCM_FACES[n], u_throttle[n])
+    # Apply Coil Voltages, all coils in one update
+    SATELLITE.APPLY_MAGNETIC_CONTROLS(MCMConst.MCM_FACES, u_throttle)
+    ADCSState.coils_on = True
 
     return coil_status
 
 
 def zero_all_coils():
-    for face in MCMConst.MCM_FACES:
-        if SATELLITE.TORQUE_DRIVERS_AVAILABLE(face):
-            SATELLITE.APPLY_MAGNETIC_CONTROL(face, 0)
+    SATELLITE.APPLY_MAGNETIC_CONTROLS(MCMConst.MCM_FACES, MCMConst.ZERO_THROTTLES)
+    ADCSState.coils_on = False
+    ADCSState.coils_off_ns = time.monotonic_ns()
@@ -145,6 +145,7 @@ class MCMConst:
     N_MCM = 6
     MCM_FACES = ["XP", "XM", "YP", "YM", "ZP", "ZM"]
     MCM_INDICES = [0, 1, 2, 3, 4, 5]
+    ZERO_THROTTLES = [0, 0, 0, 0, 0, 0]
 
     ALLOC_MAT = np.array(
         [
@@ -0,0 +1,49 @@
+"""
+Reference directions in ECI for attitude determination.
+
+- Sun: apps.orbit.propagator.sun_direction_eci
+- Geomagnetic field: tilted dipole with the degree 1 IGRF-13 coefficients (epoch 2020). The direction error
+  against the full model is a few degrees in LEO, covered by the magnetometer noise of the estimator.
+
+"""
+
+from apps.orbit.propagator import OrbitPropagator, gmst, sun_direction_eci
+from ulab import numpy as np
+
+_R_EARTH = 6371200.0  # m, IGRF reference radius
+_G10 = -29404.8e-9  # T
+_G11 = -1450.9e-9
+_H11 = 4652.5e-9
+
+
+def magnetic_field_eci(unix_time, r_eci):
+    """Geomagnetic field [T] in ECI at ECI position r_eci [m]."""
+    # Dipole axis in ECEF, rotated into ECI
+    theta = gmst(unix_time)
+    c, s = np.cos(theta), np.sin(theta)
+    m = np.array([c * _G11 - s * _H11, s * _G11 + c * _H11, _G10])
+
+    r = np.linalg.norm(r_eci)
+    r_hat = r_eci / r
+    return (_R_EARTH / r) ** 3 * (3.0 * np.dot(m, r_hat) * r_hat - m)
+
+
+def reference_vectors(unix_time):
+    """
+    Unit sun and magnetic field directions in ECI at unix_time.
+    The field is None if the orbit is unknown (no recent GPS fix for the propagator).
+    """
+    sun = sun_direction_eci(unix_time)
+    if not OrbitPropagator.is_valid(unix_time):
+        return sun, None
+    r_eci, _ = OrbitPropagator.state_eci(unix_time)
+    field = magnetic_field_eci(unix_time, r_eci)
+    return sun, field / np.linalg.norm(field)
+
+
+def field_strength(unix_time):
+    """Geomagnetic field strength [T] at the spacecraft at unix_time, None if the orbit is unknown."""
+    if not OrbitPropagator.is_valid(unix_time):
+        return None
+    r_eci, _ = OrbitPropagator.state_eci(unix_time)
+    return np.linalg.norm(magnetic_field_eci(unix_time, r_eci))
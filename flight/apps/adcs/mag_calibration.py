@@ -0,0 +1,205 @@
+"""
+Onboard magnetometer calibration (hard and soft iron) for the ADCS.
+
+Model: b = A (m - h), m the raw reading [T], h the hard-iron offset [T] and A the symmetric soft-iron matrix.
+The strength of the corrected field must match the geomagnetic field model at the sample time, which does not depend
+on the attitude and is linear in the parameters theta = [M11, M22, M33, M12, M13, M23, v, c]:
+    m^T M m - 2 m^T v + c = |B_model|^2,  with M = A^T A, v = M h, c = h^T M h
+
+The magnetometer loop adds its coil-off samples to a bounded window covering about two orbits. The least squares
+normal equations are updated incrementally: each new sample adds its contribution and the sample it evicts from the
+window has its contribution removed. Every _FIT_INTERVAL samples the normal equations are solved, and the fit is
+accepted if all parameters are well observed (enough attitude diversity over the window) and it fits the window better
+than the current calibration. Accepted calibrations are persisted in the "mag_cal" DataProcess and restored on boot.
+
+Fields are scaled by _B0 so that the normal equations stay well conditioned in single precision.
+Reference: Alonso & Shuster, Complete Linear Attitude-Independent Magnetometer Calibration (2002).
+
+"""
+
+from micropython import const
+from ulab import numpy as np
+
+_B0 = 50.0e-6  # T, field scale of the normal equations
+_N = const(10)  # parameters
+
+_WINDOW = const(256)  # samples
+_SAMPLE_PERIOD = const(40)  # s between samples, the window covers ~1.8 orbits
+_MIN_SAMPLES = const(96)
+_FIT_INTERVAL = const(32)  # samples between fits
+
+# Acceptance of a fit
+_MAX_PARAM_SIGMA = 0.02  # 1-sigma of each scaled parameter, ~1 uT on the offset
+_MAX_OFFSET = 100.0e-6  # T
+_MAX_SOFT_IRON = 0.3  # largest deviation of a soft-iron element from identity
+_SQRTM_ITERATIONS = const(12)
+
+
+class MagCalibration:
+    """
+    Calibration state shared by the read path (apps.adcs.sensors.read_magnetometer) and the magnetometer loop,
+    which feeds the samples and persists the accepted fits.
+    """
+
+    offset = np.zeros((3,))  # h [T]
+    soft_iron = np.eye(3)  # A
+    samples = 0  # window samples of the applied calibration, 0 if uncalibrated
+    residual = 0.0  # rms field strength error of the applied calibration over its window [T]
+    last_raw = np.zeros((3,))  # raw reading of the last apply call
+
+    _centered = np.zeros((3,))
+    _window = np.zeros((_WINDOW, 4))  # scaled raw field and model field strength squared
+    _count = 0  # samples in the window
+    _next = 0  # window slot of the next sample
+    _since_fit = 0
+    _last_sample_time = None
+
+    # Normal equations: Phi^T Phi, Phi^T y and y^T y over the window
+    _info = np.zeros((_N, _N))
+    _rhs = np.zeros((_N,))
+    _yy = 0.0
+    _phi = np.zeros((_N, 1))
+
+    @classmethod
+    def apply(cls, mag):
+        """Corrects the raw reading mag [T] in place and keeps a copy of it in last_raw. Returns mag."""
+        a, h, c = cls.soft_iron, cls.offset, cls._centered
+        for i in range(3):
+            cls.last_raw[i] = mag[i]
+            c[i] = mag[i] - h[i]
+        for i in range(3):
+            mag[i] = a[i, 0] * c[0] + a[i, 1] * c[1] + a[i, 2] * c[2]
+        return mag
+
+    @classmethod
+    def load(cls, offset, soft_iron, samples, residual):
+        """Applies a calibration, soft_iron being [XX, XY, XZ, YY, YZ, ZZ]."""
+        xx, xy, xz, yy, yz, zz = soft_iron
+        cls.soft_iron[:] = np.array([[xx, xy, xz], [xy, yy, yz], [xz, yz, zz]])
+        cls.offset[:] = offset
+        cls.samples = samples
+        cls.residual = residual
+
+    @classmethod
+    def reset(cls):
+        """Back to the identity calibration, with an empty window."""
+        cls.load((0.0, 0.0, 0.0), (1.0, 0.0, 0.0, 1.0, 0.0, 1.0), 0, 0.0)
+        cls._count = 0
+        cls._next = 0
+        cls._since_fit = 0
+        cls._last_sample_time = None
+        cls._rebuild()
+
+    @classmethod
+    def add_sample(cls, raw, field_strength, unix_time):
+        """
+        Adds a raw reading [T] and the model field strength [T] at its time to the window, at most one sample every
+        _SAMPLE_PERIOD seconds. Returns True if a new calibration was fitted and applied.
+        """
+        if cls._last_sample_time is not None and 0 <= unix_time - cls._last_sample_time < _SAMPLE_PERIOD:
+            return False
+        cls._last_sample_time = unix_time
+
+        slot = cls._next
+        if cls._count == _WINDOW:
+            cls._accumulate(slot, -1.0)
+        else:
+            cls._count += 1
+        w = cls._window
+        for i in range(3):
+            w[slot, i] = raw[i] / _B0
+        w[slot, 3] = (field_strength / _B0) ** 2
+        cls._accumulate(slot, 1.0)
+
+        cls._next = (slot + 1) % _WINDOW
+        if cls._next == 0:
+            # Clears the rounding errors left by the evictions once per window
+            cls._rebuild()
+
+        cls._since_fit += 1
+        if cls._since_fit < _FIT_INTERVAL or cls._count < _MIN_SAMPLES:
+            return False
+        cls._since_fit = 0
+        return cls.fit()
+
+    @classmethod
+    def fit(cls):
+        """Solves the normal equations over the window, applies the fit if accepted and returns True if so."""
+        try:
+            cov = np.linalg.inv(cls._info)
+        except ValueError:
+            return False
+        theta = np.dot(cov, cls._rhs)
+        residual = cls._residual(theta)
+
+        # Parameter uncertainty from the residual variance, large if the attitudes do not cover enough directions
+        var = max(residual, 0.0) / (cls._count - _N)
+        for i in range(_N):
+            if cov[i, i] * var > _MAX_PARAM_SIGMA * _MAX_PARAM_SIGMA:
+                return False
+
+        m = np.array([[theta[0], theta[3], theta[4]], [theta[3], theta[1], theta[5]], [theta[4], theta[5], theta[2]]])
+        a = _sqrtm(m)
+        if a is None:
+            return False
+        h = np.dot(np.linalg.inv(m), theta[6:9])
+        if np.linalg.norm(h) * _B0 > _MAX_OFFSET or np.max(abs(a - np.eye(3))) > _MAX_SOFT_IRON:
+            return False
+
+        # Only replaces the current calibration if it fits the window better
+        if residual >= cls._residual(_theta(cls.soft_iron, cls.offset / _B0)):
+            return False
+
+        cls.soft_iron[:] = a
+        cls.offset[:] = h * _B0
+        cls.samples = cls._count
+        # |B|^2 error to |B| error, about 2 |B| times smaller
+        cls.residual = (max(residual, 0.0) / cls._count) ** 0.5 * _B0 / 2.0
+        return True
+
+    @classmethod
+    def _accumulate(cls, slot, sign):
+        w, phi = cls._window, cls._phi
+        x, y, z, b2 = w[slot, 0], w[slot, 1], w[slot, 2], w[slot, 3]
+        phi[0, 0], phi[1, 0], phi[2, 0] = x * x, y * y, z * z
+        phi[3, 0], phi[4, 0], phi[5, 0] = 2.0 * x * y, 2.0 * x * z, 2.0 * y * z
+        phi[6, 0], phi[7, 0], phi[8, 0] = -2.0 * x, -2.0 * y, -2.0 * z
+        phi[9, 0] = 1.0
+        cls._info += sign * np.dot(phi, phi.transpose())
+        for i in range(_N):
+            cls._rhs[i] += sign * phi[i, 0] * b2
+        cls._yy += sign * b2 * b2
+
+    @classmethod
+    def _rebuild(cls):
+        for i in range(_N):
+            cls._rhs[i] = 0.0
+            for j in range(_N):
+                cls._info[i, j] = 0.0
+        cls._yy = 0.0
+        for slot in range(cls._count):
+            cls._accumulate(slot, 1.0)
+
+    @classmethod
+    def _residual(cls, theta):
+        """Sum of squared residuals over the window of the parameters theta."""
+        return cls._yy - 2.0 * np.dot(theta, cls._rhs) + np.dot(theta, np.dot(cls._info, theta))
+
+
+def _theta(a, h):
+    """Parameters of the soft-iron matrix a and the scaled offset h."""
+    m = np.dot(a, a)
+    v = np.dot(m, h)
+    return np.array([m[0, 0], m[1, 1], m[2, 2], m[0, 1], m[0, 2], m[1, 2], v[0], v[1], v[2], np.dot(h, v)])
+
+
+def _sqrtm(m):
+    """Symmetric square root of m (Newton iteration from identity), None if m is not positive definite."""
+    try:
+        np.linalg.cholesky(m)
+    except ValueError:
+        return None
+    y = np.eye(3)
+    for _ in range(_SQRTM_ITERATIONS):
+        y = 0.5 * (y + np.dot(np.linalg.inv(y), m))
+    return y
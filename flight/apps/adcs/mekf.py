@@ -0,0 +1,193 @@
+"""
+Multiplicative Extended Kalman Filter (MEKF) attitude estimator for the ADCS.
+
+State: attitude quaternion q = [w, x, y, z] (Hamilton, rotates body vectors into ECI) and gyro bias [rad/s].
+The filter runs on the 6 element error state [dtheta, dbias], dtheta being a small rotation in the body frame
+(q_true = q * [1, dtheta / 2]), with covariance P:
+    - propagate: integrates the bias-corrected gyro rate into q, first order propagation of P
+    - update_vector: one unit vector measured in the body frame (sun or magnetic field direction) against its ECI
+      reference. Vectors are processed one at a time (sequential update), each needing a single 3x3 inversion.
+
+The work matrices (transition, process noise, measurement Jacobian) and the rotation matrix are allocated once per
+estimator. ulab's dot has no output argument, so the covariance products still allocate their results on every
+propagate / update. Reference: Markley & Crassidis, Fundamentals of
+Spacecraft Attitude Determination and Control, ch. 7.
+
+"""
+
+import math
+
+from ulab import numpy as np
+
+# Gyro noise densities: angle random walk [rad/s^0.5] (BMX160, 0.007 deg/s/sqrt(Hz)) and bias random walk [rad/s^1.5]
+_SIGMA_ARW = 1.2e-4
+_SIGMA_RRW = 2.0e-5
+
+# Initial 1-sigma errors
+_SIGMA_ATTITUDE_0 = 0.2  # rad, TRIAD from noisy vectors
+_SIGMA_BIAS_0 = 0.01  # rad/s, BMX160 zero-rate offset
+
+_MAX_DT = 1.0  # s, longer gaps reset the estimator instead of being integrated
+
+
+class MEKF:
+    def __init__(self):
+        self.q = np.array([1.0, 0.0, 0.0, 0.0])
+        self.bias = np.zeros((3,))
+        self.P = np.zeros((6, 6))
+        self.initialized = False
+
+        # Work matrices
+        self._phi = np.eye(6)
+        self._q = np.zeros((6, 6))
+        self._h = np.zeros((3, 6))
+        self._noise = np.eye(3)
+        self._eye6 = np.eye(6)
+        self._r = np.eye(3)
+
+    def reset(self):
+        """Drops the attitude estimate: q back to identity, the bias estimate is kept."""
+        self.initialized = False
+        self._set_q((1.0, 0.0, 0.0, 0.0))
+
+    def initialize(self, b1, r1, b2, r2):
+        """
+        TRIAD attitude from two unit vectors measured in the body frame (b1, b2) and their ECI references (r1, r2).
+        b1 / r1 is the more accurate pair. The bias estimate is kept.
+        """
+        tb = _triad_frame(b1, b2)
+        tr = _triad_frame(r1, r2)
+        if tb is None or tr is None:
+            return False
+
+        # Rotation body -> ECI
+        self._set_q(_quat_from_matrix(np.dot(tr, tb.transpose())))
+        for i in range(6):
+            for j in range(6):
+                self.P[i, j] = 0.0
+        for i in range(3):
+            self.P[i, i] = _SIGMA_ATTITUDE_0 * _SIGMA_ATTITUDE_0
+            self.P[i + 3, i + 3] = _SIGMA_BIAS_0 * _SIGMA_BIAS_0
+        self.initialized = True
+        return True
+
+    def propagate(self, gyro, dt):
+        """Propagates the state over dt [s] with the measured body rate gyro [rad/s]."""
+        if not self.initialized:
+            return
+        if dt <= 0 or dt > _MAX_DT:
+            self.reset()
+            return
+
+        wx = gyro[0] - self.bias[0]
+        wy = gyro[1] - self.bias[1]
+        wz = gyro[2] - self.bias[2]
+
+        # q = q * exp(w dt / 2)
+        w = math.sqrt(wx * wx + wy * wy + wz * wz)
+        half = 0.5 * w * dt
+        k = math.sin(half) / w if w > 1e-9 else 0.5 * dt
+        self._set_q(_quat_mul(self.q, (math.cos(half), wx * k, wy * k, wz * k)))
+
+        # Error state transition: dtheta' = -[w x] dtheta - dbias
+        phi = self._phi
+        phi[0, 1], phi[0, 2] = wz * dt, -wy * dt
+        phi[1, 0], phi[1, 2] = -wz * dt, wx * dt
+        phi[2, 0], phi[2, 1] = wy * dt, -wx * dt
+        for i in range(3):
+            phi[i, i + 3] = -dt
+
+        # Discrete process noise
+        v2, u2 = _SIGMA_ARW * _SIGMA_ARW, _SIGMA_RRW * _SIGMA_RRW
+        qd = self._q
+        for i in range(3):
+            qd[i, i] = v2 * dt + u2 * dt * dt * dt / 3.0
+            qd[i, i + 3] = qd[i + 3, i] = -0.5 * u2 * dt * dt
+            qd[i + 3, i + 3] = u2 * dt
+
+        self.P = np.dot(np.dot(phi, self.P), phi.transpose()) + qd
+
+    def update_vector(self, b_meas, r_eci, sigma):
+        """
+        Measurement update with the unit vector b_meas measured in the body frame, r_eci its unit reference in ECI
+        and sigma its 1-sigma direction error [rad].
+        """
+        if not self.initialized:
+            return
+
+        # Predicted measurement: reference rotated into the body frame
+        b = np.dot(self.rotation().transpose(), r_eci)
+
+        # H = [[b x], 0]
+        h = self._h
+        h[0, 1], h[0, 2] = -b[2], b[1]
+        h[1, 0], h[1, 2] = b[2], -b[0]
+        h[2, 0], h[2, 1] = -b[1], b[0]
+
+        pht = np.dot(self.P, h.transpose())
+        s = np.dot(h, pht) + (sigma * sigma) * self._noise
+        k = np.dot(pht, np.linalg.inv(s))
+        dx = np.dot(k, b_meas - b)
+
+        # Joseph form keeps P symmetric positive definite in single precision
+        ikh = self._eye6 - np.dot(k, h)
+        self.P = np.dot(np.dot(ikh, self.P), ikh.transpose()) + (sigma * sigma) * np.dot(k, k.transpose())
+
+        # Reset: fold the attitude error into q
+        self._set_q(_quat_mul(self.q, (1.0, 0.5 * dx[0], 0.5 * dx[1], 0.5 * dx[2])))
+        for i in range(3):
+            self.bias[i] += dx[i + 3]
+
+    def rotation(self):
+        """Rotation matrix from the body frame to ECI, valid until the next call."""
+        w, x, y, z = self.q[0], self.q[1], self.q[2], self.q[3]
+        r = self._r
+        r[0, 0], r[0, 1], r[0, 2] = 1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y)
+        r[1, 0], r[1, 1], r[1, 2] = 2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x)
+        r[2, 0], r[2, 1], r[2, 2] = 2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)
+        return r
+
+    def _set_q(self, q):
+        n = math.sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3])
+        # Keep the scalar part positive, q and -q are the same attitude
+        if q[0] < 0:
+            n = -n
+        for i in range(4):
+            self.q[i] = q[i] / n
+
+
+def _quat_mul(p, q):
+    return (
+        p[0] * q[0] - p[1] * q[1] - p[2] * q[2] - p[3] * q[3],
+        p[0] * q[1] + p[1] * q[0] + p[2] * q[3] - p[3] * q[2],
+        p[0] * q[2] - p[1] * q[3] + p[2] * q[0] + p[3] * q[1],
+        p[0] * q[3] + p[1] * q[2] - p[2] * q[1] + p[3] * q[0],
+    )
+
+
+def _quat_from_matrix(m):
+    """Quaternion of a rotation matrix (Shepperd's method, pivoting on the largest component)."""
+    trace = m[0, 0] + m[1, 1] + m[2, 2]
+    if trace >= m[0, 0] and trace >= m[1, 1] and trace >= m[2, 2]:
+        s = 2.0 * math.sqrt(1.0 + trace)
+        return (0.25 * s, (m[2, 1] - m[1, 2]) / s, (m[0, 2] - m[2, 0]) / s, (m[1, 0] - m[0, 1]) / s)
+    if m[0, 0] >= m[1, 1] and m[0, 0] >= m[2, 2]:
+        s = 2.0 * math.sqrt(1.0 + m[0, 0] - m[1, 1] - m[2, 2])
+        return ((m[2, 1] - m[1, 2]) / s, 0.25 * s, (m[0, 1] + m[1, 0]) / s, (m[0, 2] + m[2, 0]) / s)
+    if m[1, 1] >= m[2, 2]:
+        s = 2.0 * math.sqrt(1.0 + m[1, 1] - m[0, 0] - m[2, 2])
+        return ((m[0, 2] - m[2, 0]) / s, (m[0, 1] + m[1, 0]) / s, 0.25 * s, (m[1, 2] + m[2, 1]) / s)
+    s = 2.0 * math.sqrt(1.0 + m[2, 2] - m[0, 0] - m[1, 1])
+    return ((m[1, 0] - m[0, 1]) / s, (m[0, 2] + m[2, 0]) / s, (m[1, 2] + m[2, 1]) / s, 0.25 * s)
+
+
+def _triad_frame(v1, v2):
+    """Orthonormal frame [t1 t2 t3] (columns) of two vectors, None if they are parallel."""
+    t1 = v1 / np.linalg.norm(v1)
+    t2 = np.cross(v1, v2)
+    n = np.linalg.norm(t2)
+    if n < 1e-3:
+        return None
+    t2 = t2 / n
+    t3 = np.cross(t1, t2)
+    return np.array([t1, t2, t3]).transpose()
@@ -1,16 +1,24 @@
 from apps.adcs.consts import ControllerConst, Modes, PhysicalConst, StatusConst
+from apps.adcs.mag_calibration import MagCalibration
 from apps.adcs.sun import compute_body_sun_vector_from_lux, read_light_sensors
 from hal.configuration import SATELLITE
 from ulab import numpy as np
 
+_IMU_FIFO_WINDOW = 8  # Max FIFO frames averaged per read (IMU ODR is 25 Hz, the gyro loop runs at 10 Hz)
 
-def read_gyro() -> tuple[int, np.ndarray]:
+
+def read_gyro(averaged: bool = True) -> tuple[int, np.ndarray]:
     """
     - Reads the angular velocity from the gyro
+    - If averaged, drains the IMU FIFO and returns the mean rate over every sample taken since the last drain.
+      Falls back to the data register when the FIFO holds no new frame.
     """
 
     if SATELLITE.IMU_AVAILABLE:
-        gyro = np.array(SATELLITE.IMU.gyro())  # Gyro measurements are in rad/s
+        if averaged and SATELLITE.IMU.drain_fifo(_IMU_FIFO_WINDOW) > 0:
+            gyro = np.array(SATELLITE.IMU.fifo_gyro())  # Gyro measurements are in rad/s
+        else:
+            gyro = np.array(SATELLITE.IMU.gyro())  # Gyro measurements are in rad/s
 
         # Sensor validity check
         if not is_valid_gyro_reading(gyro):
@@ -21,14 +29,23 @@ def read_gyro() -> tuple[int, np.ndarray]:
         return StatusConst.GYRO_FAIL, np.zeros((3,))
 
 
-def read_magnetometer() -> tuple[int, np.ndarray]:
+def read_magnetometer(averaged: bool = True) -> tuple[int, np.ndarray]:
     """
     - Reads the magnetic field reading from the IMU
     - This is separate from the gyro measurement to allow gyro to be read faster than magnetometer
+    - If averaged, returns the mean field over the FIFO window drained by the preceding read_gyro call
+      instead of the latest single sample. The magnetometer loop samples in a coil-off window and reads the
+      latest sample, the FIFO window would include fields measured while the coils were on.
+    - The hard and soft-iron calibration (apps/adcs/mag_calibration.py) is applied in place, the raw reading is kept
+      in MagCalibration.last_raw
     """
 
     if SATELLITE.IMU_AVAILABLE:
-        mag = 1e-6 * np.array(SATELLITE.IMU.mag())  # Convert field from uT to T
+        if averaged and SATELLITE.IMU.fifo_frames > 0:
+            mag = 1e-6 * np.array(SATELLITE.IMU.fifo_mag())  # Convert field from uT to T
+        else:
+            mag = 1e-6 * np.array(SATELLITE.IMU.mag())  # Convert field from uT to T
+        MagCalibration.apply(mag)
 
         # Sensor validity check
         if not is_valid_mag_reading(mag):
@@ -86,12 +103,10 @@ def is_valid_gyro_reading(gyro: np.ndarray) -> bool:
 """
 
 
-def current_mode(current_mode) -> int:
+def current_mode(current_mode, gyro_status, omega, sun_status, sun_pos_body) -> int:
     """
-    - Returns the current mode of the ADCS
+    - Returns the current mode of the ADCS from the latest gyro and sun readings (ADCSState)
     """
-    gyro_status, omega = read_gyro()
-    sun_status, sun_pos_body, _ = read_sun_position()
 
     # Fail-safe STABLE mode if IMU or sun acquisition fails
     # if gyro_status != StatusConst.OK or sun_status != StatusConst.OK:
@@ -0,0 +1,70 @@
+"""
+State shared by the ADCS loops.
+
+The ADCS runs as three scheduled tasks at their own rates (see TASK_CONFIG):
+    - tasks/adcs_gyro.py: gyro and sun sensing, attitude estimation
+    - tasks/adcs_mag.py: magnetometer sampling, synchronised to a coil-off window
+    - tasks/adcs.py: mode determination, attitude control (coil actuation) and logging
+
+Each field has a single writer loop. Vectors are preallocated and updated in place, so the readers keep valid
+references and the loops do not allocate new buffers to exchange data.
+"""
+
+from apps.adcs.consts import Modes, StatusConst
+from ulab import numpy as np
+
+
+class ADCSState:
+    MODE = Modes.TUMBLING
+
+    # Gyro loop
+    gyro_status = StatusConst.OK
+    gyro_data = np.zeros((3,))  # rad/s
+    gyro_time = 0
+
+    sun_status = StatusConst.OK
+    sun_pos_body = np.zeros((3,))
+    sun_lux = np.zeros((9,))
+
+    # Attitude estimate (apps/adcs/mekf.py), q = [w, x, y, z] rotates body vectors into ECI
+    attitude_valid = False
+    attitude_q = np.array([1.0, 0.0, 0.0, 0.0])
+    gyro_bias = np.zeros((3,))  # rad/s
+
+    # Magnetometer loop
+    mag_status = StatusConst.OK
+    mag_data = np.zeros((3,))  # T
+    mag_time = 0
+    mag_count = 0  # samples taken, the gyro loop updates the attitude estimate on each new one
+
+    # Coils: coils_on and coils_off_ns (monotonic time they were last zeroed) are kept by apps.adcs.acs,
+    # coil_hold_off is set by the magnetometer loop while it samples
+    coils_on = False
+    coils_off_ns = 0
+    coil_hold_off = False
+    coil_status = [0] * 6
+
+    @classmethod
+    def set_gyro(cls, status, gyro, time):
+        cls.gyro_status = status
+        cls.gyro_data[:] = gyro
+        cls.gyro_time = time
+
+    @classmethod
+    def set_sun(cls, status, sun_pos_body, sun_lux):
+        cls.sun_status = status
+        cls.sun_pos_body[:] = sun_pos_body
+        cls.sun_lux[:] = sun_lux
+
+    @classmethod
+    def set_mag(cls, status, mag, time):
+        cls.mag_status = status
+        cls.mag_data[:] = mag
+        cls.mag_time = time
+        cls.mag_count += 1
+
+    @classmethod
+    def set_attitude(cls, valid, q, bias):
+        cls.attitude_valid = valid
+        cls.attitude_q[:] = q
+        cls.gyro_bias[:] = bias
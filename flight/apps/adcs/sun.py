@@ -14,6 +14,8 @@ both for the mode transitions, sun pointing controller accuracy, and attitude de
 
 """
 
+from array import array
+
 from apps.adcs.consts import PhysicalConst, StatusConst
 from core import logger
 from hal.configuration import SATELLITE
@@ -24,32 +26,55 @@ _MAX_RANGE = const(140000)  # OPT4001
 _THRESHOLD_ILLUMINATION_LUX = const(3000)
 _NUM_LIGHT_SENSORS = const(9)
 _ERROR_LUX = const(-1)
+_MAX_STALE_READS = const(3)  # Consecutive reads without a new conversion before a sensor is considered stuck
+
+_FACES = ("XP", "XM", "YP", "YM", "ZP_XP", "ZP_YM", "ZP_XM", "ZP_YP", "ZM")
+
+# Conversion counter of the last reading of each face, and the number of consecutive reads it did not advance
+_last_counter = [-1] * _NUM_LIGHT_SENSORS
+stale_reads = [0] * _NUM_LIGHT_SENSORS
+
+# Decoded readings of the last SATELLITE.READ_LIGHT_SENSORS call
+_lux = array("f", [0.0] * _NUM_LIGHT_SENSORS)
+_counters = bytearray(_NUM_LIGHT_SENSORS)
 
 
-def _read_light_sensor(face):
-    if SATELLITE.LIGHT_SENSOR_AVAILABLE(face):
-        return SATELLITE.LIGHT_SENSORS[face].lux()
+def _fresh_lux(idx):
+    counter = _counters[idx]
+    if counter == _last_counter[idx]:
+        # No conversion completed since the last read: the result is the previous one
+        stale_reads[idx] += 1
+        if stale_reads[idx] >= _MAX_STALE_READS:
+            return _ERROR_LUX
     else:
-        return _ERROR_LUX
+        _last_counter[idx] = counter
+        stale_reads[idx] = 0
+    return _lux[idx]
 
 
 def read_light_sensors():
     """
     Read the light sensors on the x+,x-,y+,y-, and z- faces of the satellite.
 
+    The sensors convert continuously (see LIGHT_SENSOR_CONVERSION_TIME in the board HAL), so each one is read once,
+    without waiting for a conversion, from its latest result registers, and the array is decoded in one call
+    (natively when the firmware has the opt4001_decode module). Readings failing their CRC are dropped.
+    A reading whose conversion counter did not advance since the previous call is tagged stale in stale_reads and
+    still used, until the sensor has been stale for _MAX_STALE_READS calls in a row.
+
     Returns:
         lux_readings: list of lux readings on each face. A "ERROR_LUX" reading comes from a dysfunctional sensor.
     """
 
-    faces = ["XP", "XM", "YP", "YM", "ZP_XP", "ZP_YM", "ZP_XM", "ZP_YP", "ZM"]
-    lux_readings = []
+    try:
+        valid = SATELLITE.READ_LIGHT_SENSORS(_FACES, _lux, _counters)
+    except Exception as e:
+        logger.warning(f"Error reading light sensors: {e}")
+        valid = 0
 
-    for face in faces:
-        try:
-            lux_readings.append(_read_light_sensor(face))
-        except Exception as e:
-            logger.warning(f"Error reading {face}: {e}")
-            lux_readings.append(_ERROR_LUX)
+    lux_readings = []
+    for idx in range(_NUM_LIGHT_SENSORS):
+        lux_readings.append(_fresh_lux(idx) if valid & (1 << idx) else _ERROR_LUX)
 
     return lux_readings
 
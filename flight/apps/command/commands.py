@@ -188,7 +188,7 @@ def TURN_OFF_PAYLOAD():
     try:
         logger.info("[PAYLOAD] Shutdown command sent successfully, waiting for payload to shutdown before cutting power")
         SATELLITE.JETSON_ENABLE.value = False
-        TPM.sleep(0.1)
+        TPM.settle(0.1)
         SATELLITE.JETSON_SD_REQ.value = False  # turn of 5v dcdc to save more power
 
     except Exception as e:
@@ -208,7 +208,7 @@ def TURN_ON_PAYLOAD():
 
     try:
         SATELLITE.JETSON_SD_REQ.value = True
-        TPM.sleep(0.1)
+        TPM.settle(0.1)
         SATELLITE.JETSON_ENABLE.value = True  # turn of 5v dcdc to save more power
 
         logger.info("[PAYLOAD] Jetson power enabled successfully.")
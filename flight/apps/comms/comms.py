@@ -24,6 +24,7 @@ _ERR_CRC_MISMATCH = const(-7)
 class SATELLITE_RADIO:
 
     HB_PERIOD = CONFIG.HB_PERIOD
+    HB_PERIOD_OUT_OF_PASS = getattr(CONFIG, "HB_PERIOD_OUT_OF_PASS", CONFIG.HB_PERIOD)
     SC_CALLSIGN = CONFIG.SC_CALLSIGN
     GS_CALLSIGN = CONFIG.GS_CALLSIGN
 
@@ -51,6 +52,9 @@ class SATELLITE_RADIO:
 
     digipeater_header = b"\x3c\xff\x01"   # have it here as well to facilitate checking
 
+    # RX power profile: continuous RX in-pass, radio asleep out of a predicted pass
+    rx_asleep = False
+
     @classmethod
     def set_rx_mode(cls):
         """
@@ -58,11 +62,32 @@ class SATELLITE_RADIO:
         Description: Used during task init to make sure that the radio is able to receive messages
         as soon as the comms task starts
         """
+        if cls.rx_asleep:
+            # Warm sleep keeps the configuration, the next SPI command (startReceive or a transmission) wakes the radio
+            SATELLITE.RADIO.rx_en.value = False
+            SATELLITE.RADIO.tx_en.value = False
+            SATELLITE.RADIO.sleep()
+            return
+
         # set the radio into receive mode
         SATELLITE.RADIO.startReceive(0xFFFFFF)
         SATELLITE.RADIO.rx_en.value = True
         SATELLITE.RADIO.tx_en.value = False
 
+    @classmethod
+    def set_rx_profile(cls, asleep):
+        """
+        Name: set_rx_profile
+        Description: Switch between continuous receive and radio sleep, only touching the radio on a change
+        """
+        if asleep == cls.rx_asleep:
+            return
+
+        cls.rx_asleep = asleep
+        logger.info(f"[COMMS] RX profile set to {'SLEEP' if asleep else 'CONTINUOUS'}")
+        if SATELLITE.RADIO_AVAILABLE:
+            cls.set_rx_mode()
+
     @classmethod
     def get_rssi(cls):
         """
@@ -223,6 +248,9 @@ class SATELLITE_RADIO:
         if SATELLITE.RADIO_AVAILABLE:
             SATELLITE.RADIO.send(packet)
             cls.tx_packet_count += 1
+            if cls.rx_asleep:
+                # The driver returns to continuous RX after a transmission
+                cls.set_rx_mode()
             logger.info(f"[COMMS] - Message has been transmitted: {format_bytes(packet[:20])}...")
             return True
         else:
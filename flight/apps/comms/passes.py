@@ -0,0 +1,133 @@
+"""
+Ground station pass predictor.
+
+Predicts visibility windows (AOS/LOS) over the configured ground stations from the onboard orbit
+propagator, so the COMMS task can keep the radio fully on in-pass and duty-cycle it out of pass.
+
+The search is incremental: each update() evaluates at most _SAMPLES_PER_UPDATE samples past the last
+evaluated time, so the cost per COMMS cycle stays bounded while the look-ahead horizon fills up.
+The predictor integrates its own copy of the state so it does not move the shared propagator cache.
+"""
+
+from apps.orbit.propagator import OrbitPropagator, eci_to_ecef, propagate
+from core import logger
+from core.satellite_config import comms_config as CONFIG
+from micropython import const
+from ulab import numpy as np
+
+_WGS84_A = 6378137.0  # m
+_WGS84_E2 = 6.69437999014e-3
+
+_SAMPLE_PERIOD = const(30)  # s
+_SAMPLES_PER_UPDATE = const(8)
+_HORIZON = const(7200)  # s, look-ahead
+_MARGIN = const(60)  # s, added on both ends of a window to absorb sampling and propagation errors
+
+
+def station_ecef(lat_deg, lon_deg, alt_m):
+    """Geodetic (WGS84) station coordinates to ECEF position [m] and local up unit vector."""
+    lat, lon = np.radians(lat_deg), np.radians(lon_deg)
+    sin_lat, cos_lat = np.sin(lat), np.cos(lat)
+    n = _WGS84_A / (1.0 - _WGS84_E2 * sin_lat * sin_lat) ** 0.5
+    position = np.array(
+        [
+            (n + alt_m) * cos_lat * np.cos(lon),
+            (n + alt_m) * cos_lat * np.sin(lon),
+            (n * (1.0 - _WGS84_E2) + alt_m) * sin_lat,
+        ]
+    )
+    up = np.array([cos_lat * np.cos(lon), cos_lat * np.sin(lon), sin_lat])
+    return position, up
+
+
+def sin_elevation(r_ecef, station, up):
+    """Sine of the elevation of a satellite at r_ecef seen from a station."""
+    line_of_sight = r_ecef - station
+    return np.dot(line_of_sight, up) / np.linalg.norm(line_of_sight)
+
+
+class PassPredictor:
+    stations = [station_ecef(*gs) for gs in getattr(CONFIG, "GROUND_STATIONS", [])]
+    enabled = bool(getattr(CONFIG, "PASS_PREDICTION", False)) and len(stations) > 0
+    min_sin_elevation = np.sin(np.radians(getattr(CONFIG, "MIN_ELEVATION", 0)))
+
+    windows = []  # upcoming [aos, los] windows in unix time, sorted
+
+    _epoch = None  # propagator epoch the search was started from
+    _t = 0  # unix time of the search state
+    _r = np.zeros((3,))
+    _v = np.zeros((3,))
+    _aos = None  # AOS of the window the search is currently inside of
+
+    @classmethod
+    def reset(cls):
+        cls._epoch = None
+        cls._aos = None
+        cls.windows = []
+
+    @classmethod
+    def _visible(cls, unix_time, r_eci):
+        r_ecef, _ = eci_to_ecef(unix_time, r_eci, cls._v)
+        for station, up in cls.stations:
+            if sin_elevation(r_ecef, station, up) >= cls.min_sin_elevation:
+                return True
+        return False
+
+    @classmethod
+    def update(cls, unix_time):
+        """Advance the pass search by a bounded number of samples."""
+        if not cls.enabled:
+            return
+
+        unix_time = int(unix_time)
+        if not OrbitPropagator.is_valid(unix_time):
+            cls.reset()
+            return
+
+        if cls._epoch != OrbitPropagator.epoch or cls._t < unix_time:
+            # New GPS fix, or the search fell behind (e.g. task paused): restart from now
+            cls.reset()
+            cls._epoch = OrbitPropagator.epoch
+            cls._t = unix_time
+            cls._r, cls._v = OrbitPropagator.state_eci(unix_time)
+            if cls._visible(cls._t, cls._r):
+                cls._aos = cls._t - _MARGIN
+
+        while cls.windows and cls.windows[0][1] < unix_time:
+            cls.windows.pop(0)
+
+        for _ in range(_SAMPLES_PER_UPDATE):
+            if cls._t >= unix_time + _HORIZON:
+                break
+            cls._r, cls._v = propagate(cls._r, cls._v, _SAMPLE_PERIOD)
+            cls._t += _SAMPLE_PERIOD
+            visible = cls._visible(cls._t, cls._r)
+            if visible and cls._aos is None:
+                cls._aos = cls._t - _SAMPLE_PERIOD - _MARGIN
+            elif not visible and cls._aos is not None:
+                cls.windows.append([cls._aos, cls._t + _MARGIN])
+                logger.info(f"[COMMS] Predicted pass AOS {cls._aos} LOS {cls._t + _MARGIN}")
+                cls._aos = None
+
+    @classmethod
+    def in_pass(cls, unix_time):
+        """
+        True if a ground station is predicted in view at unix_time, False if not,
+        None if there is no valid prediction covering unix_time.
+        """
+        if cls._epoch is None:
+            return None
+        for aos, los in cls.windows:
+            if aos <= unix_time <= los:
+                return True
+        if unix_time > cls._t:
+            return None
+        return cls._aos is not None and unix_time >= cls._aos
+
+    @classmethod
+    def next_pass(cls, unix_time):
+        """Next [aos, los] window ending after unix_time, or None if none was predicted yet."""
+        for window in cls.windows:
+            if window[1] >= unix_time:
+                return window
+        return None
@@ -47,4 +47,6 @@ def add_asterisk_packet(data, re_obj):
     """
     Will simply add an asterisk to the end of callsign in the path to indicate that the packed has been repeated
     """
-    return re_obj.sub(r"\g<0>*", data)
+    # The pattern is a str one, only substitute in the (ASCII, already validated) APRS string
+    aprs_str = data[_HEADER_LEN:].decode("ascii")
+    return data[:_HEADER_LEN] + re_obj.sub(r"\g<0>*", aprs_str).encode("ascii")
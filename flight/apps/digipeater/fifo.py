@@ -14,6 +14,7 @@ class DigipeaterRxQueue:
 
     _queue = []
     _max_size = 20
+    _drop_count = 0  # packets overwritten before the digipeater task got to them
 
     @classmethod
     def configure(cls, max_size):
@@ -24,6 +25,9 @@ class DigipeaterRxQueue:
         # Circular behavior: when full, overwrite the oldest packet.
         if len(cls._queue) >= cls._max_size:
             cls._queue.pop(0)
+            cls._queue.append(packet)
+            cls._drop_count += 1
+            return DIGIPEATER_QUEUE_STATUS.OVERFLOW
         cls._queue.append(packet)
         return DIGIPEATER_QUEUE_STATUS.OK
 
@@ -41,6 +45,10 @@ class DigipeaterRxQueue:
     def get_size(cls):
         return len(cls._queue)
 
+    @classmethod
+    def get_drop_count(cls):
+        return cls._drop_count
+
     @classmethod
     def clear(cls):
         cls._queue = []
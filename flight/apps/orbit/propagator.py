@@ -0,0 +1,206 @@
+"""
+
+Orbit Propagator
+
+Lightweight two-body + J2 orbit propagator (no drag) used to estimate the spacecraft position
+and velocity between GPS fixes, or while the GNSS receiver is powered off.
+
+The propagator is seeded from the latest record of the "gps" DataProcess, so it survives reboots
+and reseeds itself automatically whenever the GPS task logs a new fix. Propagation is incremental:
+the last propagated state is cached, and a query only integrates from the cached state to the
+requested time, so consumers polling at a regular rate pay for a handful of RK4 steps per call.
+
+- Inertial frame: ECI (true equator, GMST rotation only, UT1 ~ UTC)
+- Units: m, m/s, unix seconds (int)
+- Times are kept as int offsets from the seed epoch to preserve precision on 30-bit floats
+
+"""
+
+from core import DataHandler as DH
+from core.dh_constants import GPS_IDX
+from micropython import const
+from ulab import numpy as np
+
+_MU_EARTH = 3.986004418e14  # m^3/s^2
+_R_EARTH = 6378137.0  # m
+_J2 = 1.08262668e-3
+_OMEGA_EARTH = 7.2921150e-5  # rad/s
+_TWO_PI = 6.283185307179586
+
+_J2000_UNIX = const(946728000)  # 2000-01-01 12:00:00 UTC
+_SECONDS_PER_DAY = const(86400)
+
+_MAX_STEP = const(30)  # s, RK4 step upper bound
+_MAX_SEED_AGE = const(172800)  # s, beyond this the drag-free solution is considered stale
+_GPS_LOG_SCALE = 0.01  # GPS ECEF states are logged in cm and cm/s
+
+
+def gmst(unix_time):
+    """Greenwich mean sidereal angle [rad] at the given unix time."""
+    days, seconds = divmod(int(unix_time) - _J2000_UNIX, _SECONDS_PER_DAY)
+    # Keep the integer day term separate so the fraction of a revolution keeps its precision
+    rev = 0.7790572732640 + (0.00273781191135448 * days) % 1.0 + 1.00273781191135448 * seconds / _SECONDS_PER_DAY
+    return _TWO_PI * (rev % 1.0)
+
+
+def ecef_to_eci(unix_time, r_ecef, v_ecef):
+    """Rotate an ECEF position/velocity pair into ECI."""
+    theta = gmst(unix_time)
+    c, s = np.cos(theta), np.sin(theta)
+    # v_eci = R(theta) * (v_ecef + w x r_ecef)
+    vx = v_ecef[0] - _OMEGA_EARTH * r_ecef[1]
+    vy = v_ecef[1] + _OMEGA_EARTH * r_ecef[0]
+    r_eci = np.array([c * r_ecef[0] - s * r_ecef[1], s * r_ecef[0] + c * r_ecef[1], r_ecef[2]])
+    v_eci = np.array([c * vx - s * vy, s * vx + c * vy, v_ecef[2]])
+    return r_eci, v_eci
+
+
+def eci_to_ecef(unix_time, r_eci, v_eci):
+    """Rotate an ECI position/velocity pair into ECEF."""
+    theta = gmst(unix_time)
+    c, s = np.cos(theta), np.sin(theta)
+    r_ecef = np.array([c * r_eci[0] + s * r_eci[1], -s * r_eci[0] + c * r_eci[1], r_eci[2]])
+    # v_ecef = R(-theta) * v_eci - w x r_ecef
+    v_ecef = np.array(
+        [
+            c * v_eci[0] + s * v_eci[1] + _OMEGA_EARTH * r_ecef[1],
+            -s * v_eci[0] + c * v_eci[1] - _OMEGA_EARTH * r_ecef[0],
+            v_eci[2],
+        ]
+    )
+    return r_ecef, v_ecef
+
+
+def sun_direction_eci(unix_time):
+    """
+    Low-precision unit sun vector in ECI (~0.01 deg, Astronomical Almanac approximation).
+    """
+    days = (int(unix_time) - _J2000_UNIX) / _SECONDS_PER_DAY
+    mean_longitude = np.radians((280.460 + 0.9856474 * days) % 360.0)
+    mean_anomaly = np.radians((357.528 + 0.9856003 * days) % 360.0)
+    ecliptic_longitude = (
+        mean_longitude + np.radians(1.915) * np.sin(mean_anomaly) + np.radians(0.020) * np.sin(2 * mean_anomaly)
+    )
+    obliquity = np.radians(23.439 - 4.0e-7 * days)
+    return np.array(
+        [
+            np.cos(ecliptic_longitude),
+            np.cos(obliquity) * np.sin(ecliptic_longitude),
+            np.sin(obliquity) * np.sin(ecliptic_longitude),
+        ]
+    )
+
+
+def _acceleration(r):
+    """Two-body + J2 gravitational acceleration [m/s^2] at ECI position r."""
+    r2 = r[0] * r[0] + r[1] * r[1] + r[2] * r[2]
+    r_norm = r2**0.5
+    z2 = r[2] * r[2] / r2
+    k = -_MU_EARTH / (r2 * r_norm)
+    f = 1.5 * _J2 * _R_EARTH * _R_EARTH / r2
+    kxy = k * (1.0 + f * (1.0 - 5.0 * z2))
+    return np.array([kxy * r[0], kxy * r[1], k * (1.0 + f * (3.0 - 5.0 * z2)) * r[2]])
+
+
+def _rk4_step(r, v, h):
+    a1 = _acceleration(r)
+    r2 = r + 0.5 * h * v
+    v2 = v + 0.5 * h * a1
+    a2 = _acceleration(r2)
+    r3 = r + 0.5 * h * v2
+    v3 = v + 0.5 * h * a2
+    a3 = _acceleration(r3)
+    r4 = r + h * v3
+    v4 = v + h * a3
+    a4 = _acceleration(r4)
+    r_next = r + (h / 6.0) * (v + 2.0 * v2 + 2.0 * v3 + v4)
+    v_next = v + (h / 6.0) * (a1 + 2.0 * a2 + 2.0 * a3 + a4)
+    return r_next, v_next
+
+
+def propagate(r, v, dt):
+    """Propagate an ECI state by dt seconds (signed) in RK4 steps of at most _MAX_STEP."""
+    if dt == 0:
+        return r, v
+    n_steps = (abs(dt) + _MAX_STEP - 1) // _MAX_STEP
+    h = dt / n_steps
+    for _ in range(n_steps):
+        r, v = _rk4_step(r, v, h)
+    return r, v
+
+
+class OrbitPropagator:
+    """
+    Static propagator state shared by every consumer (ADCS, COMMS).
+
+    Use state_eci / state_ecef to query the orbit; the seed is refreshed from the "gps" DataProcess on each query.
+    """
+
+    epoch = None  # unix time of the seed fix
+    _seed_r = np.zeros((3,))  # ECI state at epoch
+    _seed_v = np.zeros((3,))
+    _t = 0  # seconds since epoch of the cached state
+    _r = np.zeros((3,))  # cached ECI state
+    _v = np.zeros((3,))
+
+    @classmethod
+    def seed(cls, unix_time, r_ecef, v_ecef):
+        """Reset the propagator to an ECEF state [m, m/s] observed at unix_time."""
+        r_eci, v_eci = ecef_to_eci(unix_time, r_ecef, v_ecef)
+        cls.epoch = int(unix_time)
+        cls._seed_r, cls._seed_v = r_eci, v_eci
+        cls._t = 0
+        cls._r, cls._v = r_eci, v_eci
+
+    @classmethod
+    def update_from_gps_log(cls):
+        """
+        Reseed from the latest "gps" DataProcess record if it is newer than the current epoch.
+
+        Returns True if the propagator holds a seed after the call.
+        """
+        if DH.data_process_exists("gps"):
+            gps_data = DH.get_latest_data("gps")
+            if gps_data is not None:
+                fix_time = gps_data[GPS_IDX.GPS_LAST_FIX_TIME]
+                position = gps_data[GPS_IDX.GPS_ECEF_X : GPS_IDX.GPS_ECEF_Z + 1]
+                if fix_time > 0 and fix_time != cls.epoch and any(position):
+                    velocity = gps_data[GPS_IDX.GPS_ECEF_VX : GPS_IDX.GPS_ECEF_VZ + 1]
+                    cls.seed(
+                        fix_time,
+                        np.array(position) * _GPS_LOG_SCALE,
+                        np.array(velocity) * _GPS_LOG_SCALE,
+                    )
+        return cls.epoch is not None
+
+    @classmethod
+    def is_valid(cls, unix_time):
+        """True if seeded and the seed is recent enough for the drag-free solution to be trusted."""
+        return cls.update_from_gps_log() and abs(int(unix_time) - cls.epoch) <= _MAX_SEED_AGE
+
+    @classmethod
+    def state_eci(cls, unix_time):
+        """
+        ECI position [m] and velocity [m/s] at unix_time, or (None, None) if the propagator was never seeded.
+        """
+        if not cls.update_from_gps_log():
+            return None, None
+
+        t = int(unix_time) - cls.epoch
+        # Restart from the seed when it is closer to the requested time than the cached state
+        if abs(t) < abs(t - cls._t):
+            cls._t, cls._r, cls._v = 0, cls._seed_r, cls._seed_v
+
+        if t != cls._t:
+            cls._r, cls._v = propagate(cls._r, cls._v, t - cls._t)
+            cls._t = t
+
+        return cls._r, cls._v
+
+    @classmethod
+    def state_ecef(cls, unix_time):
+        """ECEF position [m] and velocity [m/s] at unix_time, or (None, None) if never seeded."""
+        r_eci, v_eci = cls.state_eci(unix_time)
+        if r_eci is None:
+            return None, None
+        return eci_to_ecef(unix_time, r_eci, v_eci)
@@ -18,7 +18,7 @@ from core import DataHandler as DH
 from core import logger
 from core import state_manager as SM
 from core.dh_constants import PAYLOAD_IDX
-from core.states import STATES
+from core.states import ACTIVITY, STATES
 from core.time_processor import TimeProcessor as TPM
 from hal.configuration import SATELLITE
 
@@ -129,6 +129,9 @@ class PayloadController:
         previous_state = cls.current_state
         cls.current_state = map_state(state)
 
+        # download has its own task rate profile (e.g. slower HAL monitor)
+        SM.set_activity(ACTIVITY.PAYLOAD_DOWNLOAD, cls.current_state == PayloadState.DOWNLOAD)
+
         # need to update the log data
         cls.log_data[PAYLOAD_IDX.PD_STATE_MAINBOARD] = cls.current_state
         DH.log_data("payload_tm", cls.log_data)
@@ -673,7 +676,7 @@ class PayloadController:
 
         try:
             SATELLITE.JETSON_ENABLE.value = True
-            TPM.sleep(0.1)  # TODO: probably do not need this delay
+            TPM.settle(0.1)  # TODO: probably do not need this delay
             SATELLITE.JETSON_SD_REQ.value = True  # turn of 5v dcdc to save more power
             logger.info("[PAYLOAD] Jetson power enabled successfully.")
             return True
@@ -696,7 +699,7 @@ class PayloadController:
 
         try:
             SATELLITE.JETSON_ENABLE.value = False
-            TPM.sleep(0.1)  # TODO: probably do not need this delay
+            TPM.settle(0.1)  # TODO: probably do not need this delay
             SATELLITE.JETSON_SD_REQ.value = False  # turn off the 5v regulator to save power
             logger.info("[PAYLOAD] - Jetson power disabled successfully")
             return True
@@ -67,15 +67,15 @@ class Frame:
         return data
 
     @classmethod
-    def pack_tm_heartbeat(cls):
+    def _pack_report(cls, name, ss_list, idx_list):
         """
-        Pack a heartbeat telemetry frame.
+        Pack the report name from the latest DH data of the subsystems in ss_list,
+        idx_list gives the dh constants of each subsystem (same order)
         """
         # this will be a report
-        report = Report("TM_HEARTBEAT")
+        report = Report(name)
+        frame = name[3:]  # report name without the TM_ prefix, for the logs
 
-        ss_list = ["cdh", "eps", "adcs", "gps", "comms"]  # we need this to get the from dh, and it is case sensitive
-        idx_list = [CDH_IDX, EPS_IDX, ADCS_IDX, GPS_IDX, COMMS_IDX]  # this is used to match the ss to the dh constants
         # get the latest data from each subsystem
         dh_data_list = [cls.get_dh_latest_data(x) for x in ss_list]
 
@@ -83,12 +83,12 @@ class Frame:
         for ss in report.variables.keys():
             ss_lower = ss.lower()  # Create lowercase version for lookups
             if ss_lower not in ss_list:
-                logger.warning(f"Subsystem {ss.upper()} not recognized for heartbeat")
+                logger.warning(f"Subsystem {ss.upper()} not recognized for {frame}")
                 continue
 
             dh_data = dh_data_list[ss_list.index(ss_lower)]
             if dh_data is None:
-                logger.warning(f"No data for subsystem {ss.upper()} to pack in heartbeat")
+                logger.warning(f"No data for subsystem {ss.upper()} to pack in {frame}")
                 continue
 
             # iterating over all the variables for the ss in the report and adding them
@@ -96,47 +96,28 @@ class Frame:
                 dh_var_idx = getattr(idx_list[ss_list.index(ss_lower)], var_name)
                 report.add_variable(var_name, ss, dh_data[dh_var_idx])
 
-        logger.debug(f"Packed heartbeat telemetry frame {report}")
+        logger.debug(f"Packed {frame} telemetry frame {report}")
 
         gc.collect()
 
         return report
 
+    @classmethod
+    def pack_tm_heartbeat(cls):
+        """
+        Pack a heartbeat telemetry frame.
+        """
+        # ss names are case sensitive in DH, the dh constants are matched by position
+        return cls._pack_report(
+            "TM_HEARTBEAT", ["cdh", "eps", "adcs", "gps", "comms"], [CDH_IDX, EPS_IDX, ADCS_IDX, GPS_IDX, COMMS_IDX]
+        )
+
     @classmethod
     def pack_tm_hal(cls):
         """
         Pack a HAL telemetry frame.
         """
-        # this will be a report
-        report = Report("TM_HAL")
-
-        ss_list = ["cdh", "eps", "storage"]  # we need this to get the from dh, and it is case sensitive
-        idx_list = [CDH_IDX, EPS_IDX, STORAGE_IDX]  # this is used to match the ss to the dh constants
-        # get the latest data from each subsystem
-        dh_data_list = [cls.get_dh_latest_data(x) for x in ss_list]
-
-        # for each variable in the report, get the corresponding data from DH
-        for ss in report.variables.keys():
-            ss_lower = ss.lower()  # Create lowercase version for lookups
-            if ss_lower not in ss_list:
-                logger.warning(f"Subsystem {ss.upper()} not recognized for HAL")
-                continue
-
-            dh_data = dh_data_list[ss_list.index(ss_lower)]
-            if dh_data is None:
-                logger.warning(f"No data for subsystem {ss.upper()} to pack in HAL")
-                continue
-
-            # iterating over all the variables for the ss in the report and adding them
-            for var_name in report.variables[ss].keys():
-                dh_var_idx = getattr(idx_list[ss_list.index(ss_lower)], var_name)
-                report.add_variable(var_name, ss, dh_data[dh_var_idx])
-
-        logger.debug(f"Packed HAL telemetry frame {report}")
-
-        gc.collect()
-
-        return report
+        return cls._pack_report("TM_HAL", ["cdh", "eps", "storage"], [CDH_IDX, EPS_IDX, STORAGE_IDX])
 
     @classmethod
     def pack_tm_storage(cls):
@@ -221,34 +202,4 @@ class Frame:
         Pack a payload telemetry frame.
         """
         logger.info("[TELEMETRY] - Packing PAYLOAD telemetry frame")
-        # this will be a report
-        report = Report("TM_PAYLOAD")
-
-        ss_list = ["payload_tm"]  # we need this to get the from dh, and it is case sensitive
-        idx_list = [PAYLOAD_IDX]  # this is used to match the ss to the dh constants, payload only has 1 variable so idx is 0
-        # get the latest data from each subsystem
-        dh_data_list = [cls.get_dh_latest_data(x) for x in ss_list]
-
-        # for each variable in the report, get the corresponding data from DH
-        for ss in report.variables.keys():
-            ss_lower = ss.lower()  # Create lowercase version for lookups
-            if ss_lower not in ss_list:
-                logger.warning(f"Subsystem {ss.upper()} not recognized for PAYLOAD")
-                continue
-
-            dh_data = dh_data_list[ss_list.index(ss_lower)]
-            if dh_data is None:
-                logger.warning(f"No data for subsystem {ss.upper()} to pack in PAYLOAD")
-                continue
-
-            # iterating over all the variables for the ss in the report and adding them
-            for var_name in report.variables[ss].keys():
-                dh_var_idx = getattr(idx_list[ss_list.index(ss_lower)], var_name)
-                data = dh_data[dh_var_idx]
-                report.add_variable(var_name, ss, data)
-
-        logger.info(f"Packed PAYLOAD telemetry frame {report}")
-
-        gc.collect()
-
-        return report
+        return cls._pack_report("TM_PAYLOAD", ["payload_tm"], [PAYLOAD_IDX])
@@ -1,5 +1,5 @@
 # Core modules containing the framework of the flight software
-from core.data_handler import DataHandler
+from core.data_handler import DataHandler, DataRecord
 from core.logging import logger, setup_logger
 from core.state_machine import StateManager
 from core.template_task import TemplateTask
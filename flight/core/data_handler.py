@@ -65,6 +65,91 @@ _PROCESS_CONFIG_FILENAME = ".data_process_configuration.json"
 _FILE_TAG_NAME = "file"  # Identifier for generic file processes
 
 
+class DataRecord:
+    """
+    Preallocated binary record of a data process.
+
+    The fields live packed in a bytearray laid out exactly like one line of the data process file, so a task keeps a
+    single record for its whole lifetime and writes its fields in place. The Data Handler then writes and caches the
+    record bytes as they are instead of packing a new bytes object from a list of boxed values on every log.
+
+    Fields are read and written by their dh_constants index, e.g. record[ADCS_IDX.MAG_X] = 0.25.
+    A slice or an iteration unpacks all the fields (only meant for debug prints and restoring state).
+
+    Records of the processes in configuration/data_schema.yaml are built from their generated core.schemas module,
+    which carries the byte offset and struct format of every field so nothing is parsed at runtime.
+
+    Attributes:
+        data_format (str): The struct format of the record, with the "<" endianness character.
+        buffer (bytearray): The packed fields.
+    """
+
+    __slots__ = ("data_format", "buffer", "_formats", "_offsets")
+
+    def __init__(self, data_format, buffer: bytearray = None) -> None:
+        """
+        Initializes a zeroed DataRecord, or a view over an existing buffer.
+
+        Args:
+            data_format (str or module): The format of the record, as registered for the data process (e.g. 'LBf'),
+                                         or the core.schemas module of the data process.
+            buffer (bytearray, optional): Packed fields to wrap instead of allocating a new buffer.
+        """
+        if isinstance(data_format, str):
+            self.data_format = "<" + data_format
+            bytesize = DataProcess.compute_bytesize(self.data_format)
+
+            # pack_into/unpack_from format and byte offset of each field
+            formats = []
+            offsets = []
+            offset = 0
+            for c in data_format:
+                formats.append("<" + c)
+                offsets.append(offset)
+                offset += DataProcess._FORMAT[c]
+            self._formats = tuple(formats)
+            self._offsets = tuple(offsets)
+        else:
+            self.data_format = "<" + data_format.FORMAT
+            bytesize = data_format.BYTESIZE
+            self._formats = data_format.FIELD_FORMATS
+            self._offsets = data_format.OFFSETS
+
+        if buffer is None:
+            buffer = bytearray(bytesize)
+        elif len(buffer) != bytesize:
+            raise ValueError(f"Record buffer of {len(buffer)} bytes for a {bytesize} bytes format")
+        self.buffer = buffer
+
+    def __getitem__(self, idx):
+        if isinstance(idx, int):
+            return struct.unpack_from(self._formats[idx], self.buffer, self._offsets[idx])[0]
+        return list(self.values())[idx]
+
+    def __setitem__(self, idx: int, value) -> None:
+        struct.pack_into(self._formats[idx], self.buffer, self._offsets[idx], value)
+
+    def __len__(self) -> int:
+        return len(self._offsets)
+
+    def __iter__(self):
+        return iter(self.values())
+
+    def values(self) -> Tuple[Any, ...]:
+        """
+        Unpacks all the fields of the record.
+        """
+        return struct.unpack_from(self.data_format, self.buffer)
+
+    def clear(self) -> None:
+        """
+        Zeroes all the fields in place.
+        """
+        buffer = self.buffer
+        for i in range(len(buffer)):
+            buffer[i] = 0
+
+
 class DataProcess:
     """
     Class for managing a single logging stream.
@@ -240,14 +325,20 @@ class DataProcess:
         """
         Logs the given data (eventually also to a file if persistent = True).
 
+        A DataRecord is copied into the latest data cache and written to the file as it is, without repacking.
+
         Args:
-            data (List): The data to be logged.
+            data (List or DataRecord): The data to be logged.
 
         Returns:
             None
         """
 
-        self.last_data = data
+        if isinstance(data, DataRecord):
+            if not self.cache_record(data):
+                return
+        else:
+            self.last_data = data
 
         if self.persistent and not DataHandler.REBOOT_IN_PROGRESS:
             self.resolve_current_file()
@@ -255,7 +346,10 @@ class DataProcess:
 
             if self.write_interval_counter >= self.write_interval:
                 try:
-                    bin_data = struct.pack(self.data_format, *data)
+                    if isinstance(data, DataRecord):
+                        bin_data = data.buffer
+                    else:
+                        bin_data = struct.pack(self.data_format, *data)
                     self.file.write(bin_data)
                     self.file.flush()  # Flush immediately
                     self.write_interval_counter = 0
@@ -266,6 +360,21 @@ class DataProcess:
                     self.file = None
                     self.status = _CLOSED
 
+    def cache_record(self, record: DataRecord) -> bool:
+        """
+        Copies a logged record into the latest data cache, a DataRecord owned by the data process.
+        The cache is allocated once and then overwritten in place, so the task can keep filling its own record.
+
+        Returns True if the record was cached, False if its format does not match the data process.
+        """
+        if record.data_format != self.data_format:
+            logger.error(f"Record format {record.data_format} does not match {self.tag_name} format {self.data_format}")
+            return False
+        if not isinstance(self.last_data, DataRecord):
+            self.last_data = DataRecord(self.data_format[1:])
+        self.last_data.buffer[:] = record.buffer
+        return True
+
     def get_latest_data(self) -> Optional[List]:
         """
         Returns the latest data point.
@@ -273,6 +382,9 @@ class DataProcess:
         If a data point has been logged, it returns the last data point.
         If no data point has been logged yet, it returns None.
 
+        For records logged as a DataRecord (or retrieved from the file at boot), this is a DataRecord view that the
+        next log overwrites in place: index it directly, or call values() to keep a snapshot.
+
         Returns:
             The latest data point or None if no data point is available yet.
         """
@@ -373,7 +485,7 @@ class DataProcess:
                     cr = file.read(self.bytesize)
                     if len(cr) != self.bytesize:  # Handle incomplete data
                         return False
-                    self.last_data = struct.unpack(self.data_format, cr)
+                    self.last_data = DataRecord(self.data_format[1:], bytearray(cr))
                     return True
             except Exception as e:
                 logger.warning(f"Error reading file {latest_file}: {e}")
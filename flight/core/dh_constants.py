@@ -1,136 +1,19 @@
 # Index constants for accessing data in the Data Handler
-
+# The index classes of the data processes are generated from configuration/data_schema.yaml into core.schemas
+
+from core.schemas.adcs import ADCS_IDX
+from core.schemas.cdh import CDH_IDX
+from core.schemas.comms import COMMS_IDX
+from core.schemas.eps import EPS_IDX
+from core.schemas.eps_warning import EPS_WARNING_IDX
+from core.schemas.gps import GPS_IDX
+from core.schemas.hal import HAL_IDX
+from core.schemas.mag_cal import MAG_CAL_IDX
+from core.schemas.mem import MEM_IDX
+from core.schemas.sched import SCHED_IDX
 from micropython import const
 
 
-class CDH_IDX:
-    TIME = const(0)
-    BOOT_TIME = const(1)
-    SC_STATE = const(2)
-    SD_USAGE = const(3)
-    CURRENT_RAM_USAGE = const(4)
-    BOOT_COUNT = const(5)
-    WATCHDOG_TIMER = const(6)
-    HAL_BITFLAGS = const(7)
-    DETUMBLING_ERROR_FLAG = const(8)
-
-
-class EPS_IDX:
-    TIME_EPS = const(0)
-    EPS_POWER_FLAG = const(1)
-    MAINBOARD_TEMPERATURE = const(2)
-    MAINBOARD_VOLTAGE = const(3)
-    MAINBOARD_CURRENT = const(4)
-    BATTERY_PACK_TEMPERATURE = const(5)
-    BATTERY_PACK_TEMPERATURE_AIN1 = const(6)
-    BATTERY_PACK_TEMPERATURE_AIN2 = const(7)
-    BATTERY_PACK_TEMPERATURE_DIE = const(8)
-    BATTERY_PACK_REPORTED_SOC = const(9)
-    BATTERY_PACK_REPORTED_CAPACITY = const(10)
-    BATTERY_PACK_CURRENT = const(11)
-    BATTERY_PACK_VOLTAGE = const(12)
-    BATTERY_PACK_MIDPOINT_VOLTAGE = const(13)
-    BATTERY_PACK_TTE = const(14)
-    BATTERY_PACK_TTF = const(15)
-    XP_COIL_VOLTAGE = const(16)
-    XP_COIL_CURRENT = const(17)
-    XM_COIL_VOLTAGE = const(18)
-    XM_COIL_CURRENT = const(19)
-    YP_COIL_VOLTAGE = const(20)
-    YP_COIL_CURRENT = const(21)
-    YM_COIL_VOLTAGE = const(22)
-    YM_COIL_CURRENT = const(23)
-    ZP_COIL_VOLTAGE = const(24)
-    ZP_COIL_CURRENT = const(25)
-    ZM_COIL_VOLTAGE = const(26)
-    ZM_COIL_CURRENT = const(27)
-    JETSON_INPUT_VOLTAGE = const(28)
-    JETSON_INPUT_CURRENT = const(29)
-    RF_LDO_OUTPUT_VOLTAGE = const(30)
-    RF_LDO_OUTPUT_CURRENT = const(31)
-    GPS_VOLTAGE = const(32)
-    GPS_CURRENT = const(33)
-    XP_SOLAR_CHARGE_VOLTAGE = const(34)
-    XP_SOLAR_CHARGE_CURRENT = const(35)
-    XM_SOLAR_CHARGE_VOLTAGE = const(36)
-    XM_SOLAR_CHARGE_CURRENT = const(37)
-    YP_SOLAR_CHARGE_VOLTAGE = const(38)
-    YP_SOLAR_CHARGE_CURRENT = const(39)
-    YM_SOLAR_CHARGE_VOLTAGE = const(40)
-    YM_SOLAR_CHARGE_CURRENT = const(41)
-    BATTERY_HEATERS1_ENABLED = const(42)
-    BATTERY_HEATERS2_ENABLED = const(43)
-
-
-class EPS_WARNING_IDX:
-    TIME_EPS_WARNING = const(0)
-    MAINBOARD_POWER_ALERT = const(1)
-    PERIPHERAL_POWER_ALERT = const(2)
-    RADIO_POWER_ALERT = const(3)
-    JETSON_POWER_ALERT = const(4)
-    XP_COIL_POWER_ALERT = const(5)
-    XM_COIL_POWER_ALERT = const(6)
-    YP_COIL_POWER_ALERT = const(7)
-    YM_COIL_POWER_ALERT = const(8)
-    ZP_COIL_POWER_ALERT = const(9)
-    ZM_COIL_POWER_ALERT = const(10)
-
-
-class ADCS_IDX:
-    TIME_ADCS = const(0)
-    MODE = const(1)
-    GYRO_X = const(2)
-    GYRO_Y = const(3)
-    GYRO_Z = const(4)
-    MAG_X = const(5)
-    MAG_Y = const(6)
-    MAG_Z = const(7)
-    SUN_STATUS = const(8)
-    SUN_VEC_X = const(9)
-    SUN_VEC_Y = const(10)
-    SUN_VEC_Z = const(11)
-    LIGHT_SENSOR_XP = const(12)
-    LIGHT_SENSOR_XM = const(13)
-    LIGHT_SENSOR_YP = const(14)
-    LIGHT_SENSOR_YM = const(15)
-    LIGHT_SENSOR_ZP_XP = const(16)
-    LIGHT_SENSOR_ZP_YM = const(17)
-    LIGHT_SENSOR_ZP_XM = const(18)
-    LIGHT_SENSOR_ZP_YP = const(19)
-    LIGHT_SENSOR_ZM = const(20)
-    XP_COIL_STATUS = const(21)
-    XM_COIL_STATUS = const(22)
-    YP_COIL_STATUS = const(23)
-    YM_COIL_STATUS = const(24)
-    ZP_COIL_STATUS = const(25)
-    ZM_COIL_STATUS = const(26)
-    # ATTITUDE_QW = const(27)
-    # ATTITUDE_QX = const(28)
-    # ATTITUDE_QY = const(29)
-    # ATTITUDE_QZ = const(30)
-
-
-class GPS_IDX:
-    TIME_GPS = const(0)
-    GPS_MESSAGE_ID = const(1)
-    GPS_FIX_MODE = const(2)
-    GPS_LAST_FIX_TIME = const(3)
-    GPS_LAST_FIX_MODE = const(4)
-    GPS_GNSS_WEEK = const(5)
-    GPS_GNSS_TOW = const(6)
-    GPS_GDOP = const(7)
-    GPS_PDOP = const(8)
-    GPS_HDOP = const(9)
-    GPS_VDOP = const(10)
-    GPS_TDOP = const(11)
-    GPS_ECEF_X = const(12)
-    GPS_ECEF_Y = const(13)
-    GPS_ECEF_Z = const(14)
-    GPS_ECEF_VX = const(15)
-    GPS_ECEF_VY = const(16)
-    GPS_ECEF_VZ = const(17)
-
-
 class PAYLOAD_IDX:
     # TM_PAYLOAD fields from telemetry_definition (Jetson)
     SYSTEM_TIME = const(0)
@@ -165,85 +48,6 @@ class STORAGE_IDX:
     DIR_SIZE = const(1)
 
 
-class COMMS_IDX:
-    RX_PACKET_COUNT = const(0)
-    RX_DIGIPEATER_COUNT = const(1)
-    FAILED_UNPACK_COUNT = const(2)
-    CRC_ERROR_COUNT = const(3)
-    UNDEF_ERROR_COUNT = const(4)
-    PACKET_NONE_COUNT = const(5)
-    PACKET_AUTH_FAIL_COUNT = const(6)
-    TX_PACKET_COUNT = const(7)
-    TX_FAILED_COUNT = const(8)
-    TX_DIGIPEATER_COUNT = const(9)
-    RX_MESSAGE_RSSI = const(10)
-
-
-class HAL_IDX:
-    TIME_HAL = const(0)
-    SDCARD_ERROR = const(1)
-    SDCARD_ERROR_COUNT = const(2)
-    RTC_ERROR = const(3)
-    RTC_ERROR_COUNT = const(4)
-    GPS_ERROR = const(5)
-    GPS_ERROR_COUNT = const(6)
-    RADIO_ERROR = const(7)
-    RADIO_ERROR_COUNT = const(8)
-    IMU_ERROR = const(9)
-    IMU_ERROR_COUNT = const(10)
-    FUEL_GAUGE_ERROR = const(11)
-    FUEL_GAUGE_ERROR_COUNT = const(12)
-    BATT_HEATERS_ERROR = const(13)
-    BATT_HEATERS_ERROR_COUNT = const(14)
-    WATCHDOG_ERROR = const(15)
-    WATCHDOG_ERROR_COUNT = const(16)
-    BURN_WIRES_ERROR = const(17)
-    BURN_WIRES_ERROR_COUNT = const(18)
-    BOARD_PWR_ERROR = const(19)
-    BOARD_PWR_ERROR_COUNT = const(20)
-    RADIO_PWR_ERROR = const(21)
-    RADIO_PWR_ERROR_COUNT = const(22)
-    GPS_PWR_ERROR = const(23)
-    GPS_PWR_ERROR_COUNT = const(24)
-    JETSON_PWR_ERROR = const(25)
-    JETSON_PWR_ERROR_COUNT = const(26)
-    TORQUE_XP_ERROR = const(27)
-    TORQUE_XP_ERROR_COUNT = const(28)
-    TORQUE_XM_ERROR = const(29)
-    TORQUE_XM_ERROR_COUNT = const(30)
-    TORQUE_YP_ERROR = const(31)
-    TORQUE_YP_ERROR_COUNT = const(32)
-    TORQUE_YM_ERROR = const(33)
-    TORQUE_YM_ERROR_COUNT = const(34)
-    TORQUE_ZP_ERROR = const(35)
-    TORQUE_ZP_ERROR_COUNT = const(36)
-    TORQUE_ZM_ERROR = const(37)
-    TORQUE_ZM_ERROR_COUNT = const(38)
-    LIGHT_XP_ERROR = const(39)
-    LIGHT_XP_ERROR_COUNT = const(40)
-    LIGHT_XM_ERROR = const(41)
-    LIGHT_XM_ERROR_COUNT = const(42)
-    LIGHT_YP_ERROR = const(43)
-    LIGHT_YP_ERROR_COUNT = const(44)
-    LIGHT_YM_ERROR = const(45)
-    LIGHT_YM_ERROR_COUNT = const(46)
-    LIGHT_ZM_ERROR = const(47)
-    LIGHT_ZM_ERROR_COUNT = const(48)
-    LIGHT_ZP_XP_ERROR = const(49)
-    LIGHT_ZP_XP_ERROR_COUNT = const(50)
-    LIGHT_ZP_YM_ERROR = const(51)
-    LIGHT_ZP_YM_ERROR_COUNT = const(52)
-    LIGHT_ZP_XM_ERROR = const(53)
-    LIGHT_ZP_XM_ERROR_COUNT = const(54)
-    LIGHT_ZP_YP_ERROR = const(55)
-    LIGHT_ZP_YP_ERROR_COUNT = const(56)
-    DEPLOYMENT_XP_ERROR = const(57)
-    DEPLOYMENT_XP_ERROR_COUNT = const(58)
-    DEPLOYMENT_YM_ERROR = const(59)
-    DEPLOYMENT_YM_ERROR_COUNT = const(60)
-    PERIPH_REBOOT_COUNT = const(61)
-
-
 """
 Helper function to get the number of attributes in a class
 This result should be static
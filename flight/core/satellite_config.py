@@ -17,6 +17,7 @@ class time_processor_config:
 
 class main_config:
     LOG_LEVEL = "DEBUG"
+    MEM_PROFILE = True
 
 
 class hal_monitor_config:
@@ -29,12 +30,25 @@ class comms_config:
     AUTH_KEY_HEX = "d6172b38acb7d2a28e21662f689d1d15ad78ccc888a9c7a78ef58cb61b0f1e32"
     SC_CALLSIGN = "CT6xxx"
     GS_CALLSIGN = "CSXXXX"
+    PASS_PREDICTION = True
+    GROUND_STATIONS = [[40.4433, -79.9436, 300.0]]
+    MIN_ELEVATION = const(5)
+    HB_PERIOD_OUT_OF_PASS = const(600)
 
 
 class digipeater_config:
     RX_QUEUE_MAX = const(5)
 
 
+class adcs_config:
+    COIL_ON_FRACTION = 0.8
+
+
+class watchdog_config:
+    HEARTBEAT_WINDOW = 10
+    HEARTBEAT_PERIOD = 1
+
+
 class hal_config:
     ASIL0_EN = True
 
@@ -1,4 +1,4 @@
-from core.scheduler.scheduler import Scheduler
+from core.scheduler.scheduler import OverrunPolicy, Scheduler
 
 __global_event_loop = None
 
@@ -19,5 +19,8 @@ add_task = get_loop().add_task
 run_later = get_loop().run_later
 schedule = get_loop().schedule
 schedule_later = get_loop().schedule_later
+set_utilisation_bound = get_loop().set_utilisation_bound
+utilisation = get_loop().utilisation
+set_heartbeat = get_loop().set_heartbeat
 sleep = get_loop().sleep
 run = get_loop().run
@@ -21,6 +21,24 @@ import time
 # Set up a monotonic clock is used to avoid issues with system clock adjustments.
 _monotonic_ns = time.monotonic_ns  # nanoseconds
 
+_MAX_CATCH_UP = 4  # periods a CATCH_UP task may fall behind before its missed releases are dropped
+_MAX_DEGRADE = 8  # largest period multiplier applied to a DEGRADE task
+_RESTORE_AFTER = 8  # consecutive iterations within the deadline before a DEGRADE task gets its rate doubled back
+
+
+class OverrunPolicy:
+    """
+    What a ScheduledTask does once an iteration ends after its next release time:
+    - SKIP: drops the missed releases and resumes on the next one, so an overrunning task does not run back to back
+    - CATCH_UP: runs the missed releases back to back (yielding in between), up to _MAX_CATCH_UP periods behind
+    - DEGRADE: as SKIP, and each overrun of the deadline halves the rate, down to 1 / _MAX_DEGRADE. The rate is doubled
+      back after _RESTORE_AFTER iterations within the deadline.
+    """
+
+    SKIP = 0
+    CATCH_UP = 1
+    DEGRADE = 2
+
 
 def _yield_once():
     """
@@ -85,7 +103,12 @@ class Sleeper:
 
 
 class ScheduledTask:
-    """Manages tasks that should run at a fixed frequency."""
+    """
+    Manages tasks that should run at a fixed frequency.
+
+    Each iteration is released on a fixed grid and must complete within its deadline (the period by default) after
+    its release. Iterations completing later are counted in overruns, the OverrunPolicy decides how the task recovers.
+    """
 
     def __init__(
         self,
@@ -95,6 +118,9 @@ class ScheduledTask:
         priority,
         forward_args,
         forward_kwargs,
+        budget=None,
+        deadline=None,
+        overrun=OverrunPolicy.SKIP,
     ):
         # reference to the event loop
         self._loop = loop
@@ -103,17 +129,33 @@ class ScheduledTask:
         self._forward_args = forward_args
         self._forward_kwargs = forward_kwargs
         # time between invocations
-        self._nanoseconds_per_invocation = (1 / hz) * 1000000000
+        self._nanoseconds_per_invocation = int(1000000000 / hz)
         # control flags
         self._stop = False
         self._running = False
         self._scheduled_to_run = False
         # priority
         self._priority = priority
+        # execution time budget [s] of one iteration counted by the admission test, deadline [s] relative to the release
+        # (None: period)
+        self.budget = budget
+        self.admitted = True  # False if the budget did not fit when scheduled
+        self.deadline = deadline
+        self.overrun_policy = overrun
+        self.overruns = 0  # iterations completed after their deadline
+        self.skipped = 0  # releases dropped while behind schedule
+        self.degrade = 1  # period multiplier of the DEGRADE policy
+        self._on_time = 0  # consecutive iterations within the deadline
 
     def change_rate(self, hz: float):
         """Update the task rate to a new frequency."""
-        self._nanoseconds_per_invocation = (1 / hz) * 1000000000
+        self._nanoseconds_per_invocation = int(1000000000 / hz)
+
+    def utilisation(self):
+        """Fraction of the CPU reserved by the budget at the current rate, 0 without a budget."""
+        if self.budget is None:
+            return 0.0
+        return self.budget * 1000000000 / self._nanoseconds_per_invocation
 
     def stop(self):
         """Stop the task (does not interrupt a currently running task."""
@@ -129,7 +171,7 @@ class ScheduledTask:
         """Coroutine that runs the task at the specified rate."""
         self._scheduled_to_run = True
         try:
-            target_run_nanos = _monotonic_ns()
+            release_nanos = _monotonic_ns()
             while True:
                 if self._stop:
                     return
@@ -145,25 +187,46 @@ class ScheduledTask:
                 if self._stop:
                     return  # Check before waiting
 
-                # Try to reschedule for the next window without skew. If we're falling behind,
-                # just go as fast as possible & schedule to run "now." If we catch back up again
-                # we'll return to seconds_per_invocation without doing a bunch of catchup runs.
-                target_run_nanos = target_run_nanos + self._nanoseconds_per_invocation
-                # print('target_run_nanos is ', target_run_nanos)
+                # Deadline of this release, the next one is at the period adapted by the DEGRADE policy
                 now_nanos = _monotonic_ns()
-                if now_nanos <= target_run_nanos:
-                    await self._loop._sleep_until_nanos(target_run_nanos)
-                else:
-                    target_run_nanos = now_nanos
-                    # Allow other tasks a chance to run if this task is too slow.
+                self._check_deadline(now_nanos - release_nanos, self._nanoseconds_per_invocation * self.degrade)
+                period_nanos = self._nanoseconds_per_invocation * self.degrade
+
+                # Next release on the fixed grid, without skew
+                release_nanos += period_nanos
+                behind_nanos = now_nanos - release_nanos
+                if behind_nanos <= 0:
+                    await self._loop._sleep_until_nanos(release_nanos)
+                elif self.overrun_policy == OverrunPolicy.CATCH_UP and behind_nanos < _MAX_CATCH_UP * period_nanos:
+                    # Run the missed release now, but allow other tasks a chance to run first
                     await _yield_once()
+                else:
+                    # Drop the missed releases and wait for the next one, the task does not run back to back
+                    missed = behind_nanos // period_nanos + 1
+                    self.skipped += missed
+                    release_nanos += missed * period_nanos
+                    await self._loop._sleep_until_nanos(release_nanos)
         finally:
             self._scheduled_to_run = False
 
+    def _check_deadline(self, response_nanos, period_nanos):
+        """Counts an iteration completed response_nanos after its release, and adapts the rate of a DEGRADE task."""
+        deadline_nanos = period_nanos if self.deadline is None else int(self.deadline * 1000000000)
+        if response_nanos > deadline_nanos:
+            self.overruns += 1
+            self._on_time = 0
+            if self.overrun_policy == OverrunPolicy.DEGRADE and self.degrade < _MAX_DEGRADE:
+                self.degrade *= 2
+        else:
+            self._on_time += 1
+            if self.degrade > 1 and self._on_time >= _RESTORE_AFTER:
+                self.degrade //= 2
+                self._on_time = 0
+
     def __repr__(self):
-        hz = 1 / (self._nanoseconds_per_invocation / 1000000000)
+        hz = 1 / (self._nanoseconds_per_invocation * self.degrade / 1000000000)
         state = "running" if self._running else "waiting"
-        return "{{ScheduledTask {} rate: {}hz, fn: {}}}".format(state, hz, self._forward_async_fn)
+        return "{{ScheduledTask {} rate: {}hz, fn: {}, overruns: {}}}".format(state, hz, self._forward_async_fn, self.overruns)
 
     __str__ = __repr__
 
@@ -180,6 +243,11 @@ class Scheduler:
         self._ready = []  # List of sleeping tasks ready to resume
         self._current = None  # The current task being executed
         self._debug = debug  # Debug flag
+        self._scheduled = []  # ScheduledTask instances started, for the admission test
+        self._utilisation_bound = None  # admission bound on the budgeted utilisation, None to admit every task
+        self._heartbeat = None  # liveness callback, see set_heartbeat
+        self._heartbeat_period_nanos = 0
+        self._next_heartbeat_nanos = 0
 
     @property
     def debug(self):
@@ -220,7 +288,35 @@ class Scheduler:
 
         self.add_task(_run_later(), priority)
 
-    def schedule(self, hz: float, coroutine_function, priority, *args, **kwargs):
+    def set_heartbeat(self, callback, period):
+        """
+        Calls callback every period seconds from the event loop, as long as it keeps stepping. A task blocking the
+        loop delays the heartbeat, it stops if the loop hangs.
+        """
+        self._heartbeat = callback
+        self._heartbeat_period_nanos = int(period * 1000000000)
+        self._next_heartbeat_nanos = 0
+
+    def set_utilisation_bound(self, bound):
+        """Sets the CPU fraction the budgets of the started tasks may reserve, None to admit every task."""
+        self._utilisation_bound = bound
+
+    def utilisation(self):
+        """Fraction of the CPU reserved by the budgets of the started tasks (critical ones over the bound included)."""
+        return sum(task.utilisation() for task in self._scheduled)
+
+    def schedule(
+        self,
+        hz: float,
+        coroutine_function,
+        priority,
+        *args,
+        budget=None,
+        deadline=None,
+        overrun=OverrunPolicy.SKIP,
+        critical=True,
+        **kwargs,
+    ):
         """
         Schedule a coroutine to run at a specified frequency.
 
@@ -234,15 +330,38 @@ class Scheduler:
         scheduled_task = get_loop().schedule(hz=100, coroutine_function=main_loop)
         get_loop().run()
 
+        Admission: with a budget and a utilisation bound set, the task is admitted if the budgeted utilisation of the
+        started tasks, this one included, stays within the bound. Otherwise task.admitted is False: a critical task
+        runs anyway, overcommitted, and falls back on its OverrunPolicy; any other task is returned stopped.
+
         :param hz: Frequency in Hz at which to run the coroutine.
         :param coroutine_function: The coroutine to schedule.
+        :param budget: Execution time budget [s] of one iteration, None to skip the admission test.
+        :param deadline: Deadline [s] of each iteration relative to its release, None for the period.
+        :param overrun: OverrunPolicy applied when the task falls behind its releases.
+        :param critical: Run the task even if its budget does not fit.
         """
         assert coroutine_function is not None, "coroutine function must not be none"
-        task = ScheduledTask(self, hz, coroutine_function, priority, args, kwargs)
-        task.start()
+        task = ScheduledTask(self, hz, coroutine_function, priority, args, kwargs, budget, deadline, overrun)
+        if budget is not None and self._utilisation_bound is not None:
+            task.admitted = self.utilisation() + task.utilisation() <= self._utilisation_bound
+        if task.admitted or critical:
+            self._scheduled.append(task)
+            task.start()
         return task
 
-    def schedule_later(self, hz: float, coroutine_function, priority, *args, **kwargs):
+    def schedule_later(
+        self,
+        hz: float,
+        coroutine_function,
+        priority,
+        *args,
+        budget=None,
+        deadline=None,
+        overrun=OverrunPolicy.SKIP,
+        critical=True,
+        **kwargs,
+    ):
         """
         Schedule a coroutine to start after an initial delay of one interval.
 
@@ -262,7 +381,7 @@ class Scheduler:
                 await _yield_once()
                 ran_once = True
 
-        return self.schedule(hz, call_later, priority)
+        return self.schedule(hz, call_later, priority, budget=budget, deadline=deadline, overrun=overrun, critical=critical)
 
     def run(self):
         """
@@ -301,6 +420,7 @@ class Scheduler:
         Executes one iteration of the event loop, managing tasks and sleep states.
         In order:
         - Sorts active tasks by priority and executes them.
+        - Calls the heartbeat when due.
         - Populates and sorts the "ready" list based on tasks that are due to run.
         - Runs ready tasks and removes them from the sleeping list.
         - If no active tasks remain, calculates sleep duration based on the earliest
@@ -328,6 +448,10 @@ class Scheduler:
         # Create the ready list by selecting tasks from _sleeping that are ready to run based on their resume time
         # Since _sleeping is kept sorted by resume time, we can optimize this
         now = _monotonic_ns()
+        if self._heartbeat is not None and now >= self._next_heartbeat_nanos:
+            self._next_heartbeat_nanos = now + self._heartbeat_period_nanos
+            self._heartbeat()
+
         self._ready = []
         cutoff_index = 0
 
@@ -0,0 +1,3 @@
+# Auto-generated from data_schema.yaml
+# Do not edit - changes will be overwritten by the build system.
+# One schema module per data process: cdh, eps, eps_warning, adcs, mag_cal, gps, comms, hal, mem, sched
@@ -0,0 +1,113 @@
+# Auto-generated from data_schema.yaml
+# Do not edit - changes will be overwritten by the build system.
+
+from micropython import const
+
+TAG = "adcs"
+FORMAT = "LBffffffBfffHHHHHHHHHBBBBBBffff"
+BYTESIZE = const(82)
+
+
+class ADCS_IDX:
+    TIME_ADCS = const(0)
+    MODE = const(1)
+    GYRO_X = const(2)
+    GYRO_Y = const(3)
+    GYRO_Z = const(4)
+    MAG_X = const(5)
+    MAG_Y = const(6)
+    MAG_Z = const(7)
+    SUN_STATUS = const(8)
+    SUN_VEC_X = const(9)
+    SUN_VEC_Y = const(10)
+    SUN_VEC_Z = const(11)
+    LIGHT_SENSOR_XP = const(12)
+    LIGHT_SENSOR_XM = const(13)
+    LIGHT_SENSOR_YP = const(14)
+    LIGHT_SENSOR_YM = const(15)
+    LIGHT_SENSOR_ZP_XP = const(16)
+    LIGHT_SENSOR_ZP_YM = const(17)
+    LIGHT_SENSOR_ZP_XM = const(18)
+    LIGHT_SENSOR_ZP_YP = const(19)
+    LIGHT_SENSOR_ZM = const(20)
+    XP_COIL_STATUS = const(21)
+    XM_COIL_STATUS = const(22)
+    YP_COIL_STATUS = const(23)
+    YM_COIL_STATUS = const(24)
+    ZP_COIL_STATUS = const(25)
+    ZM_COIL_STATUS = const(26)
+    ATTITUDE_QW = const(27)
+    ATTITUDE_QX = const(28)
+    ATTITUDE_QY = const(29)
+    ATTITUDE_QZ = const(30)
+
+
+# pack_into/unpack_from format of each field, in index order
+FIELD_FORMATS = (
+    "<L",
+    "<B",
+    "<f",
+    "<f",
+    "<f",
+    "<f",
+    "<f",
+    "<f",
+    "<B",
+    "<f",
+    "<f",
+    "<f",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<f",
+    "<f",
+    "<f",
+    "<f",
+)
+
+# Byte offset of each field in the record, in index order
+OFFSETS = (
+    0,
+    4,
+    5,
+    9,
+    13,
+    17,
+    21,
+    25,
+    29,
+    30,
+    34,
+    38,
+    42,
+    44,
+    46,
+    48,
+    50,
+    52,
+    54,
+    56,
+    58,
+    60,
+    61,
+    62,
+    63,
+    64,
+    65,
+    66,
+    70,
+    74,
+    78,
+)
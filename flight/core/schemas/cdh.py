@@ -0,0 +1,47 @@
+# Auto-generated from data_schema.yaml
+# Do not edit - changes will be overwritten by the build system.
+
+from micropython import const
+
+TAG = "cdh"
+FORMAT = "LLbLbbbbb"
+BYTESIZE = const(18)
+
+
+class CDH_IDX:
+    TIME = const(0)
+    BOOT_TIME = const(1)
+    SC_STATE = const(2)
+    SD_USAGE = const(3)
+    CURRENT_RAM_USAGE = const(4)
+    BOOT_COUNT = const(5)
+    WATCHDOG_TIMER = const(6)
+    HAL_BITFLAGS = const(7)
+    DETUMBLING_ERROR_FLAG = const(8)
+
+
+# pack_into/unpack_from format of each field, in index order
+FIELD_FORMATS = (
+    "<L",
+    "<L",
+    "<b",
+    "<L",
+    "<b",
+    "<b",
+    "<b",
+    "<b",
+    "<b",
+)
+
+# Byte offset of each field in the record, in index order
+OFFSETS = (
+    0,
+    4,
+    8,
+    9,
+    13,
+    14,
+    15,
+    16,
+    17,
+)
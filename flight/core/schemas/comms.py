@@ -0,0 +1,53 @@
+# Auto-generated from data_schema.yaml
+# Do not edit - changes will be overwritten by the build system.
+
+from micropython import const
+
+TAG = "comms"
+FORMAT = "HHHHHHHHHHe"
+BYTESIZE = const(22)
+
+
+class COMMS_IDX:
+    RX_PACKET_COUNT = const(0)
+    RX_DIGIPEATER_COUNT = const(1)
+    FAILED_UNPACK_COUNT = const(2)
+    CRC_ERROR_COUNT = const(3)
+    UNDEF_ERROR_COUNT = const(4)
+    PACKET_NONE_COUNT = const(5)
+    PACKET_AUTH_FAIL_COUNT = const(6)
+    TX_PACKET_COUNT = const(7)
+    TX_FAILED_COUNT = const(8)
+    TX_DIGIPEATER_COUNT = const(9)
+    RX_MESSAGE_RSSI = const(10)
+
+
+# pack_into/unpack_from format of each field, in index order
+FIELD_FORMATS = (
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<e",
+)
+
+# Byte offset of each field in the record, in index order
+OFFSETS = (
+    0,
+    2,
+    4,
+    6,
+    8,
+    10,
+    12,
+    14,
+    16,
+    18,
+    20,
+)
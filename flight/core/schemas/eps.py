@@ -0,0 +1,152 @@
+# Auto-generated from data_schema.yaml
+# Do not edit - changes will be overwritten by the build system.
+
+from micropython import const
+
+TAG = "eps"
+FORMAT = "LbhhhhhhhbhhhhLLhhhhhhhhhhhhhhhhhhhhhhhhhhbb"
+BYTESIZE = const(90)
+
+
+class EPS_IDX:
+    TIME_EPS = const(0)
+    EPS_POWER_FLAG = const(1)
+    MAINBOARD_TEMPERATURE = const(2)
+    MAINBOARD_VOLTAGE = const(3)
+    MAINBOARD_CURRENT = const(4)
+    BATTERY_PACK_TEMPERATURE = const(5)
+    BATTERY_PACK_TEMPERATURE_AIN1 = const(6)
+    BATTERY_PACK_TEMPERATURE_AIN2 = const(7)
+    BATTERY_PACK_TEMPERATURE_DIE = const(8)
+    BATTERY_PACK_REPORTED_SOC = const(9)
+    BATTERY_PACK_REPORTED_CAPACITY = const(10)
+    BATTERY_PACK_CURRENT = const(11)
+    BATTERY_PACK_VOLTAGE = const(12)
+    BATTERY_PACK_MIDPOINT_VOLTAGE = const(13)
+    BATTERY_PACK_TTE = const(14)
+    BATTERY_PACK_TTF = const(15)
+    XP_COIL_VOLTAGE = const(16)
+    XP_COIL_CURRENT = const(17)
+    XM_COIL_VOLTAGE = const(18)
+    XM_COIL_CURRENT = const(19)
+    YP_COIL_VOLTAGE = const(20)
+    YP_COIL_CURRENT = const(21)
+    YM_COIL_VOLTAGE = const(22)
+    YM_COIL_CURRENT = const(23)
+    ZP_COIL_VOLTAGE = const(24)
+    ZP_COIL_CURRENT = const(25)
+    ZM_COIL_VOLTAGE = const(26)
+    ZM_COIL_CURRENT = const(27)
+    JETSON_INPUT_VOLTAGE = const(28)
+    JETSON_INPUT_CURRENT = const(29)
+    RF_LDO_OUTPUT_VOLTAGE = const(30)
+    RF_LDO_OUTPUT_CURRENT = const(31)
+    GPS_VOLTAGE = const(32)
+    GPS_CURRENT = const(33)
+    XP_SOLAR_CHARGE_VOLTAGE = const(34)
+    XP_SOLAR_CHARGE_CURRENT = const(35)
+    XM_SOLAR_CHARGE_VOLTAGE = const(36)
+    XM_SOLAR_CHARGE_CURRENT = const(37)
+    YP_SOLAR_CHARGE_VOLTAGE = const(38)
+    YP_SOLAR_CHARGE_CURRENT = const(39)
+    YM_SOLAR_CHARGE_VOLTAGE = const(40)
+    YM_SOLAR_CHARGE_CURRENT = const(41)
+    BATTERY_HEATERS1_ENABLED = const(42)
+    BATTERY_HEATERS2_ENABLED = const(43)
+
+
+# pack_into/unpack_from format of each field, in index order
+FIELD_FORMATS = (
+    "<L",
+    "<b",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<b",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<L",
+    "<L",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<h",
+    "<b",
+    "<b",
+)
+
+# Byte offset of each field in the record, in index order
+OFFSETS = (
+    0,
+    4,
+    5,
+    7,
+    9,
+    11,
+    13,
+    15,
+    17,
+    19,
+    20,
+    22,
+    24,
+    26,
+    28,
+    32,
+    36,
+    38,
+    40,
+    42,
+    44,
+    46,
+    48,
+    50,
+    52,
+    54,
+    56,
+    58,
+    60,
+    62,
+    64,
+    66,
+    68,
+    70,
+    72,
+    74,
+    76,
+    78,
+    80,
+    82,
+    84,
+    86,
+    88,
+    89,
+)
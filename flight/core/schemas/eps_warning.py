@@ -0,0 +1,53 @@
+# Auto-generated from data_schema.yaml
+# Do not edit - changes will be overwritten by the build system.
+
+from micropython import const
+
+TAG = "eps_warning"
+FORMAT = "Lbbbbbbbbbb"
+BYTESIZE = const(14)
+
+
+class EPS_WARNING_IDX:
+    TIME_EPS_WARNING = const(0)
+    MAINBOARD_POWER_ALERT = const(1)
+    PERIPHERAL_POWER_ALERT = const(2)
+    RADIO_POWER_ALERT = const(3)
+    JETSON_POWER_ALERT = const(4)
+    XP_COIL_POWER_ALERT = const(5)
+    XM_COIL_POWER_ALERT = const(6)
+    YP_COIL_POWER_ALERT = const(7)
+    YM_COIL_POWER_ALERT = const(8)
+    ZP_COIL_POWER_ALERT = const(9)
+    ZM_COIL_POWER_ALERT = const(10)
+
+
+# pack_into/unpack_from format of each field, in index order
+FIELD_FORMATS = (
+    "<L",
+    "<b",
+    "<b",
+    "<b",
+    "<b",
+    "<b",
+    "<b",
+    "<b",
+    "<b",
+    "<b",
+    "<b",
+)
+
+# Byte offset of each field in the record, in index order
+OFFSETS = (
+    0,
+    4,
+    5,
+    6,
+    7,
+    8,
+    9,
+    10,
+    11,
+    12,
+    13,
+)
@@ -0,0 +1,74 @@
+# Auto-generated from data_schema.yaml
+# Do not edit - changes will be overwritten by the build system.
+
+from micropython import const
+
+TAG = "gps"
+FORMAT = "LBBIBHIHHHHHllllll"
+BYTESIZE = const(51)
+
+
+class GPS_IDX:
+    TIME_GPS = const(0)
+    GPS_MESSAGE_ID = const(1)
+    GPS_FIX_MODE = const(2)
+    GPS_LAST_FIX_TIME = const(3)
+    GPS_LAST_FIX_MODE = const(4)
+    GPS_GNSS_WEEK = const(5)
+    GPS_GNSS_TOW = const(6)
+    GPS_GDOP = const(7)
+    GPS_PDOP = const(8)
+    GPS_HDOP = const(9)
+    GPS_VDOP = const(10)
+    GPS_TDOP = const(11)
+    GPS_ECEF_X = const(12)
+    GPS_ECEF_Y = const(13)
+    GPS_ECEF_Z = const(14)
+    GPS_ECEF_VX = const(15)
+    GPS_ECEF_VY = const(16)
+    GPS_ECEF_VZ = const(17)
+
+
+# pack_into/unpack_from format of each field, in index order
+FIELD_FORMATS = (
+    "<L",
+    "<B",
+    "<B",
+    "<I",
+    "<B",
+    "<H",
+    "<I",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<l",
+    "<l",
+    "<l",
+    "<l",
+    "<l",
+    "<l",
+)
+
+# Byte offset of each field in the record, in index order
+OFFSETS = (
+    0,
+    4,
+    5,
+    6,
+    10,
+    11,
+    13,
+    17,
+    19,
+    21,
+    23,
+    25,
+    27,
+    31,
+    35,
+    39,
+    43,
+    47,
+)
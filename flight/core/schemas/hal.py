@@ -0,0 +1,206 @@
+# Auto-generated from data_schema.yaml
+# Do not edit - changes will be overwritten by the build system.
+
+from micropython import const
+
+TAG = "hal"
+FORMAT = "LBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB"
+BYTESIZE = const(65)
+
+
+class HAL_IDX:
+    TIME_HAL = const(0)
+    SDCARD_ERROR = const(1)
+    SDCARD_ERROR_COUNT = const(2)
+    RTC_ERROR = const(3)
+    RTC_ERROR_COUNT = const(4)
+    GPS_ERROR = const(5)
+    GPS_ERROR_COUNT = const(6)
+    RADIO_ERROR = const(7)
+    RADIO_ERROR_COUNT = const(8)
+    IMU_ERROR = const(9)
+    IMU_ERROR_COUNT = const(10)
+    FUEL_GAUGE_ERROR = const(11)
+    FUEL_GAUGE_ERROR_COUNT = const(12)
+    BATT_HEATERS_ERROR = const(13)
+    BATT_HEATERS_ERROR_COUNT = const(14)
+    WATCHDOG_ERROR = const(15)
+    WATCHDOG_ERROR_COUNT = const(16)
+    BURN_WIRES_ERROR = const(17)
+    BURN_WIRES_ERROR_COUNT = const(18)
+    BOARD_PWR_ERROR = const(19)
+    BOARD_PWR_ERROR_COUNT = const(20)
+    RADIO_PWR_ERROR = const(21)
+    RADIO_PWR_ERROR_COUNT = const(22)
+    GPS_PWR_ERROR = const(23)
+    GPS_PWR_ERROR_COUNT = const(24)
+    JETSON_PWR_ERROR = const(25)
+    JETSON_PWR_ERROR_COUNT = const(26)
+    TORQUE_XP_ERROR = const(27)
+    TORQUE_XP_ERROR_COUNT = const(28)
+    TORQUE_XM_ERROR = const(29)
+    TORQUE_XM_ERROR_COUNT = const(30)
+    TORQUE_YP_ERROR = const(31)
+    TORQUE_YP_ERROR_COUNT = const(32)
+    TORQUE_YM_ERROR = const(33)
+    TORQUE_YM_ERROR_COUNT = const(34)
+    TORQUE_ZP_ERROR = const(35)
+    TORQUE_ZP_ERROR_COUNT = const(36)
+    TORQUE_ZM_ERROR = const(37)
+    TORQUE_ZM_ERROR_COUNT = const(38)
+    LIGHT_XP_ERROR = const(39)
+    LIGHT_XP_ERROR_COUNT = const(40)
+    LIGHT_XM_ERROR = const(41)
+    LIGHT_XM_ERROR_COUNT = const(42)
+    LIGHT_YP_ERROR = const(43)
+    LIGHT_YP_ERROR_COUNT = const(44)
+    LIGHT_YM_ERROR = const(45)
+    LIGHT_YM_ERROR_COUNT = const(46)
+    LIGHT_ZM_ERROR = const(47)
+    LIGHT_ZM_ERROR_COUNT = const(48)
+    LIGHT_ZP_XP_ERROR = const(49)
+    LIGHT_ZP_XP_ERROR_COUNT = const(50)
+    LIGHT_ZP_YM_ERROR = const(51)
+    LIGHT_ZP_YM_ERROR_COUNT = const(52)
+    LIGHT_ZP_XM_ERROR = const(53)
+    LIGHT_ZP_XM_ERROR_COUNT = const(54)
+    LIGHT_ZP_YP_ERROR = const(55)
+    LIGHT_ZP_YP_ERROR_COUNT = const(56)
+    DEPLOYMENT_XP_ERROR = const(57)
+    DEPLOYMENT_XP_ERROR_COUNT = const(58)
+    DEPLOYMENT_YM_ERROR = const(59)
+    DEPLOYMENT_YM_ERROR_COUNT = const(60)
+    PERIPH_REBOOT_COUNT = const(61)
+
+
+# pack_into/unpack_from format of each field, in index order
+FIELD_FORMATS = (
+    "<L",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+    "<B",
+)
+
+# Byte offset of each field in the record, in index order
+OFFSETS = (
+    0,
+    4,
+    5,
+    6,
+    7,
+    8,
+    9,
+    10,
+    11,
+    12,
+    13,
+    14,
+    15,
+    16,
+    17,
+    18,
+    19,
+    20,
+    21,
+    22,
+    23,
+    24,
+    25,
+    26,
+    27,
+    28,
+    29,
+    30,
+    31,
+    32,
+    33,
+    34,
+    35,
+    36,
+    37,
+    38,
+    39,
+    40,
+    41,
+    42,
+    43,
+    44,
+    45,
+    46,
+    47,
+    48,
+    49,
+    50,
+    51,
+    52,
+    53,
+    54,
+    55,
+    56,
+    57,
+    58,
+    59,
+    60,
+    61,
+    62,
+    63,
+    64,
+)
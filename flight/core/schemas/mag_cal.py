@@ -0,0 +1,56 @@
+# Auto-generated from data_schema.yaml
+# Do not edit - changes will be overwritten by the build system.
+
+from micropython import const
+
+TAG = "mag_cal"
+FORMAT = "LHffffffffff"
+BYTESIZE = const(46)
+
+
+class MAG_CAL_IDX:
+    TIME_MAG_CAL = const(0)
+    SAMPLES = const(1)
+    OFFSET_X = const(2)
+    OFFSET_Y = const(3)
+    OFFSET_Z = const(4)
+    SOFT_IRON_XX = const(5)
+    SOFT_IRON_XY = const(6)
+    SOFT_IRON_XZ = const(7)
+    SOFT_IRON_YY = const(8)
+    SOFT_IRON_YZ = const(9)
+    SOFT_IRON_ZZ = const(10)
+    RESIDUAL = const(11)
+
+
+# pack_into/unpack_from format of each field, in index order
+FIELD_FORMATS = (
+    "<L",
+    "<H",
+    "<f",
+    "<f",
+    "<f",
+    "<f",
+    "<f",
+    "<f",
+    "<f",
+    "<f",
+    "<f",
+    "<f",
+)
+
+# Byte offset of each field in the record, in index order
+OFFSETS = (
+    0,
+    4,
+    6,
+    10,
+    14,
+    18,
+    22,
+    26,
+    30,
+    34,
+    38,
+    42,
+)
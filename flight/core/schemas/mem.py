@@ -0,0 +1,107 @@
+# Auto-generated from data_schema.yaml
+# Do not edit - changes will be overwritten by the build system.
+
+from micropython import const
+
+TAG = "mem"
+FORMAT = "LLLLHLLLLLLLLLLLLLLLLLLLLLLLL"
+BYTESIZE = const(114)
+
+
+class MEM_IDX:
+    TIME_MEM = const(0)
+    MEM_FREE = const(1)
+    MEM_ALLOC = const(2)
+    LARGEST_FREE_BLOCK = const(3)
+    GC_COUNT = const(4)
+    COMMAND_ALLOC_RATE = const(5)
+    COMMAND_ALLOC_PEAK = const(6)
+    WATCHDOG_ALLOC_RATE = const(7)
+    WATCHDOG_ALLOC_PEAK = const(8)
+    EPS_ALLOC_RATE = const(9)
+    EPS_ALLOC_PEAK = const(10)
+    OBDH_ALLOC_RATE = const(11)
+    OBDH_ALLOC_PEAK = const(12)
+    COMMS_ALLOC_RATE = const(13)
+    COMMS_ALLOC_PEAK = const(14)
+    ADCS_ALLOC_RATE = const(15)
+    ADCS_ALLOC_PEAK = const(16)
+    GPS_ALLOC_RATE = const(17)
+    GPS_ALLOC_PEAK = const(18)
+    PAYLOAD_ALLOC_RATE = const(19)
+    PAYLOAD_ALLOC_PEAK = const(20)
+    HAL_MONITOR_ALLOC_RATE = const(21)
+    HAL_MONITOR_ALLOC_PEAK = const(22)
+    DIGIPEATER_ALLOC_RATE = const(23)
+    DIGIPEATER_ALLOC_PEAK = const(24)
+    ADCS_GYRO_ALLOC_RATE = const(25)
+    ADCS_GYRO_ALLOC_PEAK = const(26)
+    ADCS_MAG_ALLOC_RATE = const(27)
+    ADCS_MAG_ALLOC_PEAK = const(28)
+
+
+# pack_into/unpack_from format of each field, in index order
+FIELD_FORMATS = (
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<H",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+    "<L",
+)
+
+# Byte offset of each field in the record, in index order
+OFFSETS = (
+    0,
+    4,
+    8,
+    12,
+    16,
+    18,
+    22,
+    26,
+    30,
+    34,
+    38,
+    42,
+    46,
+    50,
+    54,
+    58,
+    62,
+    66,
+    70,
+    74,
+    78,
+    82,
+    86,
+    90,
+    94,
+    98,
+    102,
+    106,
+    110,
+)
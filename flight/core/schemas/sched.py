@@ -0,0 +1,104 @@
+# Auto-generated from data_schema.yaml
+# Do not edit - changes will be overwritten by the build system.
+
+from micropython import const
+
+TAG = "sched"
+FORMAT = "LffBHHHHHHHHHHHHHHHHHHHHHHHH"
+BYTESIZE = const(61)
+
+
+class SCHED_IDX:
+    TIME_SCHED = const(0)
+    UTILISATION = const(1)
+    BUDGETED = const(2)
+    NOT_ADMITTED = const(3)
+    COMMAND_OVERRUNS = const(4)
+    COMMAND_SKIPPED = const(5)
+    WATCHDOG_OVERRUNS = const(6)
+    WATCHDOG_SKIPPED = const(7)
+    EPS_OVERRUNS = const(8)
+    EPS_SKIPPED = const(9)
+    OBDH_OVERRUNS = const(10)
+    OBDH_SKIPPED = const(11)
+    COMMS_OVERRUNS = const(12)
+    COMMS_SKIPPED = const(13)
+    ADCS_GYRO_OVERRUNS = const(14)
+    ADCS_GYRO_SKIPPED = const(15)
+    ADCS_MAG_OVERRUNS = const(16)
+    ADCS_MAG_SKIPPED = const(17)
+    ADCS_OVERRUNS = const(18)
+    ADCS_SKIPPED = const(19)
+    GPS_OVERRUNS = const(20)
+    GPS_SKIPPED = const(21)
+    PAYLOAD_OVERRUNS = const(22)
+    PAYLOAD_SKIPPED = const(23)
+    HAL_MONITOR_OVERRUNS = const(24)
+    HAL_MONITOR_SKIPPED = const(25)
+    DIGIPEATER_OVERRUNS = const(26)
+    DIGIPEATER_SKIPPED = const(27)
+
+
+# pack_into/unpack_from format of each field, in index order
+FIELD_FORMATS = (
+    "<L",
+    "<f",
+    "<f",
+    "<B",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+    "<H",
+)
+
+# Byte offset of each field in the record, in index order
+OFFSETS = (
+    0,
+    4,
+    8,
+    12,
+    13,
+    15,
+    17,
+    19,
+    21,
+    23,
+    25,
+    27,
+    29,
+    31,
+    33,
+    35,
+    37,
+    39,
+    41,
+    43,
+    45,
+    47,
+    49,
+    51,
+    53,
+    55,
+    57,
+    59,
+)
@@ -22,6 +22,17 @@ class StateManager:
         "__time_since_last_state_change",
         "__force_state",
         "__time_in_state",
+        "__state_rate_profiles",
+        "__activity_rate_profiles",
+        "__activities",
+        "__cpu_budget",
+        "__throttle",
+        "__task_rates",
+        "__last_govern_ns",
+        "__last_cpu_ns",
+        "__cpu_load",
+        "__task_load",
+        "__last_throttle_change_ns",
     )
 
     def __new__(cls, *args, **kwargs):
@@ -39,6 +50,17 @@ class StateManager:
         self.__time_since_last_state_change = 0
         self.__force_state = False
         self.__time_in_state = 0
+        self.__state_rate_profiles = {}
+        self.__activity_rate_profiles = {}
+        self.__activities = []
+        self.__cpu_budget = None
+        self.__throttle = {}  # task_id -> rate divisor applied by the CPU budget governor
+        self.__task_rates = {}  # task_id -> nominal rate for the current state and activities
+        self.__last_govern_ns = 0
+        self.__last_cpu_ns = {}  # task_id -> CPU time (run time minus blocking I/O) at the last governor call
+        self.__cpu_load = 0.0  # smoothed CPU utilisation
+        self.__task_load = {}  # task_id -> smoothed share of the CPU used by the task
+        self.__last_throttle_change_ns = 0
 
     @property
     def current_state(self):
@@ -48,6 +70,10 @@ class StateManager:
     def previous_state(self):
         return self.__previous_state
 
+    @property
+    def tasks(self):
+        return self.__tasks
+
     @property
     def scheduled_tasks(self):
         return self.__scheduled_tasks
@@ -64,9 +90,12 @@ class StateManager:
         :type start_state: STATES
         """
 
-        from core.task_configuration import TASK_CONFIG
+        from core.task_configuration import ACTIVITY_RATE_PROFILES, CPU_BUDGET, STATE_RATE_PROFILES, TASK_CONFIG
 
         self.__task_config = TASK_CONFIG
+        self.__state_rate_profiles = STATE_RATE_PROFILES
+        self.__activity_rate_profiles = ACTIVITY_RATE_PROFILES
+        self.__cpu_budget = CPU_BUDGET
         self.__states = [STATES.STARTUP, STATES.DETUMBLING, STATES.NOMINAL, STATES.LOW_POWER, STATES.EXPERIMENT]
 
         # init task objects
@@ -122,9 +151,17 @@ class StateManager:
         self.__time_since_last_state_change = time.monotonic()
         logger.info(f"Switched to state {new_state_id} - {STR_STATES[new_state_id]}")
 
+        self.apply_rate_profile()
+
     def schedule_tasks(self):
         self.__scheduled_tasks = {}  # Reset
 
+        # Admission of the task budgets against the CPU budget, tasks below "MinPriority" are critical and always run
+        if self.__cpu_budget is None:
+            scheduler.set_utilisation_bound(None)
+        else:
+            scheduler.set_utilisation_bound(self.__cpu_budget["Utilisation"])
+
         for task_id, task_params in self.__task_config.items():
             if "ScheduleLater" in task_params:
                 schedule = scheduler.schedule_later
@@ -136,7 +173,21 @@ class StateManager:
             task_fn = self.__tasks[task_id]._run
             self.__tasks[task_id].set_frequency(frequency)
 
-            self.__scheduled_tasks[task_id] = schedule(frequency, task_fn, priority)
+            self.__scheduled_tasks[task_id] = schedule(
+                frequency,
+                task_fn,
+                priority,
+                budget=task_params.get("Budget"),
+                deadline=task_params.get("Deadline"),
+                overrun=task_params.get("Overrun", scheduler.OverrunPolicy.SKIP),
+                critical=self.__cpu_budget is None or priority < self.__cpu_budget["MinPriority"],
+            )
+            if not self.__scheduled_tasks[task_id].admitted:
+                if priority < self.__cpu_budget["MinPriority"]:
+                    logger.warning(f"Task {task_id} budget does not fit the CPU budget, running overcommitted")
+                else:
+                    logger.warning(f"Task {task_id} budget does not fit the CPU budget, not started")
+                    continue
 
             if task_params.get("StartStopped", False):
                 self.__scheduled_tasks[task_id].stop()
@@ -157,9 +208,139 @@ class StateManager:
             print(task_name)
 
     def change_task_frequency(self, task_id, freq_hz):
-        """Changes the frequency of a task"""
-        self.__scheduled_tasks[task_id].change_rate(freq_hz)
+        """Changes the frequency of a task until the next state switch or activity change"""
+        self.__task_rates[task_id] = freq_hz
+        self.__set_task_rate(task_id)
         logger.info(f"Task {task_id} frequency changed to {freq_hz}")
+        self.__check_utilisation()
+
+    def set_activity(self, activity_id, active):
+        """Enables or disables an activity rate profile on top of the current state profile
+
+        Args:
+        :param activity_id: The activity to toggle
+        :type activity_id: ACTIVITY
+        :param active: True to apply the activity rate overrides
+        :type active: bool
+        """
+        if active == (activity_id in self.__activities):
+            return
+
+        if active:
+            self.__activities.append(activity_id)
+        else:
+            self.__activities.remove(activity_id)
+        self.apply_rate_profile()
+
+    def apply_rate_profile(self):
+        """Recomputes the nominal rate of every task from TASK_CONFIG, the current state and the active activities"""
+        if not self.__initialized:
+            return
+
+        state_profile = self.__state_rate_profiles.get(self.__current_state, {})
+        changed = False
+        for task_id, task_params in self.__task_config.items():
+            rate = state_profile.get(task_id, task_params["Frequency"])
+            for activity_id in self.__activities:
+                rate = self.__activity_rate_profiles.get(activity_id, {}).get(task_id, rate)
+
+            if self.__task_rates.get(task_id) != rate:
+                self.__task_rates[task_id] = rate
+                self.__set_task_rate(task_id)
+                changed = True
+
+        if changed:
+            self.__check_utilisation()
+
+    def __set_task_rate(self, task_id):
+        rate = self.__task_rates[task_id] / self.__throttle.get(task_id, 1)
+        if self.__tasks[task_id].frequency != rate:
+            self.__scheduled_tasks[task_id].change_rate(rate)
+            self.__tasks[task_id].set_frequency(rate)
+            logger.info(f"Task {task_id} running at {rate} Hz")
+
+    def utilisation(self):
+        """
+        CPU fraction the tasks need at their current rates, from the mean CPU time (blocking I/O excluded) per iteration
+        measured so far. Tasks that have not completed an iteration yet are not counted.
+        """
+        run_ns = 0
+        for task in self.__tasks.values():
+            if task.iterations and task.frequency:
+                run_ns += (task.run_time_ns - task.io_time_ns) * task.frequency / task.iterations
+        return run_ns / 1e9
+
+    def __check_utilisation(self):
+        """
+        Admission test after a rate change, on the configured budgets and on the measured run times. An overcommit is
+        logged only, the overrun policies of the tasks and the governor absorb it.
+        """
+        if self.__cpu_budget is None:
+            return
+        for name, utilisation in (("budgeted", scheduler.utilisation()), ("measured", self.utilisation())):
+            if utilisation > self.__cpu_budget["Utilisation"]:
+                logger.warning(f"Task rates overcommit the CPU budget: {name} {utilisation:.2f}")
+
+    def govern_cpu_budget(self):
+        """
+        CPU budget governor, call periodically.
+
+        Smooths the CPU time of the tasks measured since the last call over the elapsed time, blocking device I/O
+        excluded. Above the "Utilisation" threshold, the eligible task using the most CPU has its rate halved; below
+        "Restore", the highest priority throttled task is restored. Rates change at most once per "Dwell" seconds.
+        """
+        if self.__cpu_budget is None:
+            return
+
+        now_ns = time.monotonic_ns()
+        elapsed_ns = now_ns - self.__last_govern_ns
+        first_call = self.__last_govern_ns == 0
+        self.__last_govern_ns = now_ns
+
+        smoothing = self.__cpu_budget["Smoothing"]
+        busy_ns = 0
+        for task_id, task in self.__tasks.items():
+            cpu_ns = task.run_time_ns - task.io_time_ns
+            task_busy_ns = cpu_ns - self.__last_cpu_ns.get(task_id, cpu_ns)
+            self.__last_cpu_ns[task_id] = cpu_ns
+            busy_ns += task_busy_ns
+            if not first_call and elapsed_ns > 0:
+                load = self.__task_load.get(task_id, 0.0)
+                self.__task_load[task_id] = load + smoothing * (task_busy_ns / elapsed_ns - load)
+
+        if first_call or elapsed_ns <= 0:
+            self.__last_throttle_change_ns = now_ns
+            return
+
+        self.__cpu_load += smoothing * (busy_ns / elapsed_ns - self.__cpu_load)
+        utilisation = self.__cpu_load
+        if now_ns - self.__last_throttle_change_ns < self.__cpu_budget["Dwell"] * 1e9:
+            return
+
+        if utilisation > self.__cpu_budget["Utilisation"]:
+            # Among the tasks that can still be slowed down, the largest CPU user first, then the lowest priority
+            candidates = [
+                task_id
+                for task_id, task_params in self.__task_config.items()
+                if task_params["Priority"] >= self.__cpu_budget["MinPriority"]
+                and self.__throttle.get(task_id, 1) < self.__cpu_budget["MaxThrottle"]
+            ]
+            if candidates:
+                task_id = max(candidates, key=lambda t: (self.__task_load.get(t, 0.0), self.__task_config[t]["Priority"]))
+                self.__throttle[task_id] = self.__throttle.get(task_id, 1) * 2
+                self.__last_throttle_change_ns = now_ns
+                logger.warning(f"CPU utilisation {utilisation:.2f} over budget, throttling task {task_id}")
+                self.__set_task_rate(task_id)
+
+        elif utilisation < self.__cpu_budget["Restore"] and self.__throttle:
+            task_id = min(self.__throttle, key=lambda t: self.__task_config[t]["Priority"])
+            self.__throttle[task_id] //= 2
+            if self.__throttle[task_id] <= 1:
+                self.__throttle.pop(task_id)
+            self.__last_throttle_change_ns = now_ns
+            logger.info(f"CPU utilisation {utilisation:.2f} under budget, restoring task {task_id}")
+            self.__set_task_rate(task_id)
+            self.__check_utilisation()
 
     def start_forced_state(self, target_state_id, time_in_state):
         """Ensures that SWITCH_TO_STATE Command is enforced and maintains values to do so"""
@@ -36,6 +36,13 @@ class TASK:
     PAYLOAD = const(0x09)
     HAL_MONITOR = const(0x0A)
     DIGIPEATER = const(0x0B)
+    ADCS_GYRO = const(0x0C)
+    ADCS_MAG = const(0x0D)
+
+
+class ACTIVITY:
+    # Activities that span states and carry their own task rate overrides
+    PAYLOAD_DOWNLOAD = const(0x00)
 
 
 class STATES:
@@ -1,5 +1,8 @@
-from core.states import TASK
+from core.scheduler import OverrunPolicy
+from core.states import ACTIVITY, STATES, TASK
 from tasks.adcs import Task as adcs
+from tasks.adcs_gyro import Task as adcs_gyro
+from tasks.adcs_mag import Task as adcs_mag
 from tasks.command import Task as command
 from tasks.comms import Task as comms
 from tasks.digipeater import Task as digipeater
@@ -10,17 +13,71 @@ from tasks.obdh import Task as obdh
 from tasks.payload import Task as payload
 from tasks.watchdog import Task as watchdog
 
+# "Budget": allowance [s] for one iteration on the board, admitted by the scheduler against CPU_BUDGET "Utilisation"
+# at boot and checked again on every rate change. Compare with the measured UTILISATION of the sched record.
+# "Overrun": OverrunPolicy once the task falls behind its releases, "Deadline" [s] after the release defaults to the period
 TASK_CONFIG = {
-    TASK.COMMAND: {"Task": command, "Frequency": 2, "Priority": 2},
-    TASK.WATCHDOG: {"Task": watchdog, "Frequency": 1, "Priority": 1},
-    TASK.EPS: {"Task": eps, "Frequency": 5, "Priority": 2},
-    TASK.OBDH: {"Task": obdh, "Frequency": 0.5, "Priority": 2},
-    TASK.DIGIPEATER: {"Task": digipeater, "Frequency": 0.25, "Priority": 2, "ScheduleLater": True, "StartStopped": True},
-    TASK.COMMS: {"Task": comms, "Frequency": 1, "Priority": 2, "ScheduleLater": True},
-    TASK.ADCS: {"Task": adcs, "Frequency": 5, "Priority": 1},
-    TASK.GPS: {"Task": gps, "Frequency": 2, "Priority": 3, "ScheduleLater": True},  # GPS Nav data output = 1 Hz, other data is output as well < 1 Hz
-    TASK.PAYLOAD: {"Task": payload, "Frequency": 1, "Priority": 3, "ScheduleLater": True},
+    TASK.COMMAND: {"Task": command, "Frequency": 2, "Priority": 2, "Budget": 0.02, "Overrun": OverrunPolicy.SKIP},
+    TASK.WATCHDOG: {"Task": watchdog, "Frequency": 1, "Priority": 1, "Budget": 0.005, "Overrun": OverrunPolicy.CATCH_UP},
+    TASK.EPS: {"Task": eps, "Frequency": 5, "Priority": 2, "Budget": 0.03, "Overrun": OverrunPolicy.SKIP},
+    TASK.OBDH: {"Task": obdh, "Frequency": 0.5, "Priority": 2, "Budget": 0.1, "Overrun": OverrunPolicy.DEGRADE},
+    TASK.DIGIPEATER: {
+        "Task": digipeater,
+        "Frequency": 0.25,
+        "Priority": 2,
+        "Budget": 0.04,
+        "Overrun": OverrunPolicy.SKIP,
+        "ScheduleLater": True,
+        "StartStopped": True,
+    },
+    TASK.COMMS: {
+        "Task": comms,
+        "Frequency": 1,
+        "Priority": 2,
+        "Budget": 0.08,
+        "Overrun": OverrunPolicy.SKIP,
+        "ScheduleLater": True,
+    },
+    # ADCS loops: gyro and sun sensing, magnetometer sampling in a coil-off window, mode and actuation
+    TASK.ADCS_GYRO: {"Task": adcs_gyro, "Frequency": 10, "Priority": 1, "Budget": 0.012, "Overrun": OverrunPolicy.SKIP},
+    TASK.ADCS_MAG: {"Task": adcs_mag, "Frequency": 1, "Priority": 1, "Budget": 0.015, "Overrun": OverrunPolicy.SKIP},
+    # The actuation holds the coils on for most of the period, releases just missed are run rather than dropped
+    TASK.ADCS: {"Task": adcs, "Frequency": 5, "Priority": 1, "Budget": 0.015, "Overrun": OverrunPolicy.CATCH_UP},
+    # GPS Nav data output = 1 Hz, other data is output as well < 1 Hz
+    TASK.GPS: {
+        "Task": gps,
+        "Frequency": 2,
+        "Priority": 3,
+        "Budget": 0.02,
+        "Overrun": OverrunPolicy.DEGRADE,
+        "ScheduleLater": True,
+    },
+    TASK.PAYLOAD: {
+        "Task": payload,
+        "Frequency": 1,
+        "Priority": 3,
+        "Budget": 0.04,
+        "Overrun": OverrunPolicy.DEGRADE,
+        "ScheduleLater": True,
+    },
     # Watchdog needs to have priority over HAL monitor to ensure it is serviced
-    # HAL monitor can take too long on boot and cause watchdog resets
-    TASK.HAL_MONITOR: {"Task": hal_monitor, "Frequency": 5, "Priority": 2},
+    # HAL monitor can take too long on boot and cause watchdog resets, its budget covers the checks after boot
+    TASK.HAL_MONITOR: {"Task": hal_monitor, "Frequency": 5, "Priority": 2, "Budget": 0.03, "Overrun": OverrunPolicy.DEGRADE},
 }
+
+# Per-state rate overrides [Hz] applied by StateManager.switch_to, tasks not listed run at their TASK_CONFIG frequency
+STATE_RATE_PROFILES = {
+    STATES.DETUMBLING: {TASK.ADCS: 10, TASK.ADCS_MAG: 2},
+    STATES.LOW_POWER: {TASK.ADCS: 1, TASK.ADCS_GYRO: 1, TASK.EPS: 1, TASK.GPS: 1},
+}
+
+# Rate overrides [Hz] for activities spanning states, enabled with StateManager.set_activity, applied over the state profile
+ACTIVITY_RATE_PROFILES = {
+    ACTIVITY.PAYLOAD_DOWNLOAD: {TASK.HAL_MONITOR: 1},
+}
+
+# CPU budget governor, None to disable
+# The measured task utilisation (blocking I/O excluded) is smoothed with weight "Smoothing" for each new COMMAND cycle.
+# Above "Utilisation", tasks with priority >= "MinPriority" get their rate halved, largest CPU user first, down to
+# 1 / "MaxThrottle" of their nominal rate. Rates are restored below "Restore". Rates change at most every "Dwell" s.
+CPU_BUDGET = {"Utilisation": 0.8, "Restore": 0.4, "Smoothing": 0.2, "Dwell": 10, "MinPriority": 3, "MaxThrottle": 8}
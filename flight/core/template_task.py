@@ -1,7 +1,32 @@
 import gc
+import time
 import traceback
 
 from core import logger
+from core.scheduler import sleep
+
+
+class _CpuTimed:
+    """
+    Awaitable driving a coroutine and charging task.run_time_ns with the time spent between its resumption and its
+    next suspension only. The time the coroutine is suspended (sleeps, yields, other awaits) is not charged.
+    """
+
+    def __init__(self, task, coroutine):
+        self.task = task
+        self.coroutine = coroutine
+
+    def __await__(self):
+        coroutine = self.coroutine
+        while True:
+            start_ns = time.monotonic_ns()
+            try:
+                value = coroutine.send(None)
+            except StopIteration as e:
+                return e.value
+            finally:
+                self.task.run_time_ns += time.monotonic_ns() - start_ns
+            yield value
 
 
 class TemplateTask:
@@ -13,10 +38,19 @@ class TemplateTask:
         name:        Name of the task object.
     """
 
+    # Heap profiling of each _run cycle, enabled from main.py with main_config.MEM_PROFILE
+    mem_profile = False
+
     def __init__(self, id):
         self.ID = id
         self.name = "TASK"
         self.frequency = None
+        self.run_time_ns = 0  # cumulative time spent in _run, sampled by the CPU budget governor
+        self.iterations = 0  # completed _run cycles, run_time_ns / iterations is the mean cost of one
+        self.io_time_ns = 0  # part of run_time_ns spent waiting on blocking device I/O, see blocking_io
+        self.mem_alloc_bytes = 0  # cumulative heap allocated by main_task, sampled by the memory profile
+        self.mem_alloc_peak = 0  # largest heap allocation of a single main_task cycle
+        self.mem_gc_count = 0  # heap collections forced by the allocator while main_task was running
 
     def debug(self, msg, trace):
         """
@@ -50,11 +84,52 @@ class TemplateTask:
         """
         try:
             # gc.collect()
-            await self.main_task()
+            if self.mem_profile:
+                alloc_ref = gc.mem_alloc()
+                await _CpuTimed(self, self.main_task())
+                self.record_mem_alloc(gc.mem_alloc() - alloc_ref)
+            else:
+                await _CpuTimed(self, self.main_task())
+            start_ns = time.monotonic_ns()
             gc.collect()
+            self.run_time_ns += time.monotonic_ns() - start_ns
+            self.iterations += 1
         except Exception as e:
             self.debug(e, "".join(traceback.format_exception(e)))
 
+    async def sleep(self, seconds):
+        """
+        Suspends main_task for at least seconds, letting the other tasks run.
+        The suspended time is not charged to run_time_ns.
+        """
+        await sleep(seconds)
+
+    def blocking_io(self, fn, *args):
+        """
+        Calls fn(*args), a device call busy-waiting on the hardware (e.g. a radio transmission), and returns its result.
+        Its duration is charged to io_time_ns as well, the CPU budget governor does not count it as load.
+        """
+        start_ns = time.monotonic_ns()
+        try:
+            return fn(*args)
+        finally:
+            self.io_time_ns += time.monotonic_ns() - start_ns
+
+    def record_mem_alloc(self, allocated):
+        """
+        Accounts the heap allocated by one main_task cycle.
+
+        The heap is collected after every cycle, so a drop of gc.mem_alloc() over main_task means the allocator ran out
+        of free blocks and collected during the cycle. The cycle's allocation is then unknown and not accounted.
+        Tasks yielding inside main_task also get charged for what other tasks allocate meanwhile.
+        """
+        if allocated < 0:
+            self.mem_gc_count += 1
+            return
+        self.mem_alloc_bytes += allocated
+        if allocated > self.mem_alloc_peak:
+            self.mem_alloc_peak = allocated
+
     def log_debug(self, msg):
         """
         Log a debug message with the task name
@@ -33,6 +33,9 @@ import time
 from core.satellite_config import time_processor_config as CONFIG
 from hal.configuration import SATELLITE
 
+# The emulator time module provides settle(), which fast-boot mode turns into a no-op
+_settle = getattr(time, "settle", time.sleep)
+
 
 class TimeProcessor:
     """
@@ -128,3 +131,11 @@ class TimeProcessor:
     @classmethod
     def sleep(cls, seconds):
         time.sleep(seconds)
+
+    @classmethod
+    def settle(cls, seconds):
+        """
+        Hardware settle delay (e.g. between power sequencing steps).
+        Same as sleep on the board, skipped by the emulator in fast-boot mode.
+        """
+        _settle(seconds)
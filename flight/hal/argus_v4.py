@@ -8,6 +8,7 @@ import time
 import board
 import digitalio
 from busio import I2C, SPI, UART
+from core import logger
 from core.satellite_config import hal_config as CONFIG
 from hal.cubesat import ASIL0, ASIL1, ASIL2, ASIL3, ASIL4, CubeSat
 from hal.drivers.errors import Errors
@@ -33,7 +34,8 @@ class ArgusV4Power:
     Peripherlas 3.3V must be enabled before accessing I2C devices
     to ensure addresses are correct as we have different address configurations
     """
-    time.sleep(0.1)  # Wait for peripherals to power up
+    PERIPH_PWR_ON_NS = time.monotonic_ns()
+    PERIPH_PWR_SETTLE_MS = const(100)  # Peripherals power up time, waited out by the boot sequence
 
     # MAIN (MCU, WATCHDOG) 3.3V
     MAIN_PWR_RESET = digitalio.DigitalInOut(board.MAIN_PWR_RST)
@@ -71,23 +73,17 @@ class ArgusV4Interfaces:
     This class represents the interfaces used in the ArgusV4 module.
     """
 
+    # The I2C buses are pulled up by the peripherals line: they are created by the boot sequence once it has settled
+    # (ArgusV4.boot_sequence), so components refer to them by name
     I2C0_SDA = board.SDA0
     I2C0_SCL = board.SCL0
-
-    # Line may not be connected, try except sequence
-    try:
-        I2C0 = I2C(I2C0_SCL, I2C0_SDA, frequency=400000)
-    except Exception:
-        I2C0 = None
+    I2C0 = None
 
     I2C1_SDA = board.SDA1
     I2C1_SCL = board.SCL1
+    I2C1 = None
 
-    # Line may not be connected, try except sequence
-    try:
-        I2C1 = I2C(I2C1_SCL, I2C1_SDA, frequency=400000)
-    except Exception:
-        I2C1 = None
+    I2C_PINS = {"I2C0": (I2C0_SCL, I2C0_SDA), "I2C1": (I2C1_SCL, I2C1_SDA)}
 
     SPI0_SCK = board.CLK0
     SPI0_MOSI = board.MOSI0
@@ -132,47 +128,47 @@ class ArgusV4Components:
     ########
 
     # IMU
-    IMU_I2C = ArgusV4Interfaces.I2C0
+    IMU_I2C = "I2C0"
     IMU_I2C_ADDRESS = const(0x68)
 
     # XM TORQUE COILS
-    TORQUE_COILS_XM_I2C = ArgusV4Interfaces.I2C0
+    TORQUE_COILS_XM_I2C = "I2C0"
     TORQUE_XM_I2C_ADDRESS = const(0x30)
 
     # XM SOLAR CHARGING POWER MONITOR
-    SOLAR_CHARGING_XM_POWER_MONITOR_I2C = ArgusV4Interfaces.I2C0
+    SOLAR_CHARGING_XM_POWER_MONITOR_I2C = "I2C0"
     SOLAR_CHARGING_XM_POWER_MONITOR_I2C_ADDRESS = const(0x40)
 
     # XM LIGHT SENSOR
-    LIGHT_SENSOR_XM_I2C = ArgusV4Interfaces.I2C0
+    LIGHT_SENSOR_XM_I2C = "I2C0"
     LIGHT_SENSOR_XM_I2C_ADDRESS = const(0x44)
 
     # YM TORQUE COILS
-    TORQUE_COILS_YM_I2C = ArgusV4Interfaces.I2C0
+    TORQUE_COILS_YM_I2C = "I2C0"
     TORQUE_YM_I2C_ADDRESS = const(0x31)
 
     # YM SOLAR CHARGING POWER MONITOR
-    SOLAR_CHARGING_YM_POWER_MONITOR_I2C = ArgusV4Interfaces.I2C0
+    SOLAR_CHARGING_YM_POWER_MONITOR_I2C = "I2C0"
     SOLAR_CHARGING_YM_POWER_MONITOR_I2C_ADDRESS = const(0x41)
 
     # YM LIGHT SENSOR
-    LIGHT_SENSOR_YM_I2C = ArgusV4Interfaces.I2C0
+    LIGHT_SENSOR_YM_I2C = "I2C0"
     LIGHT_SENSOR_YM_I2C_ADDRESS = const(0x45)
 
     # YM DEPLOYMENT SENSOR
-    DEPLOYMENT_SENSOR_YM_I2C = ArgusV4Interfaces.I2C0
+    DEPLOYMENT_SENSOR_YM_I2C = "I2C0"
     DEPLOYMENT_SENSOR_YM_I2C_ADDRESS = const(0x29)
 
     # ZM TORQUE COILS
-    TORQUE_COILS_ZM_I2C = ArgusV4Interfaces.I2C0
+    TORQUE_COILS_ZM_I2C = "I2C0"
     TORQUE_ZM_I2C_ADDRESS = const(0x33)
 
     # ZM LIGHT SENSOR
-    LIGHT_SENSOR_ZM_I2C = ArgusV4Interfaces.I2C0
+    LIGHT_SENSOR_ZM_I2C = "I2C0"
     LIGHT_SENSOR_ZM_I2C_ADDRESS = const(0x46)
 
     # ZM BURN WIRE DRIVER
-    BURN_WIRE_I2C = ArgusV4Interfaces.I2C0
+    BURN_WIRE_I2C = "I2C0"
     BURN_WIRE_I2C_ADDRESS = const(0x60)
 
     ########
@@ -180,72 +176,72 @@ class ArgusV4Components:
     ########
 
     # BOARD POWER MONITOR
-    BOARD_POWER_MONITOR_I2C = ArgusV4Interfaces.I2C1
+    BOARD_POWER_MONITOR_I2C = "I2C1"
     BOARD_POWER_MONITOR_I2C_ADDRESS = const(0x40)
 
     # GPS POWER MONITOR
-    GPS_POWER_MONITOR_I2C = ArgusV4Interfaces.I2C1
+    GPS_POWER_MONITOR_I2C = "I2C1"
     GPS_POWER_MONITOR_I2C_ADDRESS = const(0x41)
 
     # LORA POWER MONITOR
-    RADIO_POWER_MONITOR_I2C = ArgusV4Interfaces.I2C1
+    RADIO_POWER_MONITOR_I2C = "I2C1"
     RADIO_POWER_MONITOR_I2C_ADDRESS = const(0x42)
 
     # RTC
-    RTC_I2C = ArgusV4Interfaces.I2C1
+    RTC_I2C = "I2C1"
     RTC_I2C_ADDRESS = const(0x68)
 
     # XP TORQUE COILS
-    TORQUE_COILS_XP_I2C = ArgusV4Interfaces.I2C1
+    TORQUE_COILS_XP_I2C = "I2C1"
     TORQUE_XP_I2C_ADDRESS = const(0x30)
 
     # XP SOLAR CHARGING POWER MONITOR
-    SOLAR_CHARGING_XP_POWER_MONITOR_I2C = ArgusV4Interfaces.I2C1
+    SOLAR_CHARGING_XP_POWER_MONITOR_I2C = "I2C1"
     SOLAR_CHARGING_XP_POWER_MONITOR_I2C_ADDRESS = const(0x48)
 
     # XP LIGHT SENSOR
-    LIGHT_SENSOR_XP_I2C = ArgusV4Interfaces.I2C1
+    LIGHT_SENSOR_XP_I2C = "I2C1"
     LIGHT_SENSOR_XP_I2C_ADDRESS = const(0x44)
 
     # XP DEPLOYMENT SENSOR
-    DEPLOYMENT_SENSOR_XP_I2C = ArgusV4Interfaces.I2C1
+    DEPLOYMENT_SENSOR_XP_I2C = "I2C1"
     DEPLOYMENT_SENSOR_XP_I2C_ADDRESS = const(0x29)
 
     # YP TORQUE COILS
-    TORQUE_COILS_YP_I2C = ArgusV4Interfaces.I2C1
+    TORQUE_COILS_YP_I2C = "I2C1"
     TORQUE_YP_I2C_ADDRESS = const(0x31)
 
     # YP SOLAR CHARGING POWER MONITOR
-    SOLAR_CHARGING_YP_POWER_MONITOR_I2C = ArgusV4Interfaces.I2C1
+    SOLAR_CHARGING_YP_POWER_MONITOR_I2C = "I2C1"
     SOLAR_CHARGING_YP_POWER_MONITOR_I2C_ADDRESS = const(0x4A)
 
     # YP LIGHT SENSOR
-    LIGHT_SENSOR_YP_I2C = ArgusV4Interfaces.I2C1
+    LIGHT_SENSOR_YP_I2C = "I2C1"
     LIGHT_SENSOR_YP_I2C_ADDRESS = const(0x45)
 
     # ZP TORQUE COILS
-    TORQUE_COILS_ZP_I2C = ArgusV4Interfaces.I2C1
+    TORQUE_COILS_ZP_I2C = "I2C1"
     TORQUE_ZP_I2C_ADDRESS = const(0x33)
 
     # ZP SOLAR CHARGING POWER MONITOR
-    SOLAR_CHARGING_ZP_POWER_MONITOR_I2C = ArgusV4Interfaces.I2C1
+    SOLAR_CHARGING_ZP_POWER_MONITOR_I2C = "I2C1"
     SOLAR_CHARGING_ZP_POWER_MONITOR_I2C_ADDRESS = const(0x49)
 
     # ZP SUN SENSOR
-    SUN_SENSOR_ZP_I2C = ArgusV4Interfaces.I2C1
+    SUN_SENSOR_ZP_I2C = "I2C1"
     SUN_SENSOR_ZP_XP_I2C_ADDRESS = const(0x54)
     SUN_SENSOR_ZP_YM_I2C_ADDRESS = const(0x55)
     SUN_SENSOR_ZP_XM_I2C_ADDRESS = const(0x56)
     SUN_SENSOR_ZP_YP_I2C_ADDRESS = const(0x57)
 
     # BATTERY BOARD FUEL GAUGE
-    FUEL_GAUGE_I2C = ArgusV4Interfaces.I2C1
+    FUEL_GAUGE_I2C = "I2C1"
     FUEL_GAUGE_I2C_ADDRESS_1 = const(0x36)
     FUEL_GAUGE_I2C_ADDRESS_2 = const(0x0B)
     FUEL_GAUGE_ALERT = board.BATT_ALRT
 
     # JETSON POWER MONITOR
-    JETSON_POWER_MONITOR_I2C = ArgusV4Interfaces.I2C1
+    JETSON_POWER_MONITOR_I2C = "I2C1"
     JETSON_POWER_MONITOR_I2C_ADDRESS = const(0x46)
 
     ########
@@ -314,7 +310,53 @@ class ArgusV4Components:
     # REACTION WHEEL
     RW_ENABLE = board.RW_EN
 
-    LIGHT_SENSOR_CONVERSION_TIME = 0b0000
+    # All light sensors convert continuously with the same 100 ms conversion time, so the 4-bit result counter
+    # advances by less than 16 between two ADCS reads (1 to 10 Hz) and an unchanged counter means a stale result
+    LIGHT_SENSOR_CONVERSION_TIME = 0b1000
+    LIGHT_SENSOR_OPERATING_MODE = 0b11
+
+
+class ArgusV4Boot:
+    """
+    Boot dependencies of the devices: power line -> bus -> device.
+
+    Devices on the peripherals line wait for it to settle (ArgusV4Power.PERIPH_PWR_SETTLE_MS), and so do the I2C
+    buses it pulls up. Devices boot as soon as their dependencies are ready, in device list order.
+    """
+
+    DEVICE_BUS = {
+        "NEOPIXEL": None,
+        "SDCARD": "SPI1",
+        "RTC": ArgusV4Components.RTC_I2C,
+        "GPS": "UART0",
+        "RADIO": "SPI0",
+        "IMU": ArgusV4Components.IMU_I2C,
+        "FUEL_GAUGE": ArgusV4Components.FUEL_GAUGE_I2C,
+        "BATT_HEATERS": None,
+        "WATCHDOG": None,
+        "BURN_WIRES": ArgusV4Components.BURN_WIRE_I2C,
+        "BOARD_PWR": ArgusV4Components.BOARD_POWER_MONITOR_I2C,
+        "RADIO_PWR": ArgusV4Components.RADIO_POWER_MONITOR_I2C,
+        "GPS_PWR": ArgusV4Components.GPS_POWER_MONITOR_I2C,
+        "JETSON_PWR": ArgusV4Components.JETSON_POWER_MONITOR_I2C,
+        "TORQUE_XP": ArgusV4Components.TORQUE_COILS_XP_I2C,
+        "TORQUE_XM": ArgusV4Components.TORQUE_COILS_XM_I2C,
+        "TORQUE_YP": ArgusV4Components.TORQUE_COILS_YP_I2C,
+        "TORQUE_YM": ArgusV4Components.TORQUE_COILS_YM_I2C,
+        "TORQUE_ZP": ArgusV4Components.TORQUE_COILS_ZP_I2C,
+        "TORQUE_ZM": ArgusV4Components.TORQUE_COILS_ZM_I2C,
+        "LIGHT_XP": ArgusV4Components.LIGHT_SENSOR_XP_I2C,
+        "LIGHT_XM": ArgusV4Components.LIGHT_SENSOR_XM_I2C,
+        "LIGHT_YP": ArgusV4Components.LIGHT_SENSOR_YP_I2C,
+        "LIGHT_YM": ArgusV4Components.LIGHT_SENSOR_YM_I2C,
+        "LIGHT_ZM": ArgusV4Components.LIGHT_SENSOR_ZM_I2C,
+        "LIGHT_ZP_XP": ArgusV4Components.SUN_SENSOR_ZP_I2C,
+        "LIGHT_ZP_YM": ArgusV4Components.SUN_SENSOR_ZP_I2C,
+        "LIGHT_ZP_XM": ArgusV4Components.SUN_SENSOR_ZP_I2C,
+        "LIGHT_ZP_YP": ArgusV4Components.SUN_SENSOR_ZP_I2C,
+        "DEPLOYMENT_XP": ArgusV4Components.DEPLOYMENT_SENSOR_XP_I2C,
+        "DEPLOYMENT_YM": ArgusV4Components.DEPLOYMENT_SENSOR_YM_I2C,
+    }
 
 
 class ArgusV4(CubeSat):
@@ -332,20 +374,107 @@ class ArgusV4(CubeSat):
 
     ######################## BOOT SEQUENCE ########################
 
-    def __boot_device(self, name: str, device: object):
-        func = device.boot_fn
-        device.device, device.error = func(name)
+    def __finish_boot(self, device: object, result: list):
+        device.device, device.error = result
         if device.error == Errors.NO_ERROR and device.device is not None:
             device.device = objectWrapper(device.device)
 
+    def __boot_device(self, name: str, device: object):
+        """Boots a device in one go, sleeping through the settle times of its init phases."""
+        boot = device.boot_fn(name)
+        while not isinstance(boot, list):
+            try:
+                time.sleep(next(boot) / 1000)
+            except StopIteration as e:
+                boot = e.args[0]
+        self.__finish_boot(device, boot)
+
+    def __boot_bus(self, bus: str):
+        scl, sda = ArgusV4Interfaces.I2C_PINS[bus]
+        # Line may not be connected, try except sequence
+        try:
+            setattr(ArgusV4Interfaces, bus, I2C(scl, sda, frequency=400000))
+        except Exception:
+            setattr(ArgusV4Interfaces, bus, None)
+
+    def __boot_phase(self, name: str, boot: object, settling: list, log):
+        """
+        Runs the next init phase of a device. Boot functions returning a generator yield the settle time [ms]
+        after each phase: the device is then parked in settling until its deadline.
+        """
+        if not isinstance(boot, list):
+            try:
+                settle_ms = next(boot)
+                settling.append([time.monotonic_ns() + settle_ms * 1000000, name, boot])
+                log(name, f"settling {settle_ms} ms")
+                return
+            except StopIteration as e:
+                boot = e.args[0]
+        device = self.__device_list[name]
+        self.__finish_boot(device, boot)
+        log(name, "up" if device.error == Errors.NO_ERROR else f"error {device.error}")
+
     def boot_sequence(self):
-        """boot_sequence: Boot sequence for the CubeSat."""
+        """boot_sequence: Boot sequence for the CubeSat.
+
+        Devices boot as soon as their power line has settled and their bus is up (ArgusV4Boot), so the devices off the
+        peripherals line boot while it settles, and other devices keep booting while one waits out the settle time
+        of an init phase. The boot timeline is logged at the end.
+        """
+        start_ns = time.monotonic_ns()
+        periph_ready_ns = ArgusV4Power.PERIPH_PWR_ON_NS + ArgusV4Power.PERIPH_PWR_SETTLE_MS * 1000000
+        buses_up = False
+        timeline = []
+
+        def log(name, event):
+            timeline.append(((time.monotonic_ns() - start_ns) // 1000000, name, event))
 
+        pending = []
         for name, device in self.__device_list.items():
             if device.ASIL != ASIL0 or CONFIG.ASIL0_EN:
-                self.__boot_device(name, device)
+                pending.append(name)
             else:
                 print(f"Skipping boot for {name} as it is ASIL0")
+        settling = []  # [deadline_ns, name, init phases] of the devices waiting out a settle time
+
+        while pending or settling:
+            now = time.monotonic_ns()
+
+            if not buses_up and now >= periph_ready_ns:
+                for bus in ArgusV4Interfaces.I2C_PINS:
+                    self.__boot_bus(bus)
+                    log(bus, "up" if getattr(ArgusV4Interfaces, bus) is not None else "not connected")
+                buses_up = True
+
+            ready = None
+            for entry in settling:
+                if now >= entry[0]:
+                    ready = entry
+                    break
+            if ready is not None:
+                settling.remove(ready)
+                self.__boot_phase(ready[1], ready[2], settling, log)
+                continue
+
+            for name in pending:
+                bus = ArgusV4Boot.DEVICE_BUS.get(name)
+                if buses_up or not (self.__device_list[name].peripheral_line or bus in ArgusV4Interfaces.I2C_PINS):
+                    ready = name
+                    break
+            if ready is not None:
+                pending.remove(ready)
+                log(ready, "boot")
+                self.__boot_phase(ready, self.__device_list[ready].boot_fn(ready), settling, log)
+                continue
+
+            # Nothing to do until the next settle deadline
+            wake_ns = min([entry[0] for entry in settling] + ([periph_ready_ns] if not buses_up else []))
+            if wake_ns > now:
+                time.sleep((wake_ns - now) / 1000000000)
+
+        for t_ms, name, event in timeline:
+            logger.info(f"[BOOT] {t_ms:>5} ms {name} {event}")
+        logger.info(f"[BOOT] Boot sequence done in {(time.monotonic_ns() - start_ns) // 1000000} ms")
 
     def __gps_boot(self, _) -> list[object, int]:
         """GPS_boot: Boot sequence for the GPS
@@ -386,7 +515,7 @@ class ArgusV4(CubeSat):
         data = locations[location]
         try:
             address = data[0]
-            bus = data[1]
+            bus = getattr(ArgusV4Interfaces, data[1])
             power_monitor = ADM1176(bus, address)
 
             return [power_monitor, Errors.NO_ERROR]
@@ -397,7 +526,7 @@ class ArgusV4(CubeSat):
             return [None, Errors.DEVICE_NOT_INITIALISED]
 
     def __imu_boot(self, _) -> list[object, int]:
-        """imu_boot: Boot sequence for the IMU
+        """imu_boot: Boot sequence for the IMU, yielding the magnetometer warm up time between init phases
 
         :return: Error code if the IMU failed to initialize
         """
@@ -408,9 +537,15 @@ class ArgusV4(CubeSat):
             from hal.drivers.bmx160 import BMX160
 
             imu = BMX160(
-                ArgusV4Components.IMU_I2C,
+                getattr(ArgusV4Interfaces, ArgusV4Components.IMU_I2C),
                 ArgusV4Components.IMU_I2C_ADDRESS,
+                init_sensors=False,
             )
+            imu.init_mag(warmup=False)
+            yield BMX160.MAG_WARMUP_MS
+            imu.init_accel()
+            imu.init_gyro()
+            imu.init_fifo()
 
             return [imu, Errors.NO_ERROR]
         except Exception as e:
@@ -437,7 +572,7 @@ class ArgusV4(CubeSat):
 
         try:
             address = data[0]
-            bus = data[1]
+            bus = getattr(ArgusV4Interfaces, data[1])
             torque_driver = DRV8235(bus, address)
 
             return [torque_driver, Errors.NO_ERROR]
@@ -470,11 +605,12 @@ class ArgusV4(CubeSat):
 
         try:
             address = data[0]
-            bus = data[1]
+            bus = getattr(ArgusV4Interfaces, data[1])
             light_sensor = OPT4003(
                 bus,
                 address,
                 conversion_time=ArgusV4Components.LIGHT_SENSOR_CONVERSION_TIME,
+                operating_mode=ArgusV4Components.LIGHT_SENSOR_OPERATING_MODE,
             )
             return [light_sensor, Errors.NO_ERROR]
 
@@ -538,7 +674,7 @@ class ArgusV4(CubeSat):
         from hal.drivers.ds3231 import DS3231
 
         try:
-            rtc = DS3231(ArgusV4Components.RTC_I2C, ArgusV4Components.RTC_I2C_ADDRESS)
+            rtc = DS3231(getattr(ArgusV4Interfaces, ArgusV4Components.RTC_I2C), ArgusV4Components.RTC_I2C_ADDRESS)
             return [rtc, Errors.NO_ERROR]
         except Exception as e:
             if self.__debug:
@@ -572,7 +708,7 @@ class ArgusV4(CubeSat):
 
         try:
             burn_wires = PCA9633(
-                ArgusV4Components.BURN_WIRE_I2C,
+                getattr(ArgusV4Interfaces, ArgusV4Components.BURN_WIRE_I2C),
                 ArgusV4Components.BURN_WIRE_I2C_ADDRESS,
             )
             return [burn_wires, Errors.NO_ERROR]
@@ -589,7 +725,7 @@ class ArgusV4(CubeSat):
 
         try:
             fuel_gauge = MAX17205(
-                ArgusV4Components.FUEL_GAUGE_I2C,
+                getattr(ArgusV4Interfaces, ArgusV4Components.FUEL_GAUGE_I2C),
                 ArgusV4Components.FUEL_GAUGE_I2C_ADDRESS_1,
                 ArgusV4Components.FUEL_GAUGE_I2C_ADDRESS_2,
             )
@@ -664,7 +800,7 @@ class ArgusV4(CubeSat):
         data = directions[direction]
 
         try:
-            bus = data[0]
+            bus = getattr(ArgusV4Interfaces, data[0])
             address = data[1]
             deployment_sensor = VL53L4CD(bus, address)
             deployment_sensor.timing_budget = 10
@@ -1,8 +1,10 @@
 import time
+from array import array
 from collections import OrderedDict
 
 import microcontroller
 from hal.drivers.errors import Errors
+from hal.drivers.opt4001 import decode_results
 from hal.drivers.stateflags import StateFlags
 from micropython import const
 
@@ -13,6 +15,11 @@ ASIL2 = const(2)
 ASIL3 = const(3)
 ASIL4 = const(4)
 
+# Latest result registers and lux per ADC code of each light sensor, for READ_LIGHT_SENSORS
+_MAX_LIGHT_SENSORS = const(9)
+_light_results = bytearray(4 * _MAX_LIGHT_SENSORS)
+_light_lux_per_code = array("f", [0.0] * _MAX_LIGHT_SENSORS)
+
 
 class Device:
     def __init__(
@@ -341,6 +348,13 @@ class CubeSat:
         if self.TORQUE_DRIVERS_AVAILABLE(dir):
             self.__device_list["TORQUE_" + dir].device.set_throttle(throttle)
 
+    def APPLY_MAGNETIC_CONTROLS(self, dirs: list, throttles) -> None:
+        """Applies throttles[i] to the coil of dirs[i] for all coils in one update, skipping the unavailable ones.
+        The drivers only write the registers whose value changes."""
+        for i, dir in enumerate(dirs):
+            if self.TORQUE_DRIVERS_AVAILABLE(dir):
+                self.__device_list["TORQUE_" + dir].device.set_throttle(throttles[i])
+
     @property
     def FUEL_GAUGE(self):
         """FUEL_GAUGE: Returns the fuel gauge object
@@ -382,6 +396,28 @@ class CubeSat:
             and not self.__device_list["LIGHT_" + dir].temp_disabled
         )
 
+    def READ_LIGHT_SENSORS(self, faces: tuple, lux: array, counters: bytearray) -> int:
+        """Reads the latest result of the light sensor of each face, one I2C burst per sensor without waiting for a
+        conversion, and decodes the whole array in one decode_results call.
+
+        :param faces: The direction keys, at most 9 (e.g., 'XP', 'XM', etc.)
+        :param lux: array('f') of 9, lux of each face, written
+        :param counters: bytearray of 9, conversion counter of each face, written
+        :return: int - bitmask of the faces read with a matching CRC. Unavailable sensors and failed reads are unset.
+        """
+        read = 0
+        for i, face in enumerate(faces):
+            if self.LIGHT_SENSOR_AVAILABLE(face):
+                sensor = self.__device_list["LIGHT_" + face].device
+                try:
+                    sensor.read_result_into(_light_results, i << 2)
+                except RuntimeError:
+                    # Flagged on the device by its objectWrapper for hal_monitor
+                    continue
+                _light_lux_per_code[i] = sensor.lux_per_code
+                read |= 1 << i
+        return decode_results(_light_results, _light_lux_per_code, lux, counters) & read
+
     @property
     def RTC(self):
         """RTC: Returns the RTC object
@@ -6,13 +6,15 @@ from adafruit_register.i2c_bits import ROBits, RWBits
 from adafruit_register.i2c_struct import Struct
 from hal.drivers.errors import Errors
 from micropython import const
-from ulab.numpy import pi
+from ulab.numpy import frombuffer, int16, mean, pi
 
 # Chip ID
 _BMX160_CHIP_ID = const(0xD8)
 
 # Soft reset command
 _BMX160_SOFT_RESET_CMD = const(0xB6)
+# FIFO flush command
+_BMX160_FIFO_FLUSH_CMD = const(0xB0)
 # _BMX160_SOFT_RESET_DELAY    = 0.001
 
 # Command
@@ -29,8 +31,8 @@ _BMX160_ACCEL_DATA_ADDR = const(0x12)
 _BMX160_STATUS_ADDR = const(0x1B)
 # _BMX160_INT_STATUS_ADDR = const(0x1C)
 _BMX160_TEMP_DATA_ADDR = const(0x20)
-# _BMX160_FIFO_LENGTH_ADDR = const(0x22)
-# _BMX160_FIFO_DATA_ADDR = const(0x24)
+_BMX160_FIFO_LENGTH_ADDR = const(0x22)
+_BMX160_FIFO_DATA_ADDR = const(0x24)
 _BMX160_ACCEL_CONFIG_ADDR = const(0x40)
 _BMX160_ACCEL_RANGE_ADDR = const(0x41)
 _BMX160_GYRO_CONFIG_ADDR = const(0x42)
@@ -38,7 +40,7 @@ _BMX160_GYRO_RANGE_ADDR = const(0x43)
 _BMX160_MAG_ODR_ADDR = const(0x44)
 # _BMX160_FIFO_DOWN_ADDR = const(0x45)
 # _BMX160_FIFO_CONFIG_0_ADDR = const(0x46)
-# _BMX160_FIFO_CONFIG_1_ADDR = const(0x47)
+_BMX160_FIFO_CONFIG_1_ADDR = const(0x47)
 # _BMX160_MAG_IF_0_ADDR       = const(0x4B)
 _BMX160_MAG_IF_0_ADDR = const(0x4C)
 _BMX160_MAG_IF_1_ADDR = const(0x4D)
@@ -223,8 +225,9 @@ _BMX160_GYRO_ODR_CONSTANTS = [
     _BMX160_GYRO_ODR_200HZ,
     _BMX160_GYRO_ODR_100HZ,
     _BMX160_GYRO_ODR_50HZ,
+    _BMX160_GYRO_ODR_25HZ,
 ]
-_BMX160_GYRO_ODR_VALUES = [3200, 1600, 800, 400, 200, 100, 50]
+_BMX160_GYRO_ODR_VALUES = [1600, 800, 400, 200, 100, 50, 25]
 
 # Auxiliary sensor Output data rate
 # _BMX160_MAG_ODR_RESERVED              = const(0x00)
@@ -240,13 +243,25 @@ _BMX160_MAG_ODR_25HZ = const(0x06)
 # _BMX160_MAG_ODR_400HZ = const(0x0A)
 # _BMX160_MAG_ODR_800HZ = const(0x0B)
 
+# ODR field of GYRO_CONF and MAG_CONF, same encoding for both sensors
+_BMX160_ODR_MASK = const(0x0F)
+
 # Accel, gyro and aux. sensor length and also their combined length definitions in FIFO
 # _BMX160_FIFO_G_LENGTH = const(6)
 # _BMX160_FIFO_A_LENGTH = const(6)
 # _BMX160_FIFO_M_LENGTH = const(8)
 # _BMX160_FIFO_GA_LENGTH = const(12)
 # _BMX160_FIFO_MA_LENGTH = const(14)
-# _BMX160_FIFO_MG_LENGTH = const(14)
+_BMX160_FIFO_MG_LENGTH = const(14)
+
+# FIFO_CONFIG_1 enable bits (headerless mode, see section 2.11.21)
+_BMX160_FIFO_GYRO_EN = const(0x80)
+_BMX160_FIFO_MAG_EN = const(0x20)
+
+# FIFO capacity (1024 bytes) rounded down to whole mag+gyro frames
+_BMX160_FIFO_MAX_FRAMES = const(73)
+# int16 words per mag+gyro frame: mag x,y,z, rhall, gyro x,y,z
+_BMX160_FIFO_FRAME_WORDS = const(7)
 # _BMX160_FIFO_MGA_LENGTH = const(20)
 
 # I2C address
@@ -372,6 +387,11 @@ class BMX160:
 
     _BUFFER = bytearray(40)
     _smallbuf = bytearray(6)
+    _FIFO_BUFFER = bytearray(_BMX160_FIFO_MAX_FRAMES * _BMX160_FIFO_MG_LENGTH)
+
+    # Decoded view over _FIFO_BUFFER holding the frames of the last drain
+    _fifo_window = None
+    fifo_frames = 0
 
     _gyro_range = RWBits(8, _BMX160_GYRO_RANGE_ADDR, 0)
     _accel_range = RWBits(8, _BMX160_ACCEL_RANGE_ADDR, 0)
@@ -389,7 +409,9 @@ class BMX160:
     _mag_odr = 25  # Hz
     _mag_range = 250  # deg/sec
 
-    def __init__(self, i2c, i2c_addr):
+    MAG_WARMUP_MS = 100  # takes this long to warm up (empirically)
+
+    def __init__(self, i2c, i2c_addr, init_sensors=True):
         self.i2c_device = I2CDevice(i2c, i2c_addr, probe=False)
         # soft reset & reboot
         self.cmd = _BMX160_SOFT_RESET_CMD
@@ -400,10 +422,13 @@ class BMX160:
             raise RuntimeError("Could not find BMX160, check wiring!")
 
         # print("status:", format_binary(self.status))
-        # set the default settings
-        self.init_mag()
-        self.init_accel()
-        self.init_gyro()
+        # set the default settings, or let the caller run the init steps (e.g. to boot other devices during the
+        # magnetometer warm up)
+        if init_sensors:
+            self.init_mag()
+            self.init_accel()
+            self.init_gyro()
+            self.init_fifo()
         # print("status:", format_binary(self.status))
 
     ######################## SENSOR API ########################
@@ -445,6 +470,65 @@ class BMX160:
         t *= 0.000039  # the time resolution is 39 microseconds
         return t
 
+    ######################## FIFO ########################
+
+    def init_fifo(self):
+        """
+        Stream mag and gyro frames into the hardware FIFO in headerless mode.
+        Headerless mode requires both sensors to run at the same ODR (25 Hz, set by init_mag and init_gyro),
+        so every frame is 14 bytes: mag x,y,z, rhall, gyro x,y,z (int16, little-endian).
+        """
+        # With different ODRs the FIFO would interleave partial frames and drain_fifo would decode a mixed stream
+        gyro_odr = self.read_u8(_BMX160_GYRO_CONFIG_ADDR) & _BMX160_ODR_MASK
+        mag_odr = self.read_u8(_BMX160_MAG_ODR_ADDR) & _BMX160_ODR_MASK
+        if gyro_odr != mag_odr:
+            raise RuntimeError("BMX160 FIFO needs the gyro and mag at the same ODR")
+
+        self.write_u8(_BMX160_FIFO_CONFIG_1_ADDR, _BMX160_FIFO_GYRO_EN | _BMX160_FIFO_MAG_EN)
+        self.fifo_flush()
+
+    def fifo_flush(self):
+        self.write_u8(_BMX160_COMMAND_REG_ADDR, _BMX160_FIFO_FLUSH_CMD)
+        self.fifo_frames = 0
+
+    def fifo_length(self):
+        # FIFO fill level in bytes (11-bit counter)
+        lbuf = self.read_bytes(_BMX160_FIFO_LENGTH_ADDR, 2, self._smallbuf)
+        return ((lbuf[1] & 0x07) << 8) | lbuf[0]
+
+    def drain_fifo(self, max_frames=_BMX160_FIFO_MAX_FRAMES):
+        """
+        Drain every complete frame from the FIFO with a single burst read into a preallocated buffer.
+
+        The FIFO is always emptied, but only the newest `max_frames` frames are kept in the window
+        so that a long gap between drains (e.g. LOW_POWER) does not average stale samples.
+        Returns the number of frames in the window.
+        """
+        n_frames = min(self.fifo_length() // _BMX160_FIFO_MG_LENGTH, _BMX160_FIFO_MAX_FRAMES)
+        if n_frames == 0:
+            self.fifo_frames = 0
+            return 0
+
+        with self.i2c_device as i2c:
+            self._BUFFER[0] = _BMX160_FIFO_DATA_ADDR
+            i2c.write_then_readinto(self._BUFFER, self._FIFO_BUFFER, out_end=1, in_end=n_frames * _BMX160_FIFO_MG_LENGTH)
+
+        frames = frombuffer(self._FIFO_BUFFER, dtype=int16, count=n_frames * _BMX160_FIFO_FRAME_WORDS)
+        frames = frames.reshape((n_frames, _BMX160_FIFO_FRAME_WORDS))
+
+        keep = min(n_frames, max_frames)
+        self._fifo_window = frames[n_frames - keep :, :]
+        self.fifo_frames = keep
+        return keep
+
+    def fifo_gyro(self):
+        # rad/s, mean over the last drained window
+        return mean(self._fifo_window[:, 4:7], axis=0) * self.GYR_SCALAR
+
+    def fifo_mag(self):
+        # uT, mean over the last drained window
+        return mean(self._fifo_window[:, 0:3], axis=0) * self.MAG_SCALAR
+
     ######################## SETTINGS RELATED ########################
 
     ############## GYROSCOPE SETTINGS  ##############
@@ -500,8 +584,8 @@ class BMX160:
     def gyro_odr(self, odr):
         """
         Set the output data rate of the gyroscope. The possible ODRs are 1600, 800, 400, 200, 100,
-        50, 25, 12.5, 6.25, 3.12, 1.56, and 0.78 Hz. Note, setting a value between the listed ones
-        will round *downwards*.
+        50 and 25 Hz. Note, setting a value between the listed ones will round *downwards*, and a value
+        below 25 Hz sets 25 Hz.
         """
         res = self.generic_setter(
             odr,
@@ -625,7 +709,7 @@ class BMX160:
 
     ############## MAGNETOMETER SETTINGS  ##############
 
-    def init_mag(self):
+    def init_mag(self, warmup=True):
         # see pg 25 of: https://ae-bst.resource.bosch.com/media/_tech/media/datasheets/BST-BMX160-DS000.pdf
         self.write_u8(_BMX160_COMMAND_REG_ADDR, _BMX160_MAG_NORMAL_MODE)
         time.sleep(0.00065)  # datasheet says wait for 650microsec
@@ -648,7 +732,8 @@ class BMX160:
         self.write_u8(_BMX160_MAG_IF_0_ADDR, 0x00)
         # put in low power mode.
         self.write_u8(_BMX160_COMMAND_REG_ADDR, _BMX160_MAG_LOWPOWER_MODE)
-        time.sleep(0.1)  # takes this long to warm up (empirically)
+        if warmup:
+            time.sleep(self.MAG_WARMUP_MS / 1000)
 
     @property
     def mag_powermode(self):
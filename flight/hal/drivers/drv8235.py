@@ -43,6 +43,7 @@ Implementation Notes
 from adafruit_bus_device.i2c_device import I2CDevice
 from adafruit_register.i2c_bit import ROBit, RWBit
 from adafruit_register.i2c_bits import ROBits, RWBits
+from adafruit_register.i2c_struct import UnaryStruct
 from hal.drivers.errors import Errors
 from micropython import const
 
@@ -111,7 +112,7 @@ class DRV8235:
     _ovp = ROBit(_FAULT_STATUS, 3, 1, False)  # Overvoltage event
     _tsd = ROBit(_FAULT_STATUS, 2, 1, False)  # Overtemperature event
     _npor = ROBit(_FAULT_STATUS, 1, 1, False)  # Undervoltage event
-    _wset_vset = RWBits(8, _REG_CTRL1, 0, 1, False)  # Sets target motor voltage
+    _wset_vset = UnaryStruct(_REG_CTRL1, "<B")  # Sets target motor voltage (whole register, no read back)
     _vmtr = ROBits(8, _REG_STATUS1, 0, 1, False)
     _imtr = ROBits(8, _REG_STATUS2, 0, 1, False)
     _duty_read = ROBits(6, _REG_STATUS3, 0, 1, False)
@@ -130,9 +131,10 @@ class DRV8235:
         self.i2c_device = I2CDevice(i2c_bus, address)
         self._i2c_bc = True
         self._pmode = True
-        self._dir = BridgeControl.COAST
+        self._wset_vset_cache = None  # last values written to WSET_VSET and the bridge direction, None if unknown
+        self._dir_cache = None
         self._reg_ctrl = 0x3  # Sets to voltage regulation
-        self._wset_vset = 0  # Sets initial voltage to 0
+        self.__write_bridge(0, BridgeControl.COAST)  # Sets initial voltage to 0
         self._int_vref = True
         # TODO: check inv_r_scale and inv_r values
         self._inv_r_scale = 0x3
@@ -172,22 +174,27 @@ class DRV8235:
 
     def set_throttle(self, new_throttle):
         if new_throttle is None:
-            self._wset_vset = 0
-            self._dir = BridgeControl.COAST
+            self.__write_bridge(0, BridgeControl.COAST)
             return
         # Constrain throttle value
         self._throttle_normalized = min(max(new_throttle * self._THROTTLE_MAX, -self._THROTTLE_MAX), self._THROTTLE_MAX)
         if new_throttle < 0:
-            self._wset_vset = int(abs(self._throttle_normalized * 0xFF))
-            self._dir = BridgeControl.REVERSE
+            self.__write_bridge(int(abs(self._throttle_normalized * 0xFF)), BridgeControl.REVERSE)
         elif new_throttle > 0:
-            self._wset_vset = int(self._throttle_normalized * 0xFF)
-            self._dir = BridgeControl.FORWARD
+            self.__write_bridge(int(self._throttle_normalized * 0xFF), BridgeControl.FORWARD)
         else:
-            self._wset_vset = 0
-            self._dir = BridgeControl.BRAKE
+            self.__write_bridge(0, BridgeControl.BRAKE)
         return
 
+    def __write_bridge(self, wset_vset, direction):
+        """Updates the target voltage and the bridge direction, writing only the registers that change."""
+        if wset_vset != self._wset_vset_cache:
+            self._wset_vset = wset_vset
+            self._wset_vset_cache = wset_vset
+        if direction != self._dir_cache:
+            self._dir = direction
+            self._dir_cache = direction
+
     def throttle_volts(self):
         """Current motor voltage, ranging from -42.7 volts (full speed reverse) to
         +42.7 volts (full speed forward), or ``None`` (controller off). If ``None``,
@@ -204,20 +211,16 @@ class DRV8235:
 
     def set_throttle_volts(self, new_throttle_volts):
         if new_throttle_volts is None:
-            self._wset_vset = 0
-            self._dir = BridgeControl.COAST
+            self.__write_bridge(0, BridgeControl.COAST)
             return
         # Constrain throttle voltage value
         new_throttle_volts = min(max(new_throttle_volts, -42.7), +42.7)
         if new_throttle_volts < 0:
-            self._wset_vset = self.voltage_to_index(abs(new_throttle_volts))
-            self._dir = BridgeControl.REVERSE
+            self.__write_bridge(self.voltage_to_index(abs(new_throttle_volts)), BridgeControl.REVERSE)
         elif new_throttle_volts > 0:
-            self._wset_vset = self.voltage_to_index(new_throttle_volts)
-            self._dir = BridgeControl.FORWARD
+            self.__write_bridge(self.voltage_to_index(new_throttle_volts), BridgeControl.FORWARD)
         else:
-            self._wset_vset = 0
-            self._dir = BridgeControl.BRAKE
+            self.__write_bridge(0, BridgeControl.BRAKE)
         return
 
     def throttle_raw(self):
@@ -236,20 +239,16 @@ class DRV8235:
 
     def set_throttle_raw(self, new_throttle_raw):
         if new_throttle_raw is None:
-            self._wset_vset = 0
-            self._dir = BridgeControl.COAST
+            self.__write_bridge(0, BridgeControl.COAST)
             return
         # Constrain raw throttle value
         new_throttle_raw = min(max(new_throttle_raw, -255), 255)
         if new_throttle_raw < 0:
-            self._wset_vset = new_throttle_raw
-            self._dir = BridgeControl.REVERSE
+            self.__write_bridge(-new_throttle_raw, BridgeControl.REVERSE)
         elif new_throttle_raw > 0:
-            self._wset_vset = new_throttle_raw
-            self._dir = BridgeControl.FORWARD
+            self.__write_bridge(new_throttle_raw, BridgeControl.FORWARD)
         else:
-            self._wset_vset = 0
-            self._dir = BridgeControl.BRAKE
+            self.__write_bridge(0, BridgeControl.BRAKE)
         return
 
     def read_voltage_current(self) -> tuple[float, float]:
@@ -276,13 +275,14 @@ class DRV8235:
     def clear_faults(self):
         """Clears all fault conditions."""
         self._clear = True  # Clear all fault status flags
+        self._wset_vset_cache = None  # The outputs may have been disabled, rewrite them on the next update
+        self._dir_cache = None
 
     def __enter__(self):
         return self
 
     def __exit__(self, exception_type, exception_value, traceback):
-        self._wset_vset = 0
-        self._dir = BridgeControl.COAST
+        self.__write_bridge(0, BridgeControl.COAST)
 
     ######################## ERROR HANDLING ########################
 
@@ -48,6 +48,7 @@ Implementation Notes
 from adafruit_bus_device.i2c_device import I2CDevice
 from adafruit_register.i2c_bit import ROBit, RWBit
 from adafruit_register.i2c_bits import RWBits
+from adafruit_register.i2c_struct import UnaryStruct
 from hal.drivers.errors import Errors
 
 # DEVICE REGISTER MAP
@@ -120,14 +121,15 @@ class DRV8830:
         """Instantiate DRV8830. Set output voltage to 0.0, place into STANDBY
         mode, and reset all fault status flags."""
         self.i2c_device = I2CDevice(i2c_bus, address)
-        self._vset = 0x00
-        self._in_x = BridgeControl.STANDBY
+        self._control_cache = None  # last value written to CONTROL, None if unknown
+        self.__write_bridge(0x00, BridgeControl.STANDBY)
         # Clear all fault status flags
         self.clear_faults()
 
         super().__init__()
 
     # DEFINE I2C DEVICE BITS, NYBBLES, BYTES, AND REGISTERS
+    _control = UnaryStruct(_CONTROL, "<B")  # VSET and IN2, IN1 written at once
     _in_x = RWBits(2, _CONTROL, 0, 1, False)  # Output state; IN2, IN1
     _vset = RWBits(6, _CONTROL, 2, 1, False)  # DAC output voltage (raw)
     _fault = ROBit(_FAULT, 0, 1, False)  # Any fault condition
@@ -152,22 +154,25 @@ class DRV8830:
 
     def set_throttle(self, new_throttle):
         if new_throttle is None:
-            self._vset = 0
-            self._in_x = BridgeControl.COAST
+            self.__write_bridge(0, BridgeControl.COAST)
             return
         # Constrain throttle value
         self._throttle_normalized = min(max(new_throttle, -1.0), +1.0)
         if new_throttle < 0:
-            self._vset = int(abs(new_throttle * 0x3F))
-            self._in_x = BridgeControl.REVERSE
+            self.__write_bridge(int(abs(new_throttle * 0x3F)), BridgeControl.REVERSE)
         elif new_throttle > 0:
-            self._vset = int(new_throttle * 0x3F)
-            self._in_x = BridgeControl.FORWARD
+            self.__write_bridge(int(new_throttle * 0x3F), BridgeControl.FORWARD)
         else:
-            self._vset = 0
-            self._in_x = BridgeControl.BRAKE
+            self.__write_bridge(0, BridgeControl.BRAKE)
         return
 
+    def __write_bridge(self, vset, in_x):
+        """Writes the output voltage and bridge state in a single CONTROL write, skipped if they are unchanged."""
+        control = (vset & 0x3F) << 2 | in_x
+        if control != self._control_cache:
+            self._control = control
+            self._control_cache = control
+
     def throttle_volts(self):
         """Current motor speed, ranging from -5.06 volts (full speed reverse) to
         +5.06 volts (full speed forward), or ``None`` (controller off). If ``None``,
@@ -183,20 +188,16 @@ class DRV8830:
 
     def set_throttle_volts(self, new_throttle_volts):
         if new_throttle_volts is None:
-            self._vset = 0
-            self._in_x = BridgeControl.COAST
+            self.__write_bridge(0, BridgeControl.COAST)
             return
         # Constrain throttle voltage value
         new_throttle_volts = min(max(new_throttle_volts, -5.1), +5.1)
         if new_throttle_volts < 0:
-            self._vset = VoltageAdapter.voltage_to_index(self, abs(new_throttle_volts))
-            self._in_x = BridgeControl.REVERSE
+            self.__write_bridge(VoltageAdapter.voltage_to_index(self, abs(new_throttle_volts)), BridgeControl.REVERSE)
         elif new_throttle_volts > 0:
-            self._vset = VoltageAdapter.voltage_to_index(self, new_throttle_volts)
-            self._in_x = BridgeControl.FORWARD
+            self.__write_bridge(VoltageAdapter.voltage_to_index(self, new_throttle_volts), BridgeControl.FORWARD)
         else:
-            self._vset = 0
-            self._in_x = BridgeControl.BRAKE
+            self.__write_bridge(0, BridgeControl.BRAKE)
         return
 
     def throttle_raw(self):
@@ -214,20 +215,16 @@ class DRV8830:
 
     def set_throttle_raw(self, new_throttle_raw):
         if new_throttle_raw is None:
-            self._vset = 0
-            self._in_x = BridgeControl.COAST
+            self.__write_bridge(0, BridgeControl.COAST)
             return
         # Constrain raw throttle value
         new_throttle_raw = min(max(new_throttle_raw, -63), 63)
         if new_throttle_raw < 0:
-            self._vset = new_throttle_raw
-            self._in_x = BridgeControl.REVERSE
+            self.__write_bridge(-new_throttle_raw, BridgeControl.REVERSE)
         elif new_throttle_raw > 0:
-            self._vset = new_throttle_raw
-            self._in_x = BridgeControl.FORWARD
+            self.__write_bridge(new_throttle_raw, BridgeControl.FORWARD)
         else:
-            self._vset = 0
-            self._in_x = BridgeControl.BRAKE
+            self.__write_bridge(0, BridgeControl.BRAKE)
         return
 
     @property
@@ -257,13 +254,13 @@ class DRV8830:
     def clear_faults(self):
         """Clears all fault conditions."""
         self._clear = True  # Clear all fault status flags
+        self._control_cache = None  # The outputs may have been disabled, rewrite them on the next update
 
     def __enter__(self):
         return self
 
     def __exit__(self, exception_type, exception_value, traceback):
-        self._vset = 0
-        self._in_x = BridgeControl.STANDBY
+        self.__write_bridge(0, BridgeControl.STANDBY)
 
     ######################## ERROR HANDLING ########################
 
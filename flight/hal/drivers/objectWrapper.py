@@ -2,30 +2,44 @@ from hal.drivers.errors import Errors
 
 
 class objectWrapper:
+    """
+    Fault-tracking proxy of a booted device.
+
+    Any exception raised by a device method is turned into a RuntimeError and flags the device with
+    Errors.FN_CALL_ERROR in device_errors, for hal_monitor. The wrapped method of each name is built once, on
+    first access, and stored as an instance attribute: later calls find it directly and skip __getattr__, so the
+    hot path no longer allocates a closure and a bound method per call. Non-callable attributes are read live
+    from the device on every access.
+    """
+
     def __init__(self, obj):
         self.obj = obj
         self.fnError = False
 
     def __getattr__(self, name):
+        # Only reached for names not cached yet
         if isinstance(self.obj, objectWrapper):
             self.fnError = True
             raise RuntimeError(f"Error: Recursive access detected for '{name}'")
         try:
             attr = getattr(self.obj, name)
-            if callable(attr):  # Check if the attribute is a method
-
-                def wrapped_method(*args, **kwargs):
-                    try:
-                        return attr(*args, **kwargs)
-                    except Exception as e:
-                        self.fnError = True
-                        raise RuntimeError(f"Error calling method '{name}': {e}")
-
-                return wrapped_method
-            return attr
         except Exception as e:
             self.fnError = True
             raise RuntimeError(f"Error accessing attribute '{name}': {e}")
+        if callable(attr):
+            attr = self.__wrap(name, attr)
+            setattr(self, name, attr)
+        return attr
+
+    def __wrap(self, name, method):
+        def wrapped_method(*args, **kwargs):
+            try:
+                return method(*args, **kwargs)
+            except Exception as e:
+                self.fnError = True
+                raise RuntimeError(f"Error calling method '{name}': {e}")
+
+        return wrapped_method
 
     ######################## ERROR HANDLING ########################
 
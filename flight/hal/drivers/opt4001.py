@@ -72,6 +72,64 @@ SOT_5X3 = const(0)
 PICOSTAR = const(1)
 
 
+def _parity(x) -> int:
+    x ^= x >> 16
+    x ^= x >> 8
+    x ^= x >> 4
+    x ^= x >> 2
+    x ^= x >> 1
+    return x & 1
+
+
+def result_crc(exponent, mantissa, counter) -> int:
+    """
+    CRC bits of a result, as described in page 18 of the datasheet (see OPT4001.result).
+    The parity of the XOR of masked fields is the XOR of the selected bits of each field.
+    """
+    x0 = _parity(exponent ^ mantissa ^ counter)
+    x1 = _parity((exponent & 0b1010) ^ (mantissa & 0xAAAAA) ^ (counter & 0b1010))
+    x2 = _parity((exponent & 0b1000) ^ (mantissa & 0x88888) ^ (counter & 0b1000))
+    x3 = _parity(mantissa & 0x80808)
+    return x3 << 3 | x2 << 2 | x1 << 1 | x0
+
+
+def decode_result(buf) -> tuple:
+    """
+    Decodes the 4 bytes of a RESULT_H, RESULT_L (or FIFO_n_H, FIFO_n_L) register pair.
+    Returns (exponent, mantissa, counter, crc_ok).
+    """
+    exponent = buf[0] >> 4  # 15-12
+    mantissa = (buf[0] & 0x0F) << 16 | buf[1] << 8 | buf[2]  # RESULT_MSB 11-0, RESULT_LSB 15-8
+    counter = buf[3] >> 4  # 7-4
+    return exponent, mantissa, counter, result_crc(exponent, mantissa, counter) == buf[3] & 0x0F
+
+
+def decode_results(raw, scales, lux, counters) -> int:
+    """
+    Decodes a batch of results, 4 bytes each in raw (see decode_result), into lux (array('f'), ADC codes times
+    scales[i]) and counters (bytearray). Returns a bitmask of the results whose CRC matches.
+
+    Replaced by the native opt4001_decode module when the firmware is built with it (firmware/usermod).
+    """
+    valid = 0
+    for i in range(len(raw) >> 2):
+        j = i << 2
+        exponent = raw[j] >> 4
+        mantissa = (raw[j] & 0x0F) << 16 | raw[j + 1] << 8 | raw[j + 2]
+        counter = raw[j + 3] >> 4
+        lux[i] = (mantissa << exponent) * scales[i]
+        counters[i] = counter
+        if result_crc(exponent, mantissa, counter) == raw[j + 3] & 0x0F:
+            valid |= 1 << i
+    return valid
+
+
+try:
+    from opt4001_decode import decode_results  # noqa: F811
+except ImportError:
+    pass
+
+
 class OPT4001:
     """
     Driver for the OPT4001 ambient light sensor
@@ -284,7 +342,10 @@ class OPT4001:
 
         """
 
+        self.lux_per_code = 0.0003125 if package == PICOSTAR else 0.0004375
+
         self.buf = bytearray(3)
+        self.result_buf = bytearray(4)
 
         # check that the ID of the device matches what the datasheet says the ID should be
         if not self.check_id():
@@ -460,6 +521,27 @@ class OPT4001:
         """
         return self.result_of_addr(False)
 
+    def read_latest(self) -> tuple:
+        """
+        Non-blocking read of the latest conversion, for the continuous operating mode (3).
+
+        Both result registers are read in one I2C burst without waiting for conversion_ready_flag. Returns
+        (lux, counter, crc_ok): the counter only advances when a conversion completed since the previous read, and
+        crc_ok is False when the CRC bits do not match the result received over the bus.
+        """
+        self.read_result_into(self.result_buf)
+        exponent, mantissa, counter, crc_ok = decode_result(self.result_buf)
+        return (mantissa << exponent) * self.lux_per_code, counter, crc_ok
+
+    def read_result_into(self, buf, start=0) -> None:
+        """
+        Reads the 4 bytes of the latest result (RESULT_H, RESULT_L) into buf[start:start + 4] in one I2C burst,
+        without waiting for a conversion, for decode_results. For the continuous operating mode (3).
+        """
+        self.buf[0] = RESULT_H
+        with self.i2c_device as i2c:
+            i2c.write_then_readinto(self.buf, buf, out_end=1, in_start=start, in_end=start + 4)
+
     def read_lux_FIFO(self, id: Literal[0, 1, 2]) -> float:
         """
         Reads just the lux from the FIFO<id> register identically to the lux property. Returns the
@@ -22,6 +22,7 @@ from adafruit_bus_device.i2c_device import I2CDevice
 from adafruit_register.i2c_bit import ROBit, RWBit
 from adafruit_register.i2c_bits import RWBits
 from hal.drivers.errors import Errors
+from hal.drivers.opt4001 import decode_result
 
 try:
     from busio import I2C
@@ -246,6 +247,8 @@ class OPT4003:
         """
 
         self.buf = bytearray(3)
+        self.result_buf = bytearray(4)
+        self.lux_per_code = 0.000535
 
         # check that the ID of the device matches what the datasheet says the ID should be
         if not self.check_id():
@@ -355,6 +358,28 @@ class OPT4003:
         """
         return self.result_of_addr(False)
 
+    def read_latest(self) -> tuple:
+        """
+        Non-blocking read of the latest channel 0 conversion, for the continuous operating mode (3).
+
+        Both result registers are read in one I2C burst without waiting for conversion_ready_flag. Returns
+        (lux, counter, crc_ok): the counter only advances when a conversion completed since the previous read, and
+        crc_ok is False when the CRC bits do not match the result received over the bus. The result layout and CRC
+        are the same as the OPT4001.
+        """
+        self.read_result_into(self.result_buf)
+        exponent, mantissa, counter, crc_ok = decode_result(self.result_buf)
+        return (mantissa << exponent) * self.lux_per_code, counter, crc_ok
+
+    def read_result_into(self, buf, start=0) -> None:
+        """
+        Reads the 4 bytes of the latest channel 0 result into buf[start:start + 4] in one I2C burst, without waiting
+        for a conversion, for decode_results. For the continuous operating mode (3).
+        """
+        self.buf[0] = _RESULT_MSB_CH0
+        with self.i2c_device as i2c:
+            i2c.write_then_readinto(self.buf, buf, out_end=1, in_start=start, in_end=start + 4)
+
     @property
     def result(self) -> tuple:
         """
@@ -30,8 +30,15 @@ _FRAME_START = b"\xA0\xA1"
 _FRAME_END = b"\x0D\x0A"
 _MIN_FRAME_LEN = 8
 _MAX_FRAME_PAYLOAD_LEN = 256
+_FRAME_OVERHEAD = 7  # start (2) + length (2) + checksum (1) + end (2)
+_PAYLOAD_OFFSET = 4  # payload (starting with the message ID) follows start and length
+_NAV_MSG_ID = 0xDF
+_NAV_PAYLOAD_LEN = 81
+# AN0030 Navigation Data Message (0xDF): ID, IOD, fix mode, week, TOW, ECEF pos, ECEF vel, clock bias/drift, DOPs
+_AN0030_FORMAT = ">BBBHddddfffdffffff"
 _MAX_RX_BUFFER_LEN = 4096
 _RX_BUFFER_WARN_FRACTION = 4  # Warn if buffer is 1/{this value} of max length
+_RX_CHUNK_BITS = 6  # UART reads go through 1, 2, 4 .. 64 byte views of one chunk
 _GPS_UTC_OFFSET_SECONDS = 18  # GPS Counts leap seconds, there are 18 as of June 2026
 
 
@@ -82,16 +89,24 @@ class GPS:
         # MESSAGE OUTPUT
         ################################################
 
-        # Payload Buffer:
-        self._payload = bytearray([0] * 81)
+        # Frame Buffer: holds the single frame selected for decoding
+        self._frame = bytearray(_MAX_FRAME_PAYLOAD_LEN + _FRAME_OVERHEAD)
 
         # Message Variables
-        self._msg = None
+        self._msg_len = 0
         self._payload_len = 0
         self._msg_id = 0
         self._msg_cs = 0
         self.last_update_status = None
-        self._rx_buffer = bytearray()
+
+        # RX ring buffer: fixed capacity, frames are scanned in place between head and head + len
+        self._rx_buffer = bytearray(self._max_rx_buffer_len)
+        self._rx_head = 0
+        self._rx_len = 0
+
+        # UART read chunk: readinto waits for len(buf) bytes, the views are sized once so reads never slice
+        self._rx_chunk = bytearray(1 << _RX_CHUNK_BITS)
+        self._rx_chunk_views = [memoryview(self._rx_chunk)[: 1 << k] for k in range(_RX_CHUNK_BITS + 1)]
 
         ################################################
         # HELPER FLAGS
@@ -166,42 +181,33 @@ class GPS:
         getattr(logger, level)(f"[GPS] {msg}")
 
     def _collect_message(self) -> bool:
-        try:
-            self._msg = self.read_sentence()
-        except UnicodeError:
-            self.last_update_status = "Unicode error when parsing GPS message"
-            return False
+        self._msg_len = self.read_sentence()
 
-        if self._msg is None:
+        if self._msg_len == 0:
             self.last_update_status = "GPS message is None"
             return False
 
-        if len(self._msg) < 7:
-            self.last_update_status = f"GPS message too short: {len(self._msg)} bytes"
+        if self._msg_len < _FRAME_OVERHEAD:
+            self.last_update_status = f"GPS message too short: {self._msg_len} bytes"
             return False
 
         # Print the raw messages
         if self._debug:
-            self._log("debug", "RAW")
-            self._log("debug", str(self._msg))
             self._log("debug", "DECODE")
-            self._log("debug", " ".join(f"{b:02x}" for b in self._msg))
+            self._log("debug", " ".join(f"{b:02x}" for b in self._frame[: self._msg_len]))
         return True
 
     def _parse_message_header(self) -> bool:
-        try:
-            self._payload_len = int(((self._msg[2] & 0xFF) << 8) | self._msg[3])
-            self._msg_id = int(self._msg[4])
-            self._msg_cs = int(self._msg[-3])
-            self._payload = bytearray(self._msg[4:-3])  # TODO Is this required
-            return True
-        except Exception as e:
-            self.last_update_status = f"Error parsing message length, ID, checksum, or payload: {e}"
-            return False
+        # Fields are read in place from the frame buffer, the payload is never copied
+        self._payload_len = (self._frame[2] << 8) | self._frame[3]
+        self._msg_id = self._frame[_PAYLOAD_OFFSET]
+        self._msg_cs = self._frame[self._msg_len - 3]
+        return True
 
     def _check_payload_and_ack(self) -> bool:
         if self._debug:
-            payload_hex = " ".join(f"{b:02X}" for b in self._payload)
+            payload_end = _PAYLOAD_OFFSET + self._payload_len
+            payload_hex = " ".join(f"{b:02X}" for b in self._frame[_PAYLOAD_OFFSET:payload_end])
             self._log("debug", f"Payload:\n{payload_hex}")
         if self._msg_id == 0x83:  # 0x83 is successful ACK of setting binary nav type
             self.last_update_status = "Received ACK message, not nav data"
@@ -212,22 +218,22 @@ class GPS:
         return True
 
     def _check_nav_data(self) -> bool:
-        if self._msg_id != 0xDF:
+        if self._msg_id != _NAV_MSG_ID:
             self.last_update_status = f"Invalid message ID, expected 0xDF, got: {hex(self._msg_id)}"
             return False
         return True
 
     def _parse_nav_data(self) -> bool:
-        if self._payload_len != 81:
+        if self._payload_len != _NAV_PAYLOAD_LEN:
             self.last_update_status = f"Invalid payload length, expected 81, got: {self._payload_len}"
             return False
         return self._parse_data_AN0030()
 
     def _checksum(self) -> bool:  # Checksum is simply XOR sequentially of the payload ID + payload bytes
         cs = 0
-        for i in self._payload:
-            i = int(i)
-            cs ^= i
+        frame = self._frame
+        for i in range(_PAYLOAD_OFFSET, _PAYLOAD_OFFSET + self._payload_len):
+            cs ^= frame[i]
         if cs != self._msg_cs:
             self.last_update_status = "Checksum failed!"
             return False
@@ -235,28 +241,30 @@ class GPS:
 
     def _parse_data_AN0030(self) -> bool:
         """
-        Parse SkyTraq AN0030 Navigation Data Message (ID 0xDF) payload using the
-        (typed helpers, no manual bit shifting).
+        Parse SkyTraq AN0030 Navigation Data Message (ID 0xDF) payload
+        straight from the frame buffer with a single struct.unpack_from.
         """
         try:
-            self.message_id = self._u8(0)
-            self.IOD = self._u8(1)
-            self.fix_mode = self._u8(2)
-            self.week = self._u16(3)
-            self.tow = self._dpfp(5)
-            self.ecef_x = self._dpfp(13)
-            self.ecef_y = self._dpfp(21)
-            self.ecef_z = self._dpfp(29)
-            self.ecef_vx = self._spfp(37)
-            self.ecef_vy = self._spfp(41)
-            self.ecef_vz = self._spfp(45)
-            self.clock_bias = self._dpfp(49)
-            self.clock_drift = self._spfp(57)
-            self.gdop = self._spfp(61)
-            self.pdop = self._spfp(65)
-            self.hdop = self._spfp(69)
-            self.vdop = self._spfp(73)
-            self.tdop = self._spfp(77)
+            (
+                self.message_id,
+                self.IOD,
+                self.fix_mode,
+                self.week,
+                self.tow,
+                self.ecef_x,
+                self.ecef_y,
+                self.ecef_z,
+                self.ecef_vx,
+                self.ecef_vy,
+                self.ecef_vz,
+                self.clock_bias,
+                self.clock_drift,
+                self.gdop,
+                self.pdop,
+                self.hdop,
+                self.vdop,
+                self.tdop,
+            ) = struct.unpack_from(_AN0030_FORMAT, self._frame, _PAYLOAD_OFFSET)
             self.unix_time = self._gps_time_2_unix_time(self.week, self.tow)
             if self._debug:
                 self._log("debug", "Printing navigation data")
@@ -267,41 +275,6 @@ class GPS:
             self._log("error", f"Error parsing AN0030 data: {e}")
             return False
 
-    def _s32(self, value: int) -> int:
-        return value if value < 0x80000000 else value - 0x100000000
-
-    def _u8(self, idx: int) -> int:
-        return self._payload[idx] & 0xFF
-
-    def _u16(self, idx: int) -> int:
-        return (self._payload[idx] << 8) | self._payload[idx + 1]
-
-    def _u32(self, idx: int) -> int:
-        return (
-            (self._payload[idx] << 24)
-            | (self._payload[idx + 1] << 16)
-            | (self._payload[idx + 2] << 8)
-            | self._payload[idx + 3]
-        )
-
-    def _u64(self, idx: int) -> int:
-        return (
-            (self._payload[idx] << 56)
-            | (self._payload[idx + 1] << 48)
-            | (self._payload[idx + 2] << 40)
-            | (self._payload[idx + 3] << 32)
-            | (self._payload[idx + 4] << 24)
-            | (self._payload[idx + 5] << 16)
-            | (self._payload[idx + 6] << 8)
-            | self._payload[idx + 7]
-        )
-
-    def _spfp(self, idx: int) -> float:
-        return struct.unpack(">f", bytes(self._payload[idx : idx + 4]))[0]
-
-    def _dpfp(self, idx: int) -> float:
-        return struct.unpack(">d", bytes(self._payload[idx : idx + 8]))[0]
-
     """
     Fix Modes in GPS Binary Message (S1216F8-GL):
 
@@ -519,16 +492,20 @@ class GPS:
     def _discard_rx_prefix(self, count: int) -> None:
         if count <= 0:
             return
-        self._rx_buffer = bytearray(self._rx_buffer[count:])
-
-    def _keep_rx_suffix(self, count: int) -> None:
-        if count <= 0:
-            self._rx_buffer = bytearray()
-            return
-        self._rx_buffer = bytearray(self._rx_buffer[-count:])
+        count = min(count, self._rx_len)
+        self._rx_head += count
+        if self._rx_head >= self._max_rx_buffer_len:
+            self._rx_head -= self._max_rx_buffer_len
+        self._rx_len -= count
+
+    def _rx_at(self, offset: int) -> int:
+        idx = self._rx_head + offset
+        if idx >= self._max_rx_buffer_len:
+            idx -= self._max_rx_buffer_len
+        return self._rx_buffer[idx]
 
     def _log_rx_buffer_size(self) -> None:
-        buffer_len = len(self._rx_buffer)
+        buffer_len = self._rx_len
         if self._debug:
             self._log("debug", f"RX buffer size: {buffer_len}/{self._max_rx_buffer_len}")
 
@@ -537,70 +514,145 @@ class GPS:
             self._log("warning", f"RX buffer nearing limit: {buffer_len}/{self._max_rx_buffer_len}")
 
     def _read_available_bytes(self) -> None:
+        cap = self._max_rx_buffer_len
         while self._in_waiting > 0:
-            chunk = self.read(self._in_waiting)
-            if not chunk:
+            waiting = self._in_waiting
+            if self._rx_len == cap:
+                # Ring is full: drop the oldest bytes so the newest data is kept
+                self._log("warning", f"RX buffer exceeded limit, dropping {min(waiting, cap)} oldest bytes")
+                self._discard_rx_prefix(min(waiting, cap))
+
+            # Largest chunk view the waiting bytes fill that fits the free space
+            available = min(waiting, cap - self._rx_len)
+            k = _RX_CHUNK_BITS
+            while k > 0 and (1 << k) > available:
+                k -= 1
+
+            n_read = self._uart.readinto(self._rx_chunk_views[k])
+            if not n_read:
                 return
-            self._rx_buffer.extend(chunk)
-            self._log_rx_buffer_size()
-
-        if len(self._rx_buffer) > self._max_rx_buffer_len:
-            self._log("warning", f"RX buffer exceeded limit, trimming to {self._max_rx_buffer_len} bytes")
-            self._keep_rx_suffix(self._max_rx_buffer_len)
-            self._log_rx_buffer_size()
 
-    def _extract_frame(self) -> Optional[bytes]:
-        while len(self._rx_buffer) >= 2:
-            start_idx = self._rx_buffer.find(_FRAME_START)
+            # Byte-wise into the ring, a slice would allocate
+            buffer = self._rx_buffer
+            chunk = self._rx_chunk
+            tail = self._rx_head + self._rx_len
+            if tail >= cap:
+                tail -= cap
+            for i in range(n_read):
+                buffer[tail] = chunk[i]
+                tail += 1
+                if tail == cap:
+                    tail = 0
+            self._rx_len += n_read
+
+        self._log_rx_buffer_size()
+
+    def _find_frame_start(self) -> int:
+        """Offset from the ring head of the next frame start marker, -1 if there is none."""
+        cap = self._max_rx_buffer_len
+        head = self._rx_head
+        first_end = min(head + self._rx_len, cap)
+
+        idx = self._rx_buffer.find(_FRAME_START, head, first_end)
+        if idx >= 0:
+            return idx - head
+
+        first_len = first_end - head
+        if first_len == self._rx_len:
+            return -1
+
+        # Data wraps around: check the marker straddling the end of the buffer, then the wrapped part
+        if self._rx_buffer[cap - 1] == _FRAME_START[0] and self._rx_buffer[0] == _FRAME_START[1]:
+            return first_len - 1
+        idx = self._rx_buffer.find(_FRAME_START, 0, self._rx_len - first_len)
+        return -1 if idx < 0 else first_len + idx
+
+    def _extract_frame(self) -> int:
+        """
+        Consume the next complete frame from the ring without copying it.
+        Returns the frame length (its first byte is at the ring head before the call), 0 if there is none.
+        """
+        while self._rx_len >= 2:
+            start_idx = self._find_frame_start()
             if start_idx < 0:
-                if len(self._rx_buffer) > 1:
-                    self._keep_rx_suffix(1)
-                return None
+                # Keep the last byte, it may be the first half of a start marker
+                self._discard_rx_prefix(self._rx_len - 1)
+                return 0
 
             if start_idx > 0:
                 self._discard_rx_prefix(start_idx)
 
-            if len(self._rx_buffer) < 4:
-                return None
+            if self._rx_len < 4:
+                return 0
 
-            payload_len = (self._rx_buffer[2] << 8) | self._rx_buffer[3]
+            payload_len = (self._rx_at(2) << 8) | self._rx_at(3)
             if payload_len == 0 or payload_len > _MAX_FRAME_PAYLOAD_LEN:
                 self._discard_rx_prefix(1)
                 continue
 
-            frame_len = payload_len + 7
-            if len(self._rx_buffer) < frame_len:
-                return None
+            frame_len = payload_len + _FRAME_OVERHEAD
+            if self._rx_len < frame_len:
+                return 0
 
-            if bytes(self._rx_buffer[frame_len - 2 : frame_len]) != _FRAME_END:
+            if self._rx_at(frame_len - 2) != _FRAME_END[0] or self._rx_at(frame_len - 1) != _FRAME_END[1]:
                 self._discard_rx_prefix(1)
                 continue
 
-            frame = bytes(self._rx_buffer[:frame_len])
             self._discard_rx_prefix(frame_len)
-            return frame
-
-        return None
+            return frame_len
+
+        return 0
+
+    def _copy_frame(self, start: int, frame_len: int) -> None:
+        # Linearize one frame from the ring into the frame buffer, byte-wise as a slice would allocate
+        cap = self._max_rx_buffer_len
+        buffer = self._rx_buffer
+        frame = self._frame
+        idx = start
+        for i in range(frame_len):
+            frame[i] = buffer[idx]
+            idx += 1
+            if idx == cap:
+                idx = 0
+
+    def read_sentence(self) -> int:
+        """
+        Scan all complete frames in the RX ring in place and copy only the newest one into the frame buffer.
+        Navigation data frames take precedence over any other message.
 
-    def read_sentence(self) -> Optional[bytes]:
+        :return: Length of the frame in the frame buffer, 0 if no complete frame was received
+        """
         self._read_available_bytes()
 
-        if len(self._rx_buffer) < _MIN_FRAME_LEN:
-            return None
+        if self._rx_len < _MIN_FRAME_LEN:
+            return 0
 
-        latest_frame = None
-        latest_nav_frame = None
+        latest_start = latest_len = 0
+        nav_start = nav_len = 0
 
         while True:
-            frame = self._extract_frame()
-            if frame is None:
+            frame_len = self._extract_frame()
+            if frame_len == 0:
                 break
-
-            latest_frame = frame
-            if len(frame) >= 5 and frame[4] == 0xDF:
-                latest_nav_frame = frame
-
-        return latest_nav_frame or latest_frame
+            # _extract_frame may have skipped garbage before the frame
+            start = self._rx_head - frame_len
+            if start < 0:
+                start += self._max_rx_buffer_len
+
+            latest_start, latest_len = start, frame_len
+            msg_id_idx = start + _PAYLOAD_OFFSET
+            if msg_id_idx >= self._max_rx_buffer_len:
+                msg_id_idx -= self._max_rx_buffer_len
+            if self._rx_buffer[msg_id_idx] == _NAV_MSG_ID:
+                nav_start, nav_len = start, frame_len
+
+        # Consumed bytes are only overwritten by the next UART read, so the selected frame is still intact
+        if nav_len:
+            self._copy_frame(nav_start, nav_len)
+            return nav_len
+        if latest_len:
+            self._copy_frame(latest_start, latest_len)
+        return latest_len
 
     ######################## ERROR HANDLING ########################
 
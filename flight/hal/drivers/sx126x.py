@@ -838,7 +838,7 @@ class SX126X:
             int((sleepPeriodRaw >> 8) & 0xFF),
             int(sleepPeriodRaw & 0xFF),
         ]
-        return self.SPIwriteCommand([], 1, data, 6)
+        return self.SPIwriteCommand([_SX126X_CMD_SET_RX_DUTY_CYCLE], 1, data, 6)
 
     def startReceiveDutyCycleAuto(self, senderPreambleLength=0, minSymbols=8):
         if senderPreambleLength == 0:
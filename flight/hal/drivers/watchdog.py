@@ -1,19 +1,75 @@
 import digitalio
 import hal.drivers.errors as Errors
 
+try:
+    from array import array
+
+    import rp2pio
+except ImportError:
+    rp2pio = None
+
+# PIO program toggling the watchdog input (WDI) for one period per heartbeat credit:
+#   0: pull noblock         ; the heartbeat refreshes the credit, X is kept otherwise
+#   1: mov x, osr
+#   2: jmp !x 0             ; no credit left: WDI held, the watchdog times out
+#   3: jmp x-- 4            ; consumes one period
+#   4: set pins, 1 [31]
+#   5: set y, 31 [31]
+#   6: jmp y-- 6 [31]
+#   7: set pins, 0 [31]
+#   8: set y, 31 [31]
+#   9: jmp y-- 9 [31]
+_PIO_PROGRAM = (0x8080, 0xA027, 0x0020, 0x0044, 0xFF01, 0xFF5F, 0x1F86, 0xFF00, 0xFF5F, 0x1F89)
+_PIO_PERIOD_CYCLES = 2180  # WDI toggle period of the program in state machine cycles
+PIO_PERIOD = 0.5  # s, WDI toggle period
+
 
 class Watchdog:
+    """
+    Hardware watchdog: WDT_EN gates the watchdog signal to the MCU, WDT_WDI must toggle faster than its timeout.
+
+    With rp2pio, WDI is toggled by a PIO state machine for as long as the heartbeat credit lasts, independently of
+    the Python code. Otherwise the pin is toggled by input_high / input_low.
+    """
+
     def __init__(self, enable_pin: object, input: object):
         self.__enable = digitalio.DigitalInOut(enable_pin)
         self.__enable.direction = digitalio.Direction.OUTPUT
         self.__enable.value = False
         self.__en_val = False  # Error handling
 
-        self.__input = digitalio.DigitalInOut(input)
-        self.__input.direction = digitalio.Direction.OUTPUT
-        self.__input.value = True
+        self.__input = None
+        self.__sm = None
+        if rp2pio is not None:
+            self.__sm = rp2pio.StateMachine(
+                array("H", _PIO_PROGRAM),
+                frequency=int(_PIO_PERIOD_CYCLES / PIO_PERIOD),
+                first_set_pin=input,
+                set_pin_count=1,
+                initial_set_pin_state=1,
+                initial_set_pin_direction=1,
+                wait_for_txstall=False,
+            )
+            self.__credit = array("I", [0])
+        else:
+            self.__input = digitalio.DigitalInOut(input)
+            self.__input.direction = digitalio.Direction.OUTPUT
+            self.__input.value = True
         self.__input_val = True  # Error handling
 
+    @property
+    def timer_backed(self):
+        """True if WDI is toggled by the PIO state machine, fed by heartbeat."""
+        return self.__sm is not None
+
+    def heartbeat(self, window: float):
+        """
+        Keeps WDI toggling for window seconds from now, replacing the remaining credit. Call at most once per
+        PIO_PERIOD, the state machine takes one credit from its FIFO per period.
+        """
+        self.__credit[0] = int(window / PIO_PERIOD)
+        self.__sm.write(self.__credit)
+
     def enable(self):
         self.__enable.value = True
         self.__en_val = True
@@ -45,13 +101,17 @@ class Watchdog:
         results = []
         if self.__en_val != self.__enable.value:
             results.append(Errors.WATCHDOG_EN_GPIO_ERROR)
-        if self.__input_val != self.__input.value:
+        if self.__input is not None and self.__input_val != self.__input.value:
             results.append(Errors.WATCHDOG_INPUT_GPIO_ERROR)
         return results
 
     def deinit(self):
         self.__enable.deinit()
         self.__enable = None
-        self.__input.deinit()
-        self.__input = None
+        if self.__sm is not None:
+            self.__sm.deinit()
+            self.__sm = None
+        else:
+            self.__input.deinit()
+            self.__input = None
         return
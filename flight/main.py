@@ -4,8 +4,9 @@ import sys
 import time
 
 import microcontroller
-from core import logger, setup_logger, state_manager
+from core import TemplateTask, logger, setup_logger, state_manager
 from core.satellite_config import main_config as CONFIG
+from core.time_processor import TimeProcessor as TPM
 from hal.configuration import SATELLITE
 
 
@@ -24,6 +25,7 @@ for path in ["/hal", "/apps", "/core"]:
         sys.path.append(path)
 
 setup_logger(level=CONFIG.LOG_LEVEL)
+TemplateTask.mem_profile = CONFIG.MEM_PROFILE
 
 reset_reason = getattr(microcontroller.cpu, "reset_reason", None)
 print(f"Reset reason: {reset_reason}")
@@ -38,7 +40,7 @@ print(f"Boot Errors: {SATELLITE.ERRORS}")
 
 
 print("Waiting 1 sec...")
-time.sleep(1)
+TPM.settle(1)
 
 
 """print("Running system diagnostics...")
@@ -57,6 +59,8 @@ try:
 
     # DH.delete_all_files()
 
+    # Boot time and heap left for the tasks, to compare firmware builds (e.g. the frozen flight core variant)
+    logger.info(f"Boot to STARTUP: {int(time.monotonic() * 1000)} ms since reset, {gc.mem_free()} bytes free")
     logger.info("Starting state manager")
     state_manager.start()
 
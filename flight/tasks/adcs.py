@@ -1,21 +1,29 @@
-# Attitude Determination and Control (ADC) task
+# Attitude Determination and Control (ADC) task: mode determination, attitude control and logging
 
 import apps.adcs.sensors as sensors
 from apps.adcs.acs import mcm_coil_allocator, spin_stabilizing_controller, sun_pointing_controller, zero_all_coils
 from apps.adcs.consts import Modes, StatusConst
+from apps.adcs.shared_state import ADCSState as AD
 from core import DataHandler as DH
+from core import DataRecord
 from core import TemplateTask
 from core import state_manager as SM
-from core.dh_constants import ADCS_IDX, CDH_IDX, class_length
+from core.dh_constants import ADCS_IDX, CDH_IDX
+from core.satellite_config import adcs_config as CONFIG
+from core.schemas import adcs as ADCS_SCHEMA
 from core.states import STATES
 from core.time_processor import TimeProcessor as TPM
 from ulab import numpy as np
 
 """
     ASSUMPTIONS :
-        - ADCS Task runs at 5 Hz (TBD if we can't handle this)
+        - The ADCS is split in three loops sharing ADCSState (apps/adcs/shared_state.py), each at its own rate:
+          the gyro loop (tasks/adcs_gyro.py, 10 Hz), the magnetometer loop (tasks/adcs_mag.py, 1 Hz) and this
+          actuation loop (5 Hz). The controllers use the latest readings of the sensor loops.
+        - Coils are not driven while the magnetometer loop holds them off for a sample
+        - Coils are duty cycled: driven for CONFIG.COIL_ON_FRACTION of each control period and zeroed for the rest
+          of it. The commanded dipole is scaled up by the on-fraction to keep its average over the period.
 """
-_IDX_LENGTH = class_length(ADCS_IDX)
 
 
 class Task(TemplateTask):
@@ -49,24 +57,7 @@ class Task(TemplateTask):
         "ZM_COIL_STATUS",
     ]"""
 
-    log_data = [0] * _IDX_LENGTH
-    coil_status = [0] * 6
-
-    ## ADCS Modes and switching logic
-    MODE = Modes.TUMBLING
-
-    # Sensor Data storage
-    gyro_status = StatusConst.OK
-    gyro_data = np.zeros((3,))
-
-    mag_status = StatusConst.OK
-    mag_data = np.zeros((3,))
-
-    sun_status = StatusConst.OK
-    sun_pos_body = np.zeros((3,))
-    sun_lux = np.zeros((9,))
-
-    mag_counter = 0
+    log_data = DataRecord(ADCS_SCHEMA)
 
     def __init__(self, id):
         super().__init__(id)
@@ -78,8 +69,7 @@ class Task(TemplateTask):
 
         else:
             if not DH.data_process_exists("adcs"):
-                data_format = "LB" + 6 * "f" + "B" + 3 * "f" + 9 * "H" + 6 * "B"  # + 4 * "f"
-                DH.register_data_process("adcs", data_format, True, data_limit=100000, write_interval=5)
+                DH.register_data_process("adcs", ADCS_SCHEMA.FORMAT, True, data_limit=100000, write_interval=5)
 
             self.time = TPM.time()
             self.log_data[ADCS_IDX.TIME_ADCS] = self.time
@@ -88,36 +78,19 @@ class Task(TemplateTask):
             # DETUMBLING
             # ------------------------------------------------------------------------------------------------------------------------------------
             if SM.current_state == STATES.DETUMBLING:
-                # Query the Gyro
-                self.gyro_status, self.gyro_data = sensors.read_gyro()
-
-                # Query Magnetometer
-                if self.mag_counter == 0:
-                    self.mag_status, self.mag_data = sensors.read_magnetometer()
-                    self.last_mag_time = TPM.time()
-
-                # Run Attitude Control
-                if self.mag_counter < 3:
-                    self.attitude_control()
-                    self.last_mtb_time = TPM.time()
-                else:
-                    zero_all_coils()
+                await self.actuate()
 
-                self.mag_counter += 1
-                if self.mag_counter == 5:
-                    self.mag_counter = 0
                 # Check if detumbling has been completed
-                if sensors.current_mode(self.MODE) != Modes.TUMBLING:
-                    zero_all_coils()
-                    self.MODE = Modes.STABLE
+                if self.current_mode() != Modes.TUMBLING:
+                    self.zero_coils()
+                    AD.MODE = Modes.STABLE
 
             # ------------------------------------------------------------------------------------------------------------------------------------
             # LOW POWER
             # ------------------------------------------------------------------------------------------------------------------------------------
             elif SM.current_state == STATES.LOW_POWER:
                 # Turn coils off to conserve power
-                zero_all_coils()
-                self.mag_counter = 0
+                self.zero_coils()
 
             # ------------------------------------------------------------------------------------------------------------------------------------
             # NOMINAL
@@ -126,77 +99,80 @@ class Task(TemplateTask):
                 if (
                     SM.current_state == STATES.NOMINAL
                     and not DH.get_latest_data("cdh")[CDH_IDX.DETUMBLING_ERROR_FLAG]
-                    and sensors.current_mode(self.MODE) == Modes.TUMBLING
+                    and self.current_mode() == Modes.TUMBLING
                 ):
                     # Do not allow a switch to Detumbling from Low power
-                    self.MODE = Modes.TUMBLING
+                    AD.MODE = Modes.TUMBLING
 
                 else:
-                    # Query the Gyro
-                    self.gyro_status, self.gyro_data = sensors.read_gyro()
-
-                    # Query Magnetometer
-                    if self.mag_counter == 0:
-                        self.mag_status, self.mag_data = sensors.read_magnetometer()
-                        self.last_mag_time = TPM.time()
-
-                    # Query Sun Position
-                    self.sun_status, self.sun_pos_body, self.sun_lux = sensors.read_sun_position()
-
                     # identify Mode based on current sensor readings
-                    new_mode = sensors.current_mode(self.MODE)
-                    if new_mode != self.MODE:
-                        zero_all_coils()
-                        self.MODE = new_mode
+                    new_mode = self.current_mode()
+                    if new_mode != AD.MODE:
+                        self.zero_coils()
+                        AD.MODE = new_mode
 
                     # Run attitude control if not in Low-power
-                    if SM.current_state != STATES.LOW_POWER and self.MODE != Modes.ACS_OFF and self.mag_counter < 3:
-                        self.attitude_control()
-                        self.last_mtb_time = TPM.time()
+                    if SM.current_state != STATES.LOW_POWER and AD.MODE != Modes.ACS_OFF:
+                        await self.actuate()
                     else:
-                        zero_all_coils()
-
-                    self.mag_counter += 1
-                    if self.mag_counter == 5:
-                        self.mag_counter = 0
+                        self.zero_coils()
 
             # Log data
             # NOTE: In detumbling, most of the log will be zeros since very few sensors are queried
             self.log()
 
+    def current_mode(self):
+        return sensors.current_mode(AD.MODE, AD.gyro_status, AD.gyro_data, AD.sun_status, AD.sun_pos_body)
+
+    async def actuate(self):
+        """
+        Runs attitude control for one control period, unless the magnetometer loop holds the coils off for a sample.
+        The coils are zeroed once the on-fraction of the period has elapsed.
+        """
+        if AD.coil_hold_off or not self.attitude_control():
+            return
+        if CONFIG.COIL_ON_FRACTION < 1.0 and self.frequency:
+            await self.sleep(CONFIG.COIL_ON_FRACTION / self.frequency)
+            self.zero_coils()
+
+    def zero_coils(self):
+        if AD.coils_on:
+            zero_all_coils()
+
     # ------------------------------------------------------------------------------------------------------------------------------------
     """ Attitude Control Auxiliary Functions """
 
     # ------------------------------------------------------------------------------------------------------------------------------------
     def attitude_control(self):
         """
-        Performs attitude control on the spacecraft
+        Performs attitude control on the spacecraft, returns True if the coils were driven
         """
 
         # Decide which controller to choose
-        if self.MODE in [Modes.TUMBLING, Modes.STABLE]:  # B-cross controller
+        if AD.MODE in [Modes.TUMBLING, Modes.STABLE]:  # B-cross controller
 
-            if self.gyro_status != StatusConst.OK or self.mag_status != StatusConst.OK:
-                return
+            if AD.gyro_status != StatusConst.OK or AD.mag_status != StatusConst.OK:
+                return False
 
             # Control MCMs and obtain coil statuses
-            dipole_moment = spin_stabilizing_controller(self.gyro_data, self.mag_data)
+            dipole_moment = spin_stabilizing_controller(AD.gyro_data, AD.mag_data)
 
-        elif self.MODE == Modes.SUN_POINTED:  # Sun-pointed controller
+        elif AD.MODE == Modes.SUN_POINTED:  # Sun-pointed controller
 
             # Perform ACS iff a sun vector measurement is valid
             # i.e., ignore eclipses, insufficient readings etc.
-            if self.gyro_status != StatusConst.OK or self.mag_status != StatusConst.OK or self.sun_status != StatusConst.OK:
-                return
+            if AD.gyro_status != StatusConst.OK or AD.mag_status != StatusConst.OK or AD.sun_status != StatusConst.OK:
+                return False
 
             # Control MCMs and obtain coil statuses
-            dipole_moment = sun_pointing_controller(self.sun_pos_body, self.gyro_data, self.mag_data)
+            dipole_moment = sun_pointing_controller(AD.sun_pos_body, AD.gyro_data, AD.mag_data)
         else:
             # If in ACS_OFF or any other mode, do not control MCMs
             # Just zero out the dipole moment
             dipole_moment = np.zeros((3,))
 
-        self.coil_status = mcm_coil_allocator(dipole_moment, self.mag_data)
+        AD.coil_status = mcm_coil_allocator(dipole_moment / CONFIG.COIL_ON_FRACTION, AD.mag_data)
+        return True
 
     # ------------------------------------------------------------------------------------------------------------------------------------
     """ LOGGING """
@@ -207,43 +183,48 @@ class Task(TemplateTask):
         Logs data to Data Handler
         Takes light sensor readings as input since they are not stored in AD
         """
-        self.log_data[ADCS_IDX.MODE] = int(self.MODE)
-        self.log_data[ADCS_IDX.GYRO_X] = self.gyro_data[0]
-        self.log_data[ADCS_IDX.GYRO_Y] = self.gyro_data[1]
-        self.log_data[ADCS_IDX.GYRO_Z] = self.gyro_data[2]
-        self.log_data[ADCS_IDX.MAG_X] = self.mag_data[0]
-        self.log_data[ADCS_IDX.MAG_Y] = self.mag_data[1]
-        self.log_data[ADCS_IDX.MAG_Z] = self.mag_data[2]
-        self.log_data[ADCS_IDX.SUN_STATUS] = int(self.sun_status)
-        self.log_data[ADCS_IDX.SUN_VEC_X] = self.sun_pos_body[0]
-        self.log_data[ADCS_IDX.SUN_VEC_Y] = self.sun_pos_body[1]
-        self.log_data[ADCS_IDX.SUN_VEC_Z] = self.sun_pos_body[2]
-        self.log_data[ADCS_IDX.LIGHT_SENSOR_XM] = int(self.sun_lux[0]) & 0xFFFF
-        self.log_data[ADCS_IDX.LIGHT_SENSOR_XP] = int(self.sun_lux[1]) & 0xFFFF
-        self.log_data[ADCS_IDX.LIGHT_SENSOR_YM] = int(self.sun_lux[2]) & 0xFFFF
-        self.log_data[ADCS_IDX.LIGHT_SENSOR_YP] = int(self.sun_lux[3]) & 0xFFFF
-        self.log_data[ADCS_IDX.LIGHT_SENSOR_ZM] = int(self.sun_lux[4]) & 0xFFFF
-        self.log_data[ADCS_IDX.LIGHT_SENSOR_ZP_XP] = int(self.sun_lux[5]) & 0xFFFF
-        self.log_data[ADCS_IDX.LIGHT_SENSOR_ZP_YM] = int(self.sun_lux[6]) & 0xFFFF
-        self.log_data[ADCS_IDX.LIGHT_SENSOR_ZP_XM] = int(self.sun_lux[7]) & 0xFFFF
-        self.log_data[ADCS_IDX.LIGHT_SENSOR_ZP_YP] = int(self.sun_lux[8]) & 0xFFFF
-        self.log_data[ADCS_IDX.XP_COIL_STATUS] = int(self.coil_status[0])
-        self.log_data[ADCS_IDX.XM_COIL_STATUS] = int(self.coil_status[1])
-        self.log_data[ADCS_IDX.YP_COIL_STATUS] = int(self.coil_status[2])
-        self.log_data[ADCS_IDX.YM_COIL_STATUS] = int(self.coil_status[3])
-        self.log_data[ADCS_IDX.ZP_COIL_STATUS] = int(self.coil_status[4])
-        self.log_data[ADCS_IDX.ZM_COIL_STATUS] = int(self.coil_status[5])
+        self.log_data[ADCS_IDX.MODE] = int(AD.MODE)
+        self.log_data[ADCS_IDX.GYRO_X] = AD.gyro_data[0]
+        self.log_data[ADCS_IDX.GYRO_Y] = AD.gyro_data[1]
+        self.log_data[ADCS_IDX.GYRO_Z] = AD.gyro_data[2]
+        self.log_data[ADCS_IDX.MAG_X] = AD.mag_data[0]
+        self.log_data[ADCS_IDX.MAG_Y] = AD.mag_data[1]
+        self.log_data[ADCS_IDX.MAG_Z] = AD.mag_data[2]
+        self.log_data[ADCS_IDX.SUN_STATUS] = int(AD.sun_status)
+        self.log_data[ADCS_IDX.SUN_VEC_X] = AD.sun_pos_body[0]
+        self.log_data[ADCS_IDX.SUN_VEC_Y] = AD.sun_pos_body[1]
+        self.log_data[ADCS_IDX.SUN_VEC_Z] = AD.sun_pos_body[2]
+        self.log_data[ADCS_IDX.LIGHT_SENSOR_XM] = int(AD.sun_lux[0]) & 0xFFFF
+        self.log_data[ADCS_IDX.LIGHT_SENSOR_XP] = int(AD.sun_lux[1]) & 0xFFFF
+        self.log_data[ADCS_IDX.LIGHT_SENSOR_YM] = int(AD.sun_lux[2]) & 0xFFFF
+        self.log_data[ADCS_IDX.LIGHT_SENSOR_YP] = int(AD.sun_lux[3]) & 0xFFFF
+        self.log_data[ADCS_IDX.LIGHT_SENSOR_ZM] = int(AD.sun_lux[4]) & 0xFFFF
+        self.log_data[ADCS_IDX.LIGHT_SENSOR_ZP_XP] = int(AD.sun_lux[5]) & 0xFFFF
+        self.log_data[ADCS_IDX.LIGHT_SENSOR_ZP_YM] = int(AD.sun_lux[6]) & 0xFFFF
+        self.log_data[ADCS_IDX.LIGHT_SENSOR_ZP_XM] = int(AD.sun_lux[7]) & 0xFFFF
+        self.log_data[ADCS_IDX.LIGHT_SENSOR_ZP_YP] = int(AD.sun_lux[8]) & 0xFFFF
+        self.log_data[ADCS_IDX.XP_COIL_STATUS] = int(AD.coil_status[0])
+        self.log_data[ADCS_IDX.XM_COIL_STATUS] = int(AD.coil_status[1])
+        self.log_data[ADCS_IDX.YP_COIL_STATUS] = int(AD.coil_status[2])
+        self.log_data[ADCS_IDX.YM_COIL_STATUS] = int(AD.coil_status[3])
+        self.log_data[ADCS_IDX.ZP_COIL_STATUS] = int(AD.coil_status[4])
+        self.log_data[ADCS_IDX.ZM_COIL_STATUS] = int(AD.coil_status[5])
+        # Identity while the attitude is unknown
+        self.log_data[ADCS_IDX.ATTITUDE_QW] = AD.attitude_q[0]
+        self.log_data[ADCS_IDX.ATTITUDE_QX] = AD.attitude_q[1]
+        self.log_data[ADCS_IDX.ATTITUDE_QY] = AD.attitude_q[2]
+        self.log_data[ADCS_IDX.ATTITUDE_QZ] = AD.attitude_q[3]
         DH.log_data("adcs", self.log_data)
 
         # Log Gyro Angular Velocities
-        self.log_info(f"ADCS Mode : {self.MODE}")
-        self.log_info(f"Gyro Ang Vel : {self.gyro_data}")
+        self.log_info(f"ADCS Mode : {AD.MODE}")
+        self.log_info(f"Gyro Ang Vel : {AD.gyro_data}")
         # [TODO:] Remove later
         self.log_info(f"Mag Field : {self.log_data[ADCS_IDX.MAG_X:ADCS_IDX.MAG_Z + 1]}")
         self.log_info(f"Sun Vector : {self.log_data[ADCS_IDX.SUN_VEC_X:ADCS_IDX.SUN_VEC_Z + 1]}")
         self.log_info(f"Sun Status : {self.log_data[ADCS_IDX.SUN_STATUS]}")
-        self.log_info(f"Gyro Status : {self.gyro_status}")
-        self.log_info(f"Mag Status : {self.mag_status}")
+        self.log_info(f"Gyro Status : {AD.gyro_status}")
+        self.log_info(f"Mag Status : {AD.mag_status}")
 
         # from hal.configuration import SATELLITE
         # from ulab import numpy as np
@@ -0,0 +1,87 @@
+# ADCS gyro loop: angular rate and sun sensing, and attitude estimation
+
+import time
+
+import apps.adcs.sensors as sensors
+from apps.adcs.consts import StatusConst
+from apps.adcs.environment import reference_vectors
+from apps.adcs.mekf import MEKF
+from apps.adcs.shared_state import ADCSState as AD
+from core import TemplateTask
+from core import state_manager as SM
+from core.states import STATES
+from core.time_processor import TimeProcessor as TPM
+from ulab import numpy as np
+
+# 1-sigma direction errors of the estimator measurements
+_SIGMA_SUN = 0.05  # rad, sun vector from the light sensors
+_SIGMA_MAG = 0.09  # rad, magnetometer against the dipole field model
+
+
+class Task(TemplateTask):
+    def __init__(self, id):
+        super().__init__(id)
+        self.name = "ADCS_GYRO"  # Override the name
+        self.estimator = MEKF()
+        self.last_gyro_ns = None
+        self.mag_count = 0
+
+    async def main_task(self):
+        if SM.current_state == STATES.STARTUP or SM.current_state == STATES.LOW_POWER:
+            self.reset_estimator()
+            return
+
+        status, gyro = sensors.read_gyro()
+        now_ns = time.monotonic_ns()
+        AD.set_gyro(status, gyro, TPM.time())
+
+        # The sun vector and the attitude are not used to detumble
+        if SM.current_state == STATES.DETUMBLING:
+            self.reset_estimator()
+        else:
+            AD.set_sun(*sensors.read_sun_position())
+            self.estimate_attitude(now_ns)
+
+    def reset_estimator(self):
+        self.estimator.reset()
+        self.last_gyro_ns = None
+        # Publishes the identity quaternion logged while the attitude is unknown
+        AD.set_attitude(False, self.estimator.q, self.estimator.bias)
+
+    def estimate_attitude(self, now_ns):
+        """
+        Propagates the attitude estimate with the gyro on every cycle, and updates it with the sun and magnetic field
+        directions when the magnetometer loop took a new sample.
+        """
+        estimator = self.estimator
+        if AD.gyro_status != StatusConst.OK:
+            self.reset_estimator()
+            return
+        if self.last_gyro_ns is not None:
+            estimator.propagate(AD.gyro_data, (now_ns - self.last_gyro_ns) * 1e-9)
+        self.last_gyro_ns = now_ns
+
+        if AD.mag_count != self.mag_count:
+            self.mag_count = AD.mag_count
+            if AD.mag_status == StatusConst.OK:
+                self.update_attitude()
+
+        AD.set_attitude(estimator.initialized, estimator.q, estimator.bias)
+
+    def update_attitude(self):
+        sun_eci, field_eci = reference_vectors(TPM.time())
+        if field_eci is None:
+            return
+
+        field_body = AD.mag_data / np.linalg.norm(AD.mag_data)
+        sun_valid = AD.sun_status == StatusConst.OK
+        if not self.estimator.initialized:
+            # Both directions are needed for the first fix
+            if sun_valid:
+                self.estimator.initialize(AD.sun_pos_body, sun_eci, field_body, field_eci)
+            return
+
+        # Sequential update, the field alone keeps the estimate through eclipses
+        if sun_valid:
+            self.estimator.update_vector(AD.sun_pos_body, sun_eci, _SIGMA_SUN)
+        self.estimator.update_vector(field_body, field_eci, _SIGMA_MAG)
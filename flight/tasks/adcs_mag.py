@@ -0,0 +1,104 @@
+# ADCS magnetometer loop: samples the magnetic field in a coil-off window and calibrates the magnetometer
+
+import time
+
+import apps.adcs.sensors as sensors
+from apps.adcs.acs import zero_all_coils
+from apps.adcs.consts import StatusConst
+from apps.adcs.environment import field_strength
+from apps.adcs.mag_calibration import MagCalibration
+from apps.adcs.shared_state import ADCSState
+from core import DataHandler as DH
+from core import DataRecord
+from core import TemplateTask
+from core import state_manager as SM
+from core.dh_constants import MAG_CAL_IDX
+from core.schemas import mag_cal as MAG_CAL_SCHEMA
+from core.states import STATES
+from core.time_processor import TimeProcessor as TPM
+
+"""
+    The magnetorquer field corrupts the magnetometer reading. The coils are held off by the actuation loop
+    (coil_hold_off) from the moment they are zeroed until the sample is taken, and the sample is the first one
+    converted entirely after the coils went off: the magnetometer converts at 25 Hz, so the conversion in progress
+    when the coils are zeroed is discarded by waiting two conversion periods (the coil current decays in a few ms).
+    Coils found off were possibly zeroed just before by the actuation duty cycle, only the rest of the wait is done.
+
+    The raw coil-off samples feed the onboard calibration (apps/adcs/mag_calibration.py). Each accepted fit is logged to
+    the "mag_cal" data process, whose latest record is applied again after a reboot.
+"""
+
+_COIL_OFF_SETTLE_S = 0.08
+
+
+class Task(TemplateTask):
+    log_data = DataRecord(MAG_CAL_SCHEMA)
+
+    def __init__(self, id):
+        super().__init__(id)
+        self.name = "ADCS_MAG"  # Override the name
+
+    async def main_task(self):
+        if SM.current_state == STATES.STARTUP or SM.current_state == STATES.LOW_POWER:
+            return
+
+        if not DH.data_process_exists("mag_cal"):
+            DH.register_data_process("mag_cal", MAG_CAL_SCHEMA.FORMAT, True, data_limit=10000)
+            self.restore_calibration()
+
+        ADCSState.coil_hold_off = True
+        try:
+            if ADCSState.coils_on:
+                zero_all_coils()
+            settle_s = _COIL_OFF_SETTLE_S - (time.monotonic_ns() - ADCSState.coils_off_ns) * 1e-9
+            if settle_s > 0:
+                await self.sleep(settle_s)
+
+            status, mag = sensors.read_magnetometer(averaged=False)
+            ADCSState.set_mag(status, mag, TPM.time())
+        finally:
+            ADCSState.coil_hold_off = False
+
+        if status == StatusConst.OK:
+            self.calibrate(ADCSState.mag_time)
+
+    def calibrate(self, unix_time):
+        """Adds the raw sample to the calibration window, and logs the calibration if a new fit was applied."""
+        strength = field_strength(unix_time)
+        if strength is None or not MagCalibration.add_sample(MagCalibration.last_raw, strength, unix_time):
+            return
+
+        offset, a = MagCalibration.offset, MagCalibration.soft_iron
+        self.log_data[MAG_CAL_IDX.TIME_MAG_CAL] = unix_time
+        self.log_data[MAG_CAL_IDX.SAMPLES] = MagCalibration.samples
+        self.log_data[MAG_CAL_IDX.OFFSET_X] = offset[0]
+        self.log_data[MAG_CAL_IDX.OFFSET_Y] = offset[1]
+        self.log_data[MAG_CAL_IDX.OFFSET_Z] = offset[2]
+        self.log_data[MAG_CAL_IDX.SOFT_IRON_XX] = a[0, 0]
+        self.log_data[MAG_CAL_IDX.SOFT_IRON_XY] = a[0, 1]
+        self.log_data[MAG_CAL_IDX.SOFT_IRON_XZ] = a[0, 2]
+        self.log_data[MAG_CAL_IDX.SOFT_IRON_YY] = a[1, 1]
+        self.log_data[MAG_CAL_IDX.SOFT_IRON_YZ] = a[1, 2]
+        self.log_data[MAG_CAL_IDX.SOFT_IRON_ZZ] = a[2, 2]
+        self.log_data[MAG_CAL_IDX.RESIDUAL] = MagCalibration.residual
+        DH.log_data("mag_cal", self.log_data)
+        self.log_info(f"Magnetometer calibration updated, offset {offset}, residual {MagCalibration.residual}")
+
+    def restore_calibration(self):
+        data = DH.get_latest_data("mag_cal")
+        if data is None:
+            return
+        MagCalibration.load(
+            (data[MAG_CAL_IDX.OFFSET_X], data[MAG_CAL_IDX.OFFSET_Y], data[MAG_CAL_IDX.OFFSET_Z]),
+            (
+                data[MAG_CAL_IDX.SOFT_IRON_XX],
+                data[MAG_CAL_IDX.SOFT_IRON_XY],
+                data[MAG_CAL_IDX.SOFT_IRON_XZ],
+                data[MAG_CAL_IDX.SOFT_IRON_YY],
+                data[MAG_CAL_IDX.SOFT_IRON_YZ],
+                data[MAG_CAL_IDX.SOFT_IRON_ZZ],
+            ),
+            data[MAG_CAL_IDX.SAMPLES],
+            data[MAG_CAL_IDX.RESIDUAL],
+        )
+        self.log_info(f"Magnetometer calibration restored, offset {MagCalibration.offset}")
@@ -19,6 +19,7 @@ from core.logging import LEVELS as LOG_LEVELS
 from core.logging import Formatter, RotatingFileHandler, get_persisted_level_name, getLogger
 from core.satellite_config import command_config as CONFIG
 from core.satellite_config import log_config as LOG_CONFIG
+from core.schemas import cdh as CDH_SCHEMA
 from core.states import STATES, STR_STATES
 from core.time_processor import TimeProcessor as TPM
 from hal.configuration import SATELLITE
@@ -131,8 +132,7 @@ class Task(TemplateTask):
         # Restore boot count from previous session
         if not self.restored:
             if not DH.data_process_exists("cdh"):
-                data_format = "LLbLbbbbb"
-                DH.register_data_process("cdh", data_format, True, data_limit=100000)
+                DH.register_data_process("cdh", CDH_SCHEMA.FORMAT, True, data_limit=100000)
 
             if SATELLITE.SD_CARD_AVAILABLE:
                 cdh_data = DH.data_process_registry["cdh"].get_latest_data()
@@ -193,8 +193,7 @@ class Task(TemplateTask):
             # If the DH successfully scanned the SD card, and it has been 5 secs since FSW boot
             if DH.SD_SCANNED() and time_since_boot > _EXIT_STARTUP_TIMEOUT:
                 if not DH.data_process_exists("cdh"):
-                    data_format = "LLbLbbbbb"
-                    DH.register_data_process("cdh", data_format, True, data_limit=100000)
+                    DH.register_data_process("cdh", CDH_SCHEMA.FORMAT, True, data_limit=100000)
 
                 if not DH.data_process_exists("cmd_logs"):
                     DH.register_data_process("cmd_logs", "LBB", True, data_limit=100000)
@@ -509,6 +508,9 @@ class Task(TemplateTask):
             # Execute state machine
             self.state_machine_execution()
 
+            # Throttle low priority tasks if the loop is over its CPU budget
+            SM.govern_cpu_budget()
+
             # Set CDH log data
             self.log_data[CDH_IDX.TIME] = TPM.time()
             self.log_data[CDH_IDX.BOOT_TIME] = TPM.monotonic() - SATELLITE.BOOTTIME
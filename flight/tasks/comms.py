@@ -4,6 +4,8 @@ from apps.command.supervisor import CommandSupervisor
 from apps.comms.comms import SATELLITE_RADIO
 from apps.comms.fifo import TransmitQueue
 from apps.comms.modes import COMMS_MODE
+from apps.comms.passes import PassPredictor
+from apps.digipeater import DigipeaterState
 from apps.telemetry.middleware import Frame as TelemetryFrame  # this will substitute for the old telemetry packer
 from apps.telemetry.splat.splat.telemetry_codec import Command, pack  # this should be implemented in middleware
 from core import TemplateTask
@@ -11,6 +13,7 @@ from core import state_manager as SM
 from core.data_handler import DataHandler as DH
 from core.dh_constants import COMMS_IDX
 from core.scheduler import sleep
+from core.schemas import comms as COMMS_SCHEMA
 from core.states import STATES
 from core.time_processor import TimeProcessor as TPM
 
@@ -35,6 +38,9 @@ class Task(TemplateTask):
         )  # the packing function of the report to be downlinked periodically
         self.last_periodic_telemetry_time = TPM.time()  # timestamp of the last periodic telemetry downlink
 
+        # Predicted ground station visibility, True until the pass predictor says otherwise
+        self.in_pass = True
+
         # Initialize log_data array for telemetry
         self.log_data = [0] * 11  # 11 COMMS variables
 
@@ -62,7 +68,8 @@ class Task(TemplateTask):
             packet, queue_error_code = TransmitQueue.pop_packet()
             if queue_error_code == QUEUE_STATUS.OK:
                 packed_packet = pack(packet, callsign=SATELLITE_RADIO.SC_CALLSIGN)   # changed and the entries in transmitqueue are no longer packed
-                SATELLITE_RADIO.transmit_message(packed_packet)
+                # Blocks for the time on air
+                self.blocking_io(SATELLITE_RADIO.transmit_message, packed_packet)
             else:
                 self.log_error("Error popping packet from TransmitQueue")
             sent_in_burst += 1
@@ -94,6 +101,25 @@ class Task(TemplateTask):
                 message_object
             )  # [TODO] - not sure why overwrite instead of push, i copied this from the old code
 
+    def update_radio_profile(self):
+        """
+        Advances the pass prediction and selects the radio power profile.
+        In-pass (or without a valid prediction) the radio listens continuously and heartbeats go out every HB_PERIOD,
+        out of pass heartbeats drop to HB_PERIOD_OUT_OF_PASS and the radio sleeps between them.
+        The prediction windows carry a margin, the radio is awake again by the predicted AOS.
+        The digipeater needs RX anywhere on the orbit, the radio stays awake while it is active.
+        """
+        current_time = TPM.time()
+        PassPredictor.update(current_time)
+
+        in_pass = PassPredictor.in_pass(current_time) is not False
+        if in_pass != self.in_pass:
+            self.log_info("Ground station pass started" if in_pass else "Ground station pass ended")
+            self.in_pass = in_pass
+            self.periodic_telemetry_interval = SATELLITE_RADIO.HB_PERIOD if in_pass else SATELLITE_RADIO.HB_PERIOD_OUT_OF_PASS
+
+        SATELLITE_RADIO.set_rx_profile(asleep=not in_pass and not DigipeaterState.is_active())
+
     def check_periodic_telemetry(self):
         """
         Checks if it's time to send periodic telemetry, and if so, prepares the telemetry report for downlink.
@@ -142,10 +168,11 @@ class Task(TemplateTask):
 
         # Register COMMS data process if it doesn't exist
         if not DH.data_process_exists("comms"):
-            data_format = "HHHHHHHHHHe"
-            DH.register_data_process("comms", data_format, True, data_limit=100000, write_interval=5)
+            DH.register_data_process("comms", COMMS_SCHEMA.FORMAT, True, data_limit=100000, write_interval=5)
 
+        self.update_radio_profile()  # sleep the radio out of predicted ground station passes
         self.check_periodic_telemetry()  # check if it's time to send periodic telemetry
         await self.transmit_message()  # check if we have messages to transmit to GS
-        self.receive_message()  # check if we have received messages from GS
+        if not SATELLITE_RADIO.rx_asleep:
+            self.receive_message()  # check if we have received messages from GS
         CommandSupervisor.process_pending_action()   # TODO - should be its own task. Keeping this way because of time constraints
@@ -47,7 +47,7 @@ class Task(TemplateTask):
     async def main_task(self):
 
         # print digipeater status
-        self.log_info(f"RX queue: {DigipeaterRxQueue.get_size()}")
+        self.log_info(f"RX queue: {DigipeaterRxQueue.get_size()}, dropped: {DigipeaterRxQueue.get_drop_count()}")
 
         while DigipeaterRxQueue.packet_available():
             raw_packet, status = DigipeaterRxQueue.pop_packet()
@@ -66,5 +66,5 @@ class Task(TemplateTask):
             final_packet = add_asterisk_packet(raw_packet, self._satellite_cs_re)
 
             # Transmit using special transmit digi packet function
-            if not SATELLITE_RADIO.transmit_digi_packet(final_packet):
+            if not self.blocking_io(SATELLITE_RADIO.transmit_digi_packet, final_packet):
                 self.log_warning("Digipeater TX failed (RF_STOP or radio unavailable)")
@@ -10,15 +10,16 @@ from apps.eps.eps import (
     SHOULD_ENABLE_HEATERS,
 )
 from core import DataHandler as DH
+from core import DataRecord
 from core import TemplateTask
 from core import state_manager as SM
-from core.dh_constants import EPS_IDX, EPS_WARNING_IDX, class_length
+from core.dh_constants import EPS_IDX, EPS_WARNING_IDX
+from core.schemas import eps as EPS_SCHEMA
+from core.schemas import eps_warning as EPS_WARNING_SCHEMA
 from core.states import STATES
 from core.time_processor import TimeProcessor as TPM
 from hal.configuration import SATELLITE
 
-IDX_LENGTH = class_length(EPS_IDX)
-WARNING_IDX_LENGTH = class_length(EPS_WARNING_IDX)
 FUEL_GAUGE_LOG_FREQ = 5  # log fuel gauge readings every 5 seconds
 MAINBOARD_TEMP_OFFSET = 200  # offset of mainboard temperature to battery pack temp in cC
 
@@ -75,8 +76,8 @@ class Task(TemplateTask):
         "BATTERY_HEATERS2_ENABLED",
     ]"""
 
-    log_data = [0] * IDX_LENGTH  # - use mV for voltage and mA for current (h = short integer 2 bytes)
-    warning_log_data = [0] * WARNING_IDX_LENGTH
+    log_data = DataRecord(EPS_SCHEMA)  # - use mV for voltage and mA for current (h = short integer 2 bytes)
+    warning_log_data = DataRecord(EPS_WARNING_SCHEMA)
     power_buffer_dict = {
         EPS_WARNING_IDX.MAINBOARD_POWER_ALERT: [],
         EPS_WARNING_IDX.PERIPHERAL_POWER_ALERT: [],
@@ -260,14 +261,10 @@ class Task(TemplateTask):
 
         else:
             if not DH.data_process_exists("eps"):
-                data_format = (
-                    "Lb" + "h" * 7 + "b" + "h" * 4 + "L" * 2 + "h" * 26 + "b" * 2
-                )  # - use mV for voltage and mA for current (h = short integer 2 bytes, L = 4 bytes)
-                DH.register_data_process("eps", data_format, True, data_limit=1000000, write_interval=5)
+                DH.register_data_process("eps", EPS_SCHEMA.FORMAT, True, data_limit=1000000, write_interval=5)
 
             if not DH.data_process_exists("eps_warning"):
-                data_format = "L" + "b" * (WARNING_IDX_LENGTH - 1)
-                DH.register_data_process("eps_warning", data_format, True, data_limit=10000)
+                DH.register_data_process("eps_warning", EPS_WARNING_SCHEMA.FORMAT, True, data_limit=10000)
 
             # Get power system readings
 
@@ -1,9 +1,11 @@
 # GPS Task
 
 from core import DataHandler as DH
+from core import DataRecord
 from core import TemplateTask
 from core import state_manager as SM
 from core.dh_constants import GPS_IDX
+from core.schemas import gps as GPS_SCHEMA
 from core.states import STATES
 from core.time_processor import TimeProcessor as TPM
 from hal.configuration import SATELLITE
@@ -50,9 +52,12 @@ class Task(TemplateTask):
         "GPS_ECEF_VX",
         "GPS_ECEF_VY",
         "GPS_ECEF_VZ",
-    ]"""
+    ]
 
-    log_data = [0] * 18
+    ECEF position and velocity are logged in cm and cm/s.
+    """
+
+    log_data = DataRecord(GPS_SCHEMA)
 
     def __init__(self, id):
         super().__init__(id)
@@ -65,8 +70,7 @@ class Task(TemplateTask):
         else:
             if SATELLITE.GPS_AVAILABLE:
                 if not DH.data_process_exists("gps"):
-                    data_format = "LBBIBHIHHHHHllllll"
-                    DH.register_data_process("gps", data_format, True, data_limit=100000, write_interval=1)
+                    DH.register_data_process("gps", GPS_SCHEMA.FORMAT, True, data_limit=100000, write_interval=1)
 
                 # Check if the module sent a valid nav data message
                 if SATELLITE.GPS.update():
@@ -84,12 +88,12 @@ class Task(TemplateTask):
                         self.log_data[GPS_IDX.GPS_HDOP] = int(SATELLITE.GPS.hdop)
                         self.log_data[GPS_IDX.GPS_VDOP] = int(SATELLITE.GPS.vdop)
                         self.log_data[GPS_IDX.GPS_TDOP] = int(SATELLITE.GPS.tdop)
-                        self.log_data[GPS_IDX.GPS_ECEF_X] = int(SATELLITE.GPS.ecef_x)
-                        self.log_data[GPS_IDX.GPS_ECEF_Y] = int(SATELLITE.GPS.ecef_y)
-                        self.log_data[GPS_IDX.GPS_ECEF_Z] = int(SATELLITE.GPS.ecef_z)
-                        self.log_data[GPS_IDX.GPS_ECEF_VX] = int(SATELLITE.GPS.ecef_vx)
-                        self.log_data[GPS_IDX.GPS_ECEF_VY] = int(SATELLITE.GPS.ecef_vy)
-                        self.log_data[GPS_IDX.GPS_ECEF_VZ] = int(SATELLITE.GPS.ecef_vz)
+                        self.log_data[GPS_IDX.GPS_ECEF_X] = int(SATELLITE.GPS.ecef_x * 100)
+                        self.log_data[GPS_IDX.GPS_ECEF_Y] = int(SATELLITE.GPS.ecef_y * 100)
+                        self.log_data[GPS_IDX.GPS_ECEF_Z] = int(SATELLITE.GPS.ecef_z * 100)
+                        self.log_data[GPS_IDX.GPS_ECEF_VX] = int(SATELLITE.GPS.ecef_vx * 100)
+                        self.log_data[GPS_IDX.GPS_ECEF_VY] = int(SATELLITE.GPS.ecef_vy * 100)
+                        self.log_data[GPS_IDX.GPS_ECEF_VZ] = int(SATELLITE.GPS.ecef_vz * 100)
 
                         # Log the current sample after log_data has been updated.
                         self.log_info("GPS module got a valid fix")
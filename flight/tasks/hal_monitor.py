@@ -7,9 +7,11 @@
 # more than 24 hours since the last reboot.
 
 from core import DataHandler as DH
+from core import DataRecord
 from core import TemplateTask
 from core import state_manager as SM
-from core.dh_constants import HAL_IDX, class_length
+from core.dh_constants import HAL_IDX
+from core.schemas import hal as HAL_SCHEMA
 from core.satellite_config import hal_monitor_config as CONFIG
 from core.states import STATES
 from core.time_processor import TimeProcessor as TPM
@@ -17,7 +19,6 @@ from hal.configuration import SATELLITE
 from hal.drivers.errors import Errors
 from micropython import const
 
-_IDX_LENGTH = class_length(HAL_IDX)
 _REGULAR_REBOOT_TIME = CONFIG.REGULAR_REBOOT
 _PERIPH_REBOOT_COUNT_IDX = getattr(HAL_IDX, "PERIPH_REBOOT_COUNT")
 _HAL_IDX_INV = {v: k for k, v in HAL_IDX.__dict__.items()}
@@ -31,7 +32,7 @@ class Task(TemplateTask):
         super().__init__(id)
         self.name = "HAL_MONITOR"
         self.log_name = "hal"
-        self.log_data = [0] * _IDX_LENGTH
+        self.log_data = DataRecord(HAL_SCHEMA)
         self.restored = False
         self.peripheral_reboot_count = 0
         self.graceful_reboot = False
@@ -131,13 +132,12 @@ class Task(TemplateTask):
             self.log_error(f"Invalid device name {device_name}")
 
     async def main_task(self):
-        self.log_data = [0] * _IDX_LENGTH
+        self.log_data.clear()
         self.log_data[HAL_IDX.TIME_HAL] = TPM.time()
 
         if SM.current_state == STATES.STARTUP:
             if not DH.data_process_exists(self.log_name):
-                data_format = "L" + "B" * (_IDX_LENGTH - 1)
-                DH.register_data_process(self.log_name, data_format, True, data_limit=10000)
+                DH.register_data_process(self.log_name, HAL_SCHEMA.FORMAT, True, data_limit=10000)
 
             # restore previous device status
             if not self.restored:
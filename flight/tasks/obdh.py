@@ -1,9 +1,66 @@
 # Onboard Data Handling (OBDH) Task
 
+import gc
+
 from core import DataHandler as DH
+from core import DataRecord
 from core import TemplateTask
 from core import state_manager as SM
-from core.states import STATES
+from core.dh_constants import MEM_IDX, SCHED_IDX
+from core.scheduler import utilisation as budgeted_utilisation
+from core.schemas import mem as MEM_SCHEMA
+from core.schemas import sched as SCHED_SCHEMA
+from core.states import STATES, TASK
+from core.time_processor import TimeProcessor as TPM
+
+# (task id, heap allocation rate index, peak cycle allocation index) in the mem data process
+_MEM_TASK_IDX = (
+    (TASK.COMMAND, MEM_IDX.COMMAND_ALLOC_RATE, MEM_IDX.COMMAND_ALLOC_PEAK),
+    (TASK.WATCHDOG, MEM_IDX.WATCHDOG_ALLOC_RATE, MEM_IDX.WATCHDOG_ALLOC_PEAK),
+    (TASK.EPS, MEM_IDX.EPS_ALLOC_RATE, MEM_IDX.EPS_ALLOC_PEAK),
+    (TASK.OBDH, MEM_IDX.OBDH_ALLOC_RATE, MEM_IDX.OBDH_ALLOC_PEAK),
+    (TASK.COMMS, MEM_IDX.COMMS_ALLOC_RATE, MEM_IDX.COMMS_ALLOC_PEAK),
+    (TASK.ADCS, MEM_IDX.ADCS_ALLOC_RATE, MEM_IDX.ADCS_ALLOC_PEAK),
+    (TASK.GPS, MEM_IDX.GPS_ALLOC_RATE, MEM_IDX.GPS_ALLOC_PEAK),
+    (TASK.PAYLOAD, MEM_IDX.PAYLOAD_ALLOC_RATE, MEM_IDX.PAYLOAD_ALLOC_PEAK),
+    (TASK.HAL_MONITOR, MEM_IDX.HAL_MONITOR_ALLOC_RATE, MEM_IDX.HAL_MONITOR_ALLOC_PEAK),
+    (TASK.DIGIPEATER, MEM_IDX.DIGIPEATER_ALLOC_RATE, MEM_IDX.DIGIPEATER_ALLOC_PEAK),
+    (TASK.ADCS_GYRO, MEM_IDX.ADCS_GYRO_ALLOC_RATE, MEM_IDX.ADCS_GYRO_ALLOC_PEAK),
+    (TASK.ADCS_MAG, MEM_IDX.ADCS_MAG_ALLOC_RATE, MEM_IDX.ADCS_MAG_ALLOC_PEAK),
+)
+
+# (task id, overruns index, skipped releases index) in the sched data process
+_SCHED_TASK_IDX = (
+    (TASK.COMMAND, SCHED_IDX.COMMAND_OVERRUNS, SCHED_IDX.COMMAND_SKIPPED),
+    (TASK.WATCHDOG, SCHED_IDX.WATCHDOG_OVERRUNS, SCHED_IDX.WATCHDOG_SKIPPED),
+    (TASK.EPS, SCHED_IDX.EPS_OVERRUNS, SCHED_IDX.EPS_SKIPPED),
+    (TASK.OBDH, SCHED_IDX.OBDH_OVERRUNS, SCHED_IDX.OBDH_SKIPPED),
+    (TASK.COMMS, SCHED_IDX.COMMS_OVERRUNS, SCHED_IDX.COMMS_SKIPPED),
+    (TASK.ADCS_GYRO, SCHED_IDX.ADCS_GYRO_OVERRUNS, SCHED_IDX.ADCS_GYRO_SKIPPED),
+    (TASK.ADCS_MAG, SCHED_IDX.ADCS_MAG_OVERRUNS, SCHED_IDX.ADCS_MAG_SKIPPED),
+    (TASK.ADCS, SCHED_IDX.ADCS_OVERRUNS, SCHED_IDX.ADCS_SKIPPED),
+    (TASK.GPS, SCHED_IDX.GPS_OVERRUNS, SCHED_IDX.GPS_SKIPPED),
+    (TASK.PAYLOAD, SCHED_IDX.PAYLOAD_OVERRUNS, SCHED_IDX.PAYLOAD_SKIPPED),
+    (TASK.HAL_MONITOR, SCHED_IDX.HAL_MONITOR_OVERRUNS, SCHED_IDX.HAL_MONITOR_SKIPPED),
+    (TASK.DIGIPEATER, SCHED_IDX.DIGIPEATER_OVERRUNS, SCHED_IDX.DIGIPEATER_SKIPPED),
+)
+
+
+def largest_free_block():
+    """
+    Size of the largest heap block that can be allocated, found by bisection on bytearray allocations.
+    Each probe is released right away; a failed probe costs a heap collection, so call sparingly.
+    """
+    low = 0
+    high = gc.mem_free()
+    while low < high:
+        size = (low + high + 1) // 2
+        try:
+            bytearray(size)
+            low = size
+        except MemoryError:
+            high = size - 1
+    return low
 
 
 class Task(TemplateTask):
@@ -15,6 +72,74 @@ class Task(TemplateTask):
         self.name = "OBDH"
         self.CLEANUP_COUNT_THRESHOLD = 0
         self.CLEANUP_COUNTER = 0
+        self.mem_log_data = DataRecord(MEM_SCHEMA)
+        self.mem_alloc_ref = {}  # task id -> cumulative allocation at the last mem record
+        self.mem_gc_ref = 0
+        self.mem_time_ref = None
+        self.sched_log_data = DataRecord(SCHED_SCHEMA)
+        self.sched_ref = {}  # task id -> (overruns, skipped) at the last sched record
+
+    def log_memory_profile(self):
+        """Aggregates the per-task heap profile of TemplateTask._run since the last call into a mem record."""
+        if not DH.data_process_exists("mem"):
+            DH.register_data_process("mem", MEM_SCHEMA.FORMAT, True, data_limit=100000)
+
+        now = TPM.monotonic()
+        elapsed = now - self.mem_time_ref if self.mem_time_ref is not None else 0
+        self.mem_time_ref = now
+
+        tasks = SM.tasks
+        gc_count = 0
+        for task_id, rate_idx, peak_idx in _MEM_TASK_IDX:
+            task = tasks.get(task_id)
+            if task is None:
+                self.mem_log_data[rate_idx] = 0
+                self.mem_log_data[peak_idx] = 0
+                continue
+            allocated = task.mem_alloc_bytes - self.mem_alloc_ref.get(task_id, task.mem_alloc_bytes)
+            self.mem_alloc_ref[task_id] = task.mem_alloc_bytes
+            self.mem_log_data[rate_idx] = int(allocated / elapsed) if elapsed > 0 else 0
+            self.mem_log_data[peak_idx] = task.mem_alloc_peak
+            task.mem_alloc_peak = 0
+            gc_count += task.mem_gc_count
+
+        gc.collect()
+        self.mem_log_data[MEM_IDX.TIME_MEM] = TPM.time()
+        self.mem_log_data[MEM_IDX.MEM_FREE] = gc.mem_free()
+        self.mem_log_data[MEM_IDX.MEM_ALLOC] = gc.mem_alloc()
+        self.mem_log_data[MEM_IDX.LARGEST_FREE_BLOCK] = largest_free_block()
+        self.mem_log_data[MEM_IDX.GC_COUNT] = min(gc_count - self.mem_gc_ref, 0xFFFF)
+        self.mem_gc_ref = gc_count
+        DH.log_data("mem", self.mem_log_data)
+
+    def log_scheduler_profile(self):
+        """
+        Logs the deadline overruns and skipped releases of each scheduled task since the last call into a sched record,
+        with the measured and budgeted utilisation and the result of the admission test.
+        """
+        if not DH.data_process_exists("sched"):
+            DH.register_data_process("sched", SCHED_SCHEMA.FORMAT, True, data_limit=100000)
+
+        scheduled_tasks = SM.scheduled_tasks
+        not_admitted = 0
+        for task_id, overruns_idx, skipped_idx in _SCHED_TASK_IDX:
+            task = scheduled_tasks.get(task_id)
+            if task is None:
+                self.sched_log_data[overruns_idx] = 0
+                self.sched_log_data[skipped_idx] = 0
+                continue
+            overruns_ref, skipped_ref = self.sched_ref.get(task_id, (0, 0))
+            self.sched_ref[task_id] = (task.overruns, task.skipped)
+            self.sched_log_data[overruns_idx] = min(task.overruns - overruns_ref, 0xFFFF)
+            self.sched_log_data[skipped_idx] = min(task.skipped - skipped_ref, 0xFFFF)
+            if not task.admitted:
+                not_admitted += 1
+
+        self.sched_log_data[SCHED_IDX.TIME_SCHED] = TPM.time()
+        self.sched_log_data[SCHED_IDX.UTILISATION] = SM.utilisation()
+        self.sched_log_data[SCHED_IDX.BUDGETED] = budgeted_utilisation()
+        self.sched_log_data[SCHED_IDX.NOT_ADMITTED] = not_admitted
+        DH.log_data("sched", self.sched_log_data)
 
     async def main_task(self):
         if SM.current_state == STATES.STARTUP:
@@ -36,6 +161,9 @@ class Task(TemplateTask):
             if self.CLEANUP_COUNTER >= self.CLEANUP_COUNT_THRESHOLD:
                 DH.check_circular_buffers()
                 DH.clean_up()  # Clean up path that have been marked for deletion
+                if self.mem_profile:
+                    self.log_memory_profile()
+                self.log_scheduler_profile()
                 self.CLEANUP_COUNTER = 0
 
             if SM.current_state == STATES.NOMINAL:
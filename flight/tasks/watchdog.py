@@ -4,6 +4,8 @@
 # functioning correctly.
 
 from core import TemplateTask
+from core.satellite_config import watchdog_config as CONFIG
+from core.scheduler import set_heartbeat
 from hal.configuration import SATELLITE
 
 
@@ -11,6 +13,15 @@ class Task(TemplateTask):
     def __init__(self, id):
         super().__init__(id)
         self.name = "WATCHDOG"
+        self.heartbeat_set = False
+
+    def heartbeat(self):
+        """
+        Scheduler heartbeat: keeps the PIO state machine toggling the watchdog input for HEARTBEAT_WINDOW seconds.
+        Tasks blocking for less than the window no longer reset the satellite, a hung event loop still does.
+        """
+        if SATELLITE.WATCHDOG_AVAILABLE and SATELLITE.WATCHDOG.timer_backed:
+            SATELLITE.WATCHDOG.heartbeat(CONFIG.HEARTBEAT_WINDOW)
 
     async def main_task(self):
         if SATELLITE.WATCHDOG_AVAILABLE:
@@ -23,7 +34,13 @@ class Task(TemplateTask):
             transition.
             """
 
-            if SATELLITE.WATCHDOG.input:
+            if SATELLITE.WATCHDOG.timer_backed:
+                if not self.heartbeat_set:
+                    self.heartbeat()
+                    set_heartbeat(self.heartbeat, CONFIG.HEARTBEAT_PERIOD)
+                    self.heartbeat_set = True
+                    self.log_info("Watchdog serviced by PIO, gated by the scheduler heartbeat.")
+            elif SATELLITE.WATCHDOG.input:
                 SATELLITE.WATCHDOG.input_low()
             else:
                 SATELLITE.WATCHDOG.input_high()
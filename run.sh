@@ -51,6 +51,18 @@ if [[ -z $1 ]]; then
     $PYTHON_CMD build_tools/build.py "${BUILD_ARGS[@]}"
     $PYTHON_CMD build_tools/move_to_board.py
 elif [ "$1" == "emulate" ]; then
+    # Headless fast-boot: virtual clock, no hardware settle delays, e.g. ./run.sh emulate fast 30 (virtual minutes)
+    if [[ " $@ " =~ " fast " ]]; then
+        export SIM_REAL_SPEEDUP=1
+        export SIM_LOCKSTEP=1
+        export SIM_FAST_BOOT=1
+        for arg in "${@:2}"; do
+            if [[ $arg =~ ^[0-9]+$ ]]; then
+                export SIM_LOCKSTEP_DURATION=$((arg * 60))
+            fi
+        done
+        echo "Fast-boot emulation on a virtual clock${SIM_LOCKSTEP_DURATION:+, stopping after $SIM_LOCKSTEP_DURATION s}"
+    fi
     $PYTHON_CMD build_tools/build-emulator.py $FLIGHT_FLAG
     cd build/ && $PYTHON_CMD main.py
     cd -
@@ -0,0 +1,141 @@
+"""
+Multi-satellite load test of the RF channel, digipeater and COMMS tasks.
+
+Starts the RF channel broker (sil/rf_broker.py) with its synthetic APRS users, then N emulated FSW instances, each
+from its own copy of the emulator build and connected to the broker as a separate satellite. Once the broker reaches
+--duration of channel time it prints the per-node metrics and the FSW instances are stopped.
+
+Example, 3 satellites and 30 APRS users at 10x real time:
+    python sil/constellation_run.py -n 3 --aprs_users 30 --aprs_rate 0.05 --speedup 10 --activate_digipeater
+"""
+
+import argparse
+import os
+import shutil
+import socket
+import subprocess
+import sys
+import time
+
+project_root = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+builds_folder_path = os.path.join(project_root, "build", "constellation")
+
+
+def wait_for_broker(port, timeout=10.0):
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        try:
+            socket.create_connection(("127.0.0.1", port), timeout=0.5).close()
+            return
+        except OSError:
+            time.sleep(0.1)
+    raise TimeoutError(f"RF channel broker did not start on port {port}")
+
+
+def arg_parse(parser):
+    parser.add_argument("-n", "--satellites", type=int, default=2, help="Number of emulated FSW instances")
+    parser.add_argument("--aprs_users", type=int, default=10, help="Number of synthetic APRS users")
+    parser.add_argument("--aprs_rate", type=float, default=0.02, help="Packets per second per APRS user")
+    parser.add_argument("--loss", type=float, default=0.0, help="Independent loss probability per delivery")
+    parser.add_argument("--duration", type=float, default=600.0, help="Channel time to run for [s]")
+    parser.add_argument("--speedup", type=int, default=10, help="SIM_REAL_SPEEDUP of the FSW instances and broker")
+    parser.add_argument("--warmup", type=float, default=60.0, help="Channel time before traffic starts [s]")
+    parser.add_argument("--port", type=int, default=5600, help="Broker port")
+    parser.add_argument("--seed", type=int, default=None, help="Traffic and loss random seed")
+    parser.add_argument("--activate_digipeater", action="store_true", help="Uplink DIGIPEATER_ACTIVATE periodically")
+    parser.add_argument("--keep_builds", action="store_true", help="Keep the per-satellite build folders and logs")
+    return parser.parse_args()
+
+
+def build_template(template_build_folder):
+    subprocess.run(
+        [sys.executable, "build_tools/build-emulator.py", "--build_folder", template_build_folder],
+        cwd=project_root,
+        stdout=subprocess.DEVNULL,
+        check=True,
+    )
+
+
+def start_broker(port, duration, speedup, extra_args=()):
+    """Starts sil/rf_broker.py and waits until it accepts connections."""
+    broker_cmd = [
+        sys.executable,
+        os.path.join(project_root, "sil", "rf_broker.py"),
+        "--port",
+        str(port),
+        "--duration",
+        str(duration),
+        "--speedup",
+        str(speedup),
+    ]
+    broker = subprocess.Popen(broker_cmd + list(extra_args), cwd=project_root)
+    wait_for_broker(port)
+    return broker
+
+
+def start_satellite(template_build_folder, name, port, speedup):
+    """Starts an emulated FSW instance from a fresh copy of the template build, connected to the broker as name."""
+    build_folder = os.path.join(builds_folder_path, name)
+    if os.path.exists(build_folder):
+        shutil.rmtree(build_folder)
+    shutil.copytree(template_build_folder, build_folder)
+    env = os.environ.copy()
+    env.update(
+        {
+            "ARGUS_SIMULATION_FLAG": "0",
+            "SIM_REAL_SPEEDUP": str(speedup),
+            "ARGUS_RF_CHANNEL": f"127.0.0.1:{port}",
+            "ARGUS_RF_NODE": name,
+        }
+    )
+    with open(os.path.join(build_folder, "fsw.log"), "w") as log_file:
+        return subprocess.Popen(
+            [sys.executable, "main.py"], cwd=build_folder, env=env, stdout=log_file, stderr=subprocess.STDOUT
+        )
+
+
+def main(args):
+    template_build_folder = os.path.join(builds_folder_path, "template")
+    build_template(template_build_folder)
+
+    report_path = os.path.join(builds_folder_path, "rf_report.json")
+    broker_args = [
+        "--loss",
+        str(args.loss),
+        "--aprs_users",
+        str(args.aprs_users),
+        "--aprs_rate",
+        str(args.aprs_rate),
+        "--warmup",
+        str(args.warmup),
+        "--report",
+        report_path,
+    ]
+    if args.seed is not None:
+        broker_args += ["--seed", str(args.seed)]
+    if args.activate_digipeater:
+        broker_args.append("--activate_digipeater")
+    broker = start_broker(args.port, args.duration, args.speedup, broker_args)
+
+    satellites = [
+        start_satellite(template_build_folder, f"sat{i + 1}", args.port, args.speedup) for i in range(args.satellites)
+    ]
+
+    try:
+        broker.wait()
+    finally:
+        for process in satellites:
+            process.terminate()
+        for process in satellites:
+            process.wait()
+        if broker.poll() is None:
+            broker.terminate()
+
+    if not args.keep_builds:
+        for i in range(args.satellites):
+            shutil.rmtree(os.path.join(builds_folder_path, f"sat{i + 1}"), ignore_errors=True)
+    print(f"RF channel report written to {report_path}")
+
+
+if __name__ == "__main__":
+    main(arg_parse(argparse.ArgumentParser()))
@@ -0,0 +1,181 @@
+"""
+Vectorised reader for DataHandler DataProcess binaries.
+
+A DataProcess stores fixed-size little-endian records (struct format from its .data_process_configuration.json)
+back to back in <tag>_<time>.bin files under <sd>/<tag>/. Each file is mapped to a numpy structured dtype and read
+in one np.fromfile call, so full-rate data from the emulated SD loads without going through the text logs.
+
+Columns are named after the fields of flight/configuration/data_schema.yaml, the spec the flight software index
+constants are generated from, so the reader does not need the flight software importable. A process whose format on
+the SD card differs from its schema (e.g. logged by an older build) keeps the names of its matching leading fields.
+
+Stores are flat npz files with one 1-D array per column, keyed "<tag>.<column>". Set stores concatenate all trials
+and carry a "<tag>.trial" column with the trial number of each record.
+"""
+
+import json
+import os
+import re
+
+import numpy as np
+import yaml
+
+project_root = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+DATA_SCHEMA_PATH = os.path.join(project_root, "flight/configuration/data_schema.yaml")
+
+PROCESS_CONFIG_FILENAME = ".data_process_configuration.json"
+FSW_PROCESSES = ["adcs", "cdh", "eps", "gps"]
+
+# struct format characters to little-endian numpy types, same sizes as DataProcess._FORMAT
+_DTYPES = {
+    "b": "i1",
+    "B": "u1",
+    "h": "<i2",
+    "H": "<u2",
+    "i": "<i4",
+    "I": "<u4",
+    "l": "<i4",
+    "L": "<u4",
+    "q": "<i8",
+    "Q": "<u8",
+    "f": "<f4",
+    "d": "<f8",
+    "e": "<f2",
+}
+
+_BIN_FILE_PATTERN = re.compile(r"^(.+)_(\d+)\.bin$")
+
+_schema_cache = None
+
+
+def load_data_schema(schema_path=DATA_SCHEMA_PATH):
+    """Returns {tag: [(field name, format character), ...] in record order} from data_schema.yaml."""
+    with open(schema_path, "r") as file:
+        schema_data = yaml.safe_load(file) or {}
+    return {tag: list(fields.items()) for tag, fields in schema_data.items()}
+
+
+def column_names(tag, data_format):
+    """Column names of a process from its schema, up to the first field that differs. Others fall back to f<index>."""
+    global _schema_cache
+    if _schema_cache is None:
+        _schema_cache = load_data_schema()
+    names = []
+    for (name, c), logged in zip(_schema_cache.get(tag, []), data_format):
+        if c != logged:
+            break
+        names.append(name)
+    return names + [f"f{i}" for i in range(len(names), len(data_format))]
+
+
+def format_to_dtype(data_format, names=None):
+    """Maps a DataProcess struct format (without endianness prefix) to a packed numpy structured dtype."""
+    formats = []
+    for c in data_format:
+        if c not in _DTYPES:
+            raise ValueError(f"Invalid format character '{c}'")
+        formats.append(_DTYPES[c])
+    if names is None:
+        names = [f"f{i}" for i in range(len(formats))]
+    return np.dtype({"names": names, "formats": formats})
+
+
+def process_files(process_dir):
+    """Binary files of a process sorted by creation time."""
+    files = []
+    for name in os.listdir(process_dir):
+        match = _BIN_FILE_PATTERN.match(name)
+        if match:
+            files.append((int(match.group(2)), os.path.join(process_dir, name)))
+    return [path for _, path in sorted(files)]
+
+
+def read_process(process_dir):
+    """
+    Reads all records of a DataProcess directory into a structured array.
+    A trailing partial record (e.g. power cut in the middle of a write) is dropped.
+    Returns None if the directory has no configuration file.
+    """
+    config_path = os.path.join(process_dir, PROCESS_CONFIG_FILENAME)
+    if not os.path.exists(config_path):
+        return None
+    with open(config_path, "r") as file:
+        config = json.load(file)
+
+    tag = os.path.basename(os.path.normpath(process_dir))
+    data_format = config["data_format"]
+    dtype = format_to_dtype(data_format, column_names(tag, data_format))
+
+    chunks = []
+    for path in process_files(process_dir):
+        n_records = os.path.getsize(path) // dtype.itemsize
+        if n_records:
+            chunks.append(np.fromfile(path, dtype=dtype, count=n_records))
+    if not chunks:
+        return np.zeros(0, dtype=dtype)
+    return np.concatenate(chunks)
+
+
+def to_columns(tag, records):
+    """Flattens a structured array into {"<tag>.<column>": 1-D array}."""
+    return {f"{tag}.{name}": np.ascontiguousarray(records[name]) for name in records.dtype.names}
+
+
+def read_sd(sd_path, tags=FSW_PROCESSES):
+    """Reads the given processes from an (emulated) SD card root into flat columns. Missing processes are skipped."""
+    columns = {}
+    for tag in tags:
+        process_dir = os.path.join(sd_path, tag)
+        if not os.path.isdir(process_dir):
+            continue
+        records = read_process(process_dir)
+        if records is not None:
+            columns.update(to_columns(tag, records))
+    return columns
+
+
+def tags_in(columns):
+    return sorted({key.split(".", 1)[0] for key in columns})
+
+
+def merge_trials(trial_columns):
+    """
+    Concatenates {trial number: columns} into one columnar set store, adding a "<tag>.trial" column.
+    Records stay grouped by trial, in increasing trial order.
+    """
+    merged = {}
+    for trial in sorted(trial_columns):
+        columns = trial_columns[trial]
+        for tag in tags_in(columns):
+            keys = [key for key in columns if key.startswith(tag + ".")]
+            n_records = len(columns[keys[0]])
+            merged.setdefault(f"{tag}.trial", []).append(np.full(n_records, trial, dtype=np.int32))
+            for key in keys:
+                merged.setdefault(key, []).append(columns[key])
+    return {key: np.concatenate(chunks) for key, chunks in merged.items()}
+
+
+def split_trials(store, tag):
+    """Yields (trial number, {column: array}) for each trial of a process in a set store."""
+    trial_key = f"{tag}.trial"
+    if trial_key not in store:
+        return
+    trials = store[trial_key]
+    prefix = tag + "."
+    keys = [key for key in store if key.startswith(prefix) and key != trial_key]
+    # Records are grouped by trial, so each trial is a contiguous slice
+    trial_numbers, starts = np.unique(trials, return_index=True)
+    order = np.argsort(starts)
+    trial_numbers, starts = trial_numbers[order], starts[order]
+    ends = np.append(starts[1:], len(trials))
+    for trial, start, end in zip(trial_numbers, starts, ends):
+        yield int(trial), {key[len(prefix) :]: store[key][start:end] for key in keys}
+
+
+def save_store(path, columns):
+    np.savez(path, **columns)
+
+
+def load_store(path):
+    with np.load(path) as data:
+        return {key: data[key] for key in data.files}
@@ -18,17 +18,35 @@ project_root = os.path.abspath(os.path.join(project_root, ".."))
 if project_root not in sys.path:
     sys.path.append(project_root)
 
-# Convert epoch timestamp strings to seconds from the start
-def timestamps_to_seconds(timestamps):
-    epochs = np.array([int(ts) for ts in timestamps])
-    return (epochs - epochs[0]).astype(float)
+from sil.dh_reader import load_store, merge_trials, read_sd, save_store, split_trials
 
+TRIAL_DATA_FILE = "fsw_extracted_data.npz"
+SET_DATA_FILE = "fsw_data.npz"
 
-def undersample(data, percentage):
-    if not 0 < percentage <= 100:
-        raise ValueError("Percentage must be between 0 and 100")
-    step = max(1, int(100 / percentage))
-    return data[::step]
+
+def build_set_store(result_folder_path):
+    """
+    Merges the per-trial FSW data of a sim set into a single columnar store (fsw_data.npz in the set folder).
+    Returns the store, or None if a trial has no extracted data.
+    """
+    trials_folder_path = os.path.join(result_folder_path, "trials")
+    trial_columns = {}
+    for d in os.listdir(trials_folder_path):
+        trial_folder = os.path.join(trials_folder_path, d)
+        if not os.path.isdir(trial_folder):
+            continue
+        data_path = os.path.join(trial_folder, TRIAL_DATA_FILE)
+        if not os.path.exists(data_path):
+            print(f"Extracted data file not found at {data_path}")
+            return None
+        # Extract trial number from the folder name (assumes folder ends with an integer)
+        trial_number_match = re.search(r"(\d+)$", trial_folder)
+        trial_number = int(trial_number_match.group(1)) if trial_number_match else len(trial_columns)
+        trial_columns[trial_number] = load_store(data_path)
+
+    store = merge_trials(trial_columns)
+    save_store(os.path.join(result_folder_path, SET_DATA_FILE), store)
+    return store
 
 
 def plot_FSW(result_folder_path):
@@ -36,14 +54,21 @@ def plot_FSW(result_folder_path):
     Plots the FSW data.
     """
     plots_folder_path = os.path.join(result_folder_path, "plots")
-    # trials folder path
-    trials_folder_path = os.path.join(result_folder_path, "trials")
-    # Collect list of trial folders
-    trial_folders = [
-        os.path.join(trials_folder_path, d)
-        for d in os.listdir(trials_folder_path)
-        if os.path.isdir(os.path.join(trials_folder_path, d))
-    ]
+    store = build_set_store(result_folder_path)
+    if store is None:
+        return
+
+    # Per trial time origin: first record of any process
+    t0 = {}
+    for tag in ["adcs", "cdh"]:
+        for trial, columns in split_trials(store, tag):
+            time_column = columns[[key for key in columns if key.startswith("TIME")][0]]
+            if len(time_column):
+                t0[trial] = min(t0.get(trial, time_column[0]), time_column[0])
+
+    def seconds(trial, timestamps):
+        return (timestamps.astype(np.int64) - t0[trial]).astype(float)
+
     adcs_modes_list = []
     global_modes_list = []
     gyro_ang_vels_list = []
@@ -51,66 +76,24 @@ def plot_FSW(result_folder_path):
     sun_vectors_list = []
     sun_statuses_list = []
     trial_numbers = []
-    for i, trial_folder in enumerate(trial_folders):
-        # load FSW data for each trial
-        data_path = os.path.join(trial_folder, "fsw_extracted_data.npz")
-        if not os.path.exists(data_path):
-            print(f"Extracted data file not found at {data_path}")
-            return
-        # Extract trial number from the folder name (assumes folder ends with an integer)
-        trial_number_match = re.search(r"(\d+)$", trial_folder)
-        if trial_number_match:
-            trial_number = int(trial_number_match.group(1))
-        else:
-            trial_number = None
-        trial_numbers.append(trial_number)
-        data = np.load(data_path, allow_pickle=True)
-
-        # Extract arrays by key
-        adcs_modes = data["adcs_modes"]
-        global_modes = data["global_modes"]
-        gyro_ang_vels = data["gyro_ang_vels"]
-
-        # Extract timestamps from the first column of each array
-        timestamps_modes = adcs_modes[:, 0]
-        timestamps_global = global_modes[:, 0]
-        timestamps_gyro = gyro_ang_vels[:, 0]
-
-        # Convert data columns to appropriate types
-        adcs_modes_values = adcs_modes[:, 1].astype(int)
-        global_modes_values = global_modes[:, 1].astype(int)
-        gyro_ang_vel = gyro_ang_vels[:, 1:4].astype(float)
-
-        timestamps_gyro = timestamps_to_seconds(timestamps_gyro)
-        timestamps_modes = timestamps_to_seconds(timestamps_modes)
-        timestamps_global = timestamps_to_seconds(timestamps_global)
-
-        mag_fields = data["mag_fields"]
-        timestamps_mag = timestamps_to_seconds(mag_fields[:, 0])
-        mag_field = mag_fields[:, 1:4].astype(float)
-
-        sun_vectors = data["sun_vectors"]
-        timestamps_sun = timestamps_to_seconds(sun_vectors[:, 0])
-        sun_vector = sun_vectors[:, 1:4].astype(float)
-
-        sun_statuses = data["sun_statuses"]
-        timestamps_status = timestamps_to_seconds(sun_statuses[:, 0])
-        sun_status = sun_statuses[:, 1].astype(int)
-
-        # Store everything into lists
-        adcs_modes_list.append((timestamps_modes, adcs_modes_values))
-        global_modes_list.append((timestamps_global, global_modes_values))
-        gyro_ang_vels_list.append((timestamps_gyro, gyro_ang_vel))
-        mag_fields_list.append((timestamps_mag, mag_field))
-        sun_vectors_list.append((timestamps_sun, sun_vector))
-        sun_statuses_list.append((timestamps_status, sun_status))
+    for trial, adcs in split_trials(store, "adcs"):
+        trial_numbers.append(trial)
+        timestamps = seconds(trial, adcs["TIME_ADCS"])
+        adcs_modes_list.append((timestamps, adcs["MODE"].astype(int)))
+        gyro_ang_vels_list.append((timestamps, np.column_stack([adcs["GYRO_X"], adcs["GYRO_Y"], adcs["GYRO_Z"]])))
+        mag_fields_list.append((timestamps, np.column_stack([adcs["MAG_X"], adcs["MAG_Y"], adcs["MAG_Z"]])))
+        sun_vectors_list.append((timestamps, np.column_stack([adcs["SUN_VEC_X"], adcs["SUN_VEC_Y"], adcs["SUN_VEC_Z"]])))
+        sun_statuses_list.append((timestamps, adcs["SUN_STATUS"].astype(int)))
+
+    global_trial_numbers = []
+    for trial, cdh in split_trials(store, "cdh"):
+        global_trial_numbers.append(trial)
+        global_modes_list.append((seconds(trial, cdh["TIME"]), cdh["SC_STATE"].astype(int)))
 
     print("Plotting FSW data...")
-    # Use timestamps_gyro for plotting (assuming all timestamps are aligned)
-    # Plot ADCS Mode
     # Plot ADCS Mode
     mode_names = ["TUMBLING", "STABLE", "SUN_POINTED", "ACS_OFF"]
-    global_mode_names = ["STARTUP", "DETUMBLING", "NOMINAL", "EXPERIMENT", "LOW_POWER"]
+    global_mode_names = ["STARTUP", "DETUMBLING", "NOMINAL", "LOW_POWER", "EXPERIMENT"]
 
     plt.figure(figsize=(12, 7))
 
@@ -127,7 +110,7 @@ def plot_FSW(result_folder_path):
     # Global Mode subplot
     ax2 = plt.subplot(2, 1, 2, sharex=ax1)
     for trial_idx, (timestamps_global, global_modes_values) in enumerate(global_modes_list):
-        ax2.plot(timestamps_global, global_modes_values, label=f"Trial {trial_numbers[trial_idx]}")
+        ax2.plot(timestamps_global, global_modes_values, label=f"Trial {global_trial_numbers[trial_idx]}")
     ax2.set_ylabel("Global Mode")
     ax2.set_xlabel("Time (s)")
     ax2.set_yticks(range(len(global_mode_names)))
@@ -220,95 +203,20 @@ def plot_FSW(result_folder_path):
     print(f"Sun Status plot saved to {output_plot_path_status}")
 
 
-def collect_FSW_data(outfile, result_folder_path, save_sil_logs=False, erase_sil_logs=False, percent_to_log=1):
+def collect_FSW_data(outfile, sd_path, result_folder_path, save_sil_logs=False, erase_sil_logs=False):
     """
-    Collects FSW data from the log file.
+    Collects the FSW data processes written to the emulated SD card, at full rate.
     """
-    print(f"Collecting FSW data from {outfile}...")
-    fsw_data = []
-    pattern = re.compile(r"\[\d+\]\[INFO\] \[\d+\]\[ADCS\] .+:.+")
-    command_global_state_pattern = re.compile(
-        r"\[\d+\]\[INFO\] \[\d+\]\[COMMAND\] GLOBAL STATE: .+"
-    )
-    with open(outfile, "r") as f:
-        for line in f:
-            if pattern.match(line.strip()) or command_global_state_pattern.match(line.strip()):
-                fsw_data.append(line.strip())
-
-    print(f"Collected {len(fsw_data)} FSW data entries.")
-    # Extract timestamp, ADCS Mode, Gyro Ang Vel, and Gyro Bias
-    # Prepare empty lists for each variable
-    # [2024-10-21 09:20:32][INFO] [0][COMMAND] GLOBAL STATE: DETUMBLING.
-    # Also append to fsw_data the command global state pattern
-    adcs_modes = []
-    global_modes = []
-    gyro_ang_vels = []
-    mag_fields = []
-    sun_vectors = []
-    sun_statuses = []
-
-    for entry in fsw_data:
-        timestamp = entry.split("]")[0][1:]
-        adcs_mode = re.search(r"ADCS Mode : (\d+)", entry)
-        global_mode = re.search(r"GLOBAL STATE: (\w+)", entry)
-        gyro_ang_vel = re.search(r"Gyro Ang Vel : \[(.*?)\]", entry)
-        mag_field = re.search(r"Mag Field : \[(.*?)\]", entry)
-        sun_vector = re.search(r"Sun Vector : \[(.*?)\]", entry)
-        sun_status = re.search(r"Sun Status : (\d+)", entry)
-        global_mode_code = {
-            "STARTUP": 0,
-            "DETUMBLING": 1,
-            "NOMINAL": 2,
-            "LOW_POWER": 3,
-        }
-
-        if adcs_mode:
-            adcs_modes.append([timestamp, int(adcs_mode.group(1))])
-        elif global_mode:
-            global_modes.append([timestamp, global_mode_code[global_mode.group(1)]])
-        elif gyro_ang_vel:
-            values = re.findall(r"np\.float64\((.*?)\)", gyro_ang_vel.group(1))
-            if not values:
-                values = re.findall(r"[-+]?\d*\.\d+(?:[eE][-+]?\d+)?|[-+]?\d+(?:[eE][-+]?\d+)?", gyro_ang_vel.group(1))
-            gyro_ang_vels.append([timestamp] + [float(v) for v in values])
-        elif mag_field:
-            values = re.findall(r"[-+]?\d*\.\d+(?:[eE][-+]?\d+)?|[-+]?\d+(?:[eE][-+]?\d+)?", mag_field.group(1))
-            mag_fields.append([timestamp] + [float(v) for v in values])
-        elif sun_vector:
-            values = re.findall(r"[-+]?\d*\.\d+(?:[eE][-+]?\d+)?|[-+]?\d+(?:[eE][-+]?\d+)?", sun_vector.group(1))
-            sun_vectors.append([timestamp] + [float(v) for v in values])
-        elif sun_status:
-            sun_statuses.append([timestamp, int(sun_status.group(1))])
-
-    # Convert lists to numpy arrays (timestamps already included)
-    adcs_modes_np = np.array(adcs_modes)
-    global_modes_np = np.array(global_modes)
-    gyro_ang_vels_np = np.array(gyro_ang_vels)
-    mag_fields_np = np.array(mag_fields)
-    sun_vectors_np = np.array(sun_vectors)
-    sun_statuses_np = np.array(sun_statuses)
-
-    # Undersample the data to a given percentage
-    adcs_modes_np = undersample(adcs_modes_np, 100 * percent_to_log)
-    global_modes_np = undersample(global_modes_np, 100 * percent_to_log)
-    gyro_ang_vels_np = undersample(gyro_ang_vels_np, 100 * percent_to_log)
-    mag_fields_np = undersample(mag_fields_np, 100 * percent_to_log)
-    sun_vectors_np = undersample(sun_vectors_np, 100 * percent_to_log)
-    sun_statuses_np = undersample(sun_statuses_np, 100 * percent_to_log)
+    print(f"Collecting FSW data from {sd_path}...")
+    columns = read_sd(sd_path)
+    if not columns:
+        print(f"No FSW data processes found at {sd_path}")
 
     # Save extracted data to a .npz file in the result folder
     if not os.path.exists(result_folder_path):
         os.makedirs(result_folder_path)
-    output_path = os.path.join(result_folder_path, "fsw_extracted_data.npz")
-    np.savez(
-        output_path,
-        adcs_modes=adcs_modes_np,
-        global_modes=global_modes_np,
-        gyro_ang_vels=gyro_ang_vels_np,
-        mag_fields=mag_fields_np,
-        sun_vectors=sun_vectors_np,
-        sun_statuses=sun_statuses_np,
-    )
+    output_path = os.path.join(result_folder_path, TRIAL_DATA_FILE)
+    save_store(output_path, columns)
     print(f"Extracted data saved to {output_path}")
 
     # Move sil_logs.log to the result folder
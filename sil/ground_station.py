@@ -0,0 +1,471 @@
+"""
+Scriptable ground station simulator for the emulated FSW.
+
+Connects to the RF channel broker (sil/rf_broker.py) as a ground station node and runs a scripted pass against the
+emulated satellite with the same packets as the real ground station: splat commands signed as
+apps.comms.auth.verify_authenticated_command expects (sil/uplink.py), and file and log downlinks through
+CREATE_TRANS -> GENERATE_X_PACKETS -> CONFIRM_LAST_BATCH, in batch windows like apps/payload/download_manager.py
+(bitmap bit set = fragment missing, MSB first within the window).
+
+Loss can be injected on the channel (--loss, applied by the broker to every delivery) and independently on the
+ground station uplink and downlink (--uplink_loss, --downlink_loss). At the end of the pass it reports:
+    - command latency: command TX start to its Ack received, per command (includes the downlink of the fragments
+      queued before the Ack of GENERATE_X_PACKETS)
+    - goodput: unique file bytes received / transfer time
+    - retransmission ratio: fragments transmitted by the satellite beyond the file's packet count / packet count
+    - pass-time efficiency: downlink time on air of the unique file fragments / pass time
+
+Times are channel times (wall time * --speedup, the SIM_REAL_SPEEDUP of the FSW).
+
+The script is a yaml list of steps run in order until the pass (--pass_duration) is over:
+    - PING                                      a command without arguments
+    - command: SET_LOG_LEVEL                    a command with arguments
+      args: [2]
+    - downlink_file: sd/adcs/adcs_1000.bin      CREATE_TRANS ... CONFIRM_LAST_BATCH of a file
+    - downlink_logs: true                       PREPARE_LOG_DOWNLINK, the staging file downlink, CLEANUP_LOG_DOWNLINK
+    - wait: 10                                  [s]
+
+Example, against an emulated FSW started with the broker by --launch, 5 % loss on the channel:
+    python sil/ground_station.py --launch --speedup 5 --loss 0.05 --script sil/configs/gs_script.yaml
+"""
+
+import argparse
+import json
+import os
+import random
+import socket
+import sys
+import time
+
+import yaml
+
+project_root = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+if project_root not in sys.path:
+    sys.path.append(project_root)
+
+from emulator.rf_channel import (  # noqa: E402
+    FRAME_HELLO,
+    FRAME_RX,
+    FRAME_TX,
+    decode_frames,
+    encode_frame,
+    time_on_air,
+)
+
+# Fragments per CONFIRM_LAST_BATCH window, as DownloadManager.BATCH_SIZE (at most 64, the width of the bitmap)
+BATCH_SIZE = 40
+
+
+class RadioLink:
+    """Ground station radio on the RF channel broker, with independent uplink and downlink loss."""
+
+    def __init__(self, channel, name="gs", speedup=1.0, uplink_loss=0.0, downlink_loss=0.0, seed=None):
+        host, port = channel.rsplit(":", 1)
+        self.sock = socket.create_connection((host, int(port)))
+        self.sock.sendall(encode_frame(FRAME_HELLO, f"gs:{name}".encode()))
+        self.speedup = speedup
+        self.uplink_loss = uplink_loss
+        self.downlink_loss = downlink_loss
+        self.random = random.Random(seed)
+        self.buffer = b""
+        self.rx_queue = []
+
+        self.tx_packets = 0
+        self.tx_dropped = 0
+        self.rx_packets = 0
+        self.rx_dropped = 0
+
+    def now(self):
+        return time.monotonic() * self.speedup
+
+    def send(self, packet):
+        """Puts a packet on the air, returns once it has been transmitted (half duplex)."""
+        self.tx_packets += 1
+        if self.random.random() < self.uplink_loss:
+            self.tx_dropped += 1
+        else:
+            self.sock.sendall(encode_frame(FRAME_TX, packet))
+        time.sleep(time_on_air(len(packet)) / self.speedup)
+
+    def recv(self, timeout):
+        """Next packet received within timeout [s], or None."""
+        deadline = self.now() + timeout
+        while not self.rx_queue:
+            remaining = deadline - self.now()
+            if remaining <= 0:
+                return None
+            self.sock.settimeout(remaining / self.speedup)
+            try:
+                data = self.sock.recv(4096)
+            except socket.timeout:
+                return None
+            if not data:
+                raise ConnectionError("RF channel broker closed the connection")
+            frames, self.buffer = decode_frames(self.buffer + data)
+            for frame_type, payload in frames:
+                if frame_type != FRAME_RX:
+                    continue
+                if self.random.random() < self.downlink_loss:
+                    self.rx_dropped += 1
+                    continue
+                self.rx_packets += 1
+                self.rx_queue.append(payload)
+        return self.rx_queue.pop(0)
+
+    def close(self):
+        self.sock.close()
+
+
+class Transfer:
+    """Ground side of one file downlink transaction."""
+
+    def __init__(self, tid, path):
+        self.tid = tid
+        self.path = path
+        self.number_of_packets = None
+        self.fragments = {}  # seq_number -> payload
+        self.useful_airtime = 0.0  # time on air of the first copy of each fragment
+        self.fragments_received = 0
+        self.fragments_sent = 0  # as acknowledged by GENERATE_X_PACKETS
+        self.batches = 0
+        self.start = None
+        self.end = None
+        self.complete = False
+
+    def add_fragment(self, seq_number, payload, packet_length):
+        self.fragments_received += 1
+        if seq_number not in self.fragments:
+            self.fragments[seq_number] = payload
+            self.useful_airtime += time_on_air(packet_length)
+
+    def missing(self, offset, width):
+        return [seq for seq in range(offset, offset + width) if seq not in self.fragments]
+
+    def bitmap(self, offset, width):
+        """(bitmap_high, bitmap_low) of the window, bit set = missing, MSB first."""
+        bitmap = 0
+        for seq in self.missing(offset, width):
+            bitmap |= 1 << ((width - 1) - (seq - offset))
+        return (bitmap >> 32) & 0xFFFFFFFF, bitmap & 0xFFFFFFFF
+
+    def data(self):
+        return b"".join(bytes(self.fragments[seq]) for seq in sorted(self.fragments))
+
+    def metrics(self):
+        n_packets = self.number_of_packets or 0
+        duration = (self.end - self.start) if self.start is not None and self.end is not None else 0.0
+        n_bytes = sum(len(payload) for payload in self.fragments.values())
+        return {
+            "tid": self.tid,
+            "path": self.path,
+            "complete": self.complete,
+            "packets": n_packets,
+            "bytes": n_bytes,
+            "duration_s": duration,
+            "batches": self.batches,
+            "fragments_sent": self.fragments_sent,
+            "fragments_received": self.fragments_received,
+            "goodput_Bps": n_bytes / duration if duration > 0 else 0.0,
+            "retransmission_ratio": max(0, self.fragments_sent - n_packets) / n_packets if n_packets else 0.0,
+        }
+
+
+class GroundStation:
+    """Runs commands and downlinks against the satellite over a link (send(packet), recv(timeout), now())."""
+
+    def __init__(self, link, uplink, ack_timeout=10.0, retries=3, batch_size=BATCH_SIZE, save_folder=None):
+        self.link = link
+        self.uplink = uplink
+        self.ack_timeout = ack_timeout
+        self.retries = retries
+        self.batch_size = batch_size
+        self.save_folder = save_folder
+
+        self.next_tid = 1
+        self.transfers = {}  # tid -> Transfer
+        self.latencies = {}  # command name -> [s]
+        self.commands_sent = 0
+        self.command_retries = 0
+        self.command_timeouts = 0
+        self.reports_received = 0
+        self.pass_start = None
+        self.pass_end = None
+
+    # ---------------------------------------------------------------------------------------------------------------
+    # Commands
+    # ---------------------------------------------------------------------------------------------------------------
+
+    def command(self, name, *args):
+        """
+        Uplinks a command until it is acknowledged, retrying up to self.retries times.
+        Returns (status, response list) of its Ack, or None if it was never acknowledged.
+        """
+        cmd_id = self.uplink.command_id(name)
+        for attempt in range(self.retries + 1):
+            if attempt > 0:
+                self.command_retries += 1
+            tx_start = self.link.now()
+            self.link.send(self.uplink.command(name, *args))
+            self.commands_sent += 1
+            ack = self.wait_for_ack(cmd_id)
+            if ack is not None:
+                self.latencies.setdefault(name, []).append(self.link.now() - tx_start)
+                return getattr(ack, "status", 0), list(getattr(ack, "response_args", None) or [])
+        self.command_timeouts += 1
+        print(f"[GS] {name} not acknowledged after {self.retries + 1} attempts")
+        return None
+
+    def wait_for_ack(self, cmd_id):
+        """
+        Files downlinked packets until the Ack of cmd_id. Gives up after ack_timeout without receiving anything, so a
+        GENERATE_X_PACKETS batch (its fragments are queued before its Ack) does not time out while it is downlinked.
+        """
+        while True:
+            packet = self.link.recv(self.ack_timeout)
+            if packet is None:
+                return None
+            message = self.handle_packet(packet)
+            if type(message).__name__ == "Ack" and message.cmd_id == cmd_id:
+                return message
+
+    def handle_packet(self, packet):
+        """Unpacks a downlinked packet and files fragments and transaction headers, returns the message object."""
+        try:
+            _, message = self.uplink.unpack(packet)
+        except Exception as e:
+            print(f"[GS] Unable to unpack downlinked packet: {e}")
+            return None
+        kind = type(message).__name__
+        if kind == "Fragment":
+            transfer = self.transfers.get(message.tid)
+            if transfer is not None:
+                transfer.add_fragment(message.seq_number, message.payload, len(packet))
+        elif kind == "Command" and message.name == "INIT_TRANS":
+            tid, number_of_packets = message.get_arguments_list()[:2]
+            if tid in self.transfers:
+                self.transfers[tid].number_of_packets = number_of_packets
+        elif kind == "Report":
+            self.reports_received += 1
+        return message
+
+    # ---------------------------------------------------------------------------------------------------------------
+    # Downlinks
+    # ---------------------------------------------------------------------------------------------------------------
+
+    def downlink_file(self, path):
+        """Downlinks a file from the satellite SD card, returns its Transfer."""
+        tid = self.next_tid
+        self.next_tid = self.next_tid % 255 + 1
+        transfer = Transfer(tid, path)
+        self.transfers[tid] = transfer
+        transfer.start = self.link.now()
+
+        ack = self.command("CREATE_TRANS", tid, path)
+        if ack is None or len(ack[1]) < 2 or isinstance(ack[1][0], str):
+            print(f"[GS] CREATE_TRANS {path} failed: {ack}")
+            transfer.end = self.link.now()
+            return transfer
+        transfer.number_of_packets = ack[1][1]
+
+        offset = 0
+        stalled_batches = 0
+        while offset < transfer.number_of_packets and not self.pass_over():
+            width = min(self.batch_size, transfer.number_of_packets - offset)
+            missing_before = len(transfer.missing(offset, width))
+            if missing_before == 0:
+                offset += width
+                continue
+
+            ack = self.command("GENERATE_X_PACKETS", tid, missing_before)
+            if ack is not None and ack[1] and isinstance(ack[1][0], int):
+                transfer.fragments_sent += ack[1][0]
+            transfer.batches += 1
+
+            bitmap_high, bitmap_low = transfer.bitmap(offset, width)
+            self.command("CONFIRM_LAST_BATCH", tid, bitmap_high, bitmap_low)
+
+            missing_after = len(transfer.missing(offset, width))
+            if missing_after == 0:
+                offset += width
+            if missing_after < missing_before:
+                stalled_batches = 0
+                continue
+            stalled_batches += 1
+            if stalled_batches > self.retries:
+                print(f"[GS] Downlink of {path} stalled at fragment {offset}")
+                break
+
+        transfer.end = self.link.now()
+        transfer.complete = len(transfer.fragments) == transfer.number_of_packets
+        if transfer.complete and self.save_folder:
+            os.makedirs(self.save_folder, exist_ok=True)
+            with open(os.path.join(self.save_folder, os.path.basename(path)), "wb") as file:
+                file.write(transfer.data())
+        return transfer
+
+    def downlink_logs(self):
+        """Freezes the FSW log into its staging file, downlinks it and cleans it up."""
+        ack = self.command("PREPARE_LOG_DOWNLINK")
+        if ack is None or len(ack[1]) < 2:
+            print(f"[GS] PREPARE_LOG_DOWNLINK: {ack}")
+            return None
+        transfer = self.downlink_file(ack[1][0])
+        if transfer.complete:
+            self.command("CLEANUP_LOG_DOWNLINK")
+        return transfer
+
+    # ---------------------------------------------------------------------------------------------------------------
+    # Pass
+    # ---------------------------------------------------------------------------------------------------------------
+
+    def pass_over(self):
+        return self.pass_end is not None and self.link.now() >= self.pass_end
+
+    def wait(self, seconds):
+        """Listens for seconds, filing whatever is downlinked meanwhile."""
+        deadline = min(self.link.now() + seconds, self.pass_end or float("inf"))
+        while self.link.now() < deadline:
+            packet = self.link.recv(deadline - self.link.now())
+            if packet is not None:
+                self.handle_packet(packet)
+
+    def run_step(self, step):
+        if isinstance(step, str):
+            self.command(step)
+        elif "command" in step:
+            self.command(step["command"], *step.get("args", []))
+        elif "downlink_file" in step:
+            self.downlink_file(step["downlink_file"])
+        elif "downlink_logs" in step:
+            self.downlink_logs()
+        elif "wait" in step:
+            self.wait(step["wait"])
+        else:
+            raise ValueError(f"Unknown ground station script step: {step}")
+
+    def run_pass(self, steps, pass_duration=None):
+        self.pass_start = self.link.now()
+        self.pass_end = self.pass_start + pass_duration if pass_duration else None
+        for step in steps:
+            if self.pass_over():
+                print("[GS] Pass over, remaining script steps skipped")
+                break
+            self.run_step(step)
+        return self.report()
+
+    def report(self):
+        duration = max(self.link.now() - self.pass_start, 1e-9)
+        transfers = [transfer.metrics() for transfer in self.transfers.values()]
+        all_latencies = sorted(latency for latencies in self.latencies.values() for latency in latencies)
+        n_packets = sum(transfer["packets"] for transfer in transfers)
+        fragments_sent = sum(transfer["fragments_sent"] for transfer in transfers)
+        transfer_time = sum(transfer["duration_s"] for transfer in transfers)
+        transfer_bytes = sum(transfer["bytes"] for transfer in transfers)
+        return {
+            "pass_duration_s": duration,
+            "commands_sent": self.commands_sent,
+            "command_retries": self.command_retries,
+            "command_timeouts": self.command_timeouts,
+            "command_latency_s": {
+                name: {"mean": sum(latencies) / len(latencies), "max": max(latencies), "count": len(latencies)}
+                for name, latencies in self.latencies.items()
+            },
+            "command_latency_p50_s": all_latencies[len(all_latencies) // 2] if all_latencies else None,
+            "command_latency_p95_s": (
+                all_latencies[min(len(all_latencies) - 1, int(0.95 * len(all_latencies)))] if all_latencies else None
+            ),
+            "goodput_Bps": transfer_bytes / transfer_time if transfer_time > 0 else 0.0,
+            "retransmission_ratio": max(0, fragments_sent - n_packets) / n_packets if n_packets else 0.0,
+            "pass_time_efficiency": sum(transfer.useful_airtime for transfer in self.transfers.values()) / duration,
+            "reports_received": self.reports_received,
+            "uplink_dropped": getattr(self.link, "tx_dropped", 0),
+            "downlink_dropped": getattr(self.link, "rx_dropped", 0),
+            "transfers": transfers,
+        }
+
+
+def print_report(report):
+    print(
+        f"Pass: {report['pass_duration_s']:.1f} s, {report['commands_sent']} commands sent, "
+        f"{report['command_retries']} retries, {report['command_timeouts']} timeouts"
+    )
+    for name, latency in report["command_latency_s"].items():
+        print(f"  {name:<24} latency mean {latency['mean']:.2f} s, max {latency['max']:.2f} s ({latency['count']})")
+    for transfer in report["transfers"]:
+        print(
+            f"  tid {transfer['tid']:<4} {transfer['path']:<32} {'complete' if transfer['complete'] else 'INCOMPLETE'} "
+            f"{transfer['bytes']} B in {transfer['duration_s']:.1f} s, {transfer['goodput_Bps']:.1f} B/s, "
+            f"retransmission ratio {transfer['retransmission_ratio']:.2f}"
+        )
+    print(
+        f"Goodput {report['goodput_Bps']:.1f} B/s, retransmission ratio {report['retransmission_ratio']:.2f}, "
+        f"pass-time efficiency {100 * report['pass_time_efficiency']:.1f} %"
+    )
+
+
+def arg_parse(parser):
+    parser.add_argument("--script", type=str, default=os.path.join(project_root, "sil", "configs", "gs_script.yaml"))
+    parser.add_argument("--channel", type=str, default="127.0.0.1:5600", help="RF channel broker host:port")
+    parser.add_argument("--name", type=str, default="gs", help="Ground station node name on the channel")
+    parser.add_argument("--speedup", type=float, default=1.0, help="Channel time / wall time, match SIM_REAL_SPEEDUP")
+    parser.add_argument("--pass_duration", type=float, default=600.0, help="Pass length [s], 0 to run the whole script")
+    parser.add_argument("--uplink_loss", type=float, default=0.0, help="Ground station uplink loss probability")
+    parser.add_argument("--downlink_loss", type=float, default=0.0, help="Ground station downlink loss probability")
+    parser.add_argument("--ack_timeout", type=float, default=10.0, help="Silence after which a command is resent [s]")
+    parser.add_argument("--retries", type=int, default=3, help="Command and stalled batch retries")
+    parser.add_argument("--batch_size", type=int, default=BATCH_SIZE, help="Fragments per CONFIRM_LAST_BATCH window")
+    parser.add_argument("--seed", type=int, default=None, help="Loss random seed")
+    parser.add_argument("--save_folder", type=str, default=None, help="Write downlinked files to this folder")
+    parser.add_argument("--report", type=str, default=None, help="Write the metrics as json to this file")
+    parser.add_argument("--flight", action="store_true", help="Use flight.yaml configuration instead of ground.yaml")
+    parser.add_argument(
+        "--launch",
+        action="store_true",
+        help="Build the emulator and start the broker and one emulated FSW instance for the pass",
+    )
+    parser.add_argument("--loss", type=float, default=0.0, help="Channel loss probability, with --launch")
+    parser.add_argument("--boot_time", type=float, default=60.0, help="Channel time to let the FSW boot, with --launch")
+    return parser.parse_args()
+
+
+def main(args):
+    from sil.uplink import Uplink
+
+    with open(args.script, "r") as file:
+        steps = yaml.safe_load(file) or []
+
+    processes = []
+    if args.launch:
+        from sil import constellation_run
+
+        template_build_folder = os.path.join(constellation_run.builds_folder_path, "template")
+        constellation_run.build_template(template_build_folder)
+        port = int(args.channel.rsplit(":", 1)[1])
+        broker_args = ["--aprs_users", "0", "--loss", str(args.loss)]
+        if args.seed is not None:
+            broker_args += ["--seed", str(args.seed)]
+        processes.append(constellation_run.start_broker(port, 1.0e9, args.speedup, broker_args))
+        processes.append(constellation_run.start_satellite(template_build_folder, "sat1", port, args.speedup))
+
+    try:
+        link = RadioLink(args.channel, args.name, args.speedup, args.uplink_loss, args.downlink_loss, args.seed)
+        station = GroundStation(link, Uplink(args.flight), args.ack_timeout, args.retries, args.batch_size, args.save_folder)
+        if args.launch:
+            station.pass_start = link.now()
+            station.wait(args.boot_time)
+        report = station.run_pass(steps, args.pass_duration)
+        link.close()
+    finally:
+        for process in reversed(processes):
+            process.terminate()
+            process.wait()
+
+    print_report(report)
+    if args.report:
+        with open(args.report, "w") as file:
+            json.dump(report, file, indent=2)
+    return report
+
+
+if __name__ == "__main__":
+    main(arg_parse(argparse.ArgumentParser()))
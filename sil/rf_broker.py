@@ -0,0 +1,401 @@
+"""
+Local RF channel broker for multi-satellite emulation.
+
+Emulated FSW instances started with ARGUS_RF_CHANNEL=<host>:<port> (see emulator/drivers/radio.py) connect to the
+broker and share a single LoRa channel with synthetic ground nodes simulated inside the broker:
+    - APRS users transmitting LoRa APRS packets addressed through the satellite digipeater (Poisson arrivals)
+    - optionally a ground station periodically uplinking DIGIPEATER_ACTIVATE
+
+Channel model (pure ALOHA, single footprint: every ground node hears every satellite and the other way around,
+satellites do not hear each other and ground nodes do not hear each other):
+    - each packet occupies the channel for its LoRa time on air (rf_channel.time_on_air, same as SX126X.getTimeOnAir)
+    - overlapping transmissions collide and are lost at every receiver (this also covers half duplex: a node
+      transmitting while a packet is on the air collides with it)
+    - each delivery is independently lost with probability --loss
+
+Channel time runs at --speedup times wall time and must match the SIM_REAL_SPEEDUP of the FSW instances.
+At the end, per-node throughput, losses, digipeater queue drops (APRS packets heard but never repeated) and
+digipeater latency (APRS user TX start to repeated packet received) are printed and written to --report.
+"""
+
+import argparse
+import heapq
+import json
+import os
+import random
+import re
+import selectors
+import socket
+import sys
+import time
+
+project_root = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+if project_root not in sys.path:
+    sys.path.append(project_root)
+
+from emulator.rf_channel import (  # noqa: E402
+    FRAME_HELLO,
+    FRAME_RX,
+    FRAME_TX,
+    decode_frames,
+    encode_frame,
+    time_on_air,
+)
+
+APRS_HEADER = b"\x3c\xff\x01"
+_APRS_ID_PATTERN = re.compile(rb":>ID(\d+)$")
+
+KIND_FSW = "fsw"
+KIND_APRS = "aprs"
+KIND_GS = "gs"
+
+
+class Node:
+    def __init__(self, name, kind, conn=None):
+        self.name = name
+        self.kind = kind
+        self.conn = conn
+        self.buffer = b""
+
+        self.tx_packets = 0
+        self.tx_bytes = 0
+        self.tx_airtime = 0.0
+        self.rx_packets = 0
+        self.rx_bytes = 0
+        self.lost_collision = 0
+        self.lost_random = 0
+
+        # Digipeater accounting (satellites: heard/repeated, APRS users: repeated back)
+        self.aprs_heard = set()
+        self.aprs_repeated = set()
+        self.latencies = []
+
+    def is_ground(self):
+        return self.kind != KIND_FSW
+
+    def on_receive(self, broker, transmission):
+        """Internal nodes only, delivery of a packet."""
+        pass
+
+
+class Transmission:
+    __slots__ = ("source", "payload", "start", "end", "collided")
+
+    def __init__(self, source, payload, start, end):
+        self.source = source
+        self.payload = payload
+        self.start = start
+        self.end = end
+        self.collided = False
+
+
+class ChannelBroker:
+    def __init__(self, host, port, speedup=1.0, loss=0.0, seed=None):
+        self.speedup = speedup
+        self.loss = loss
+        self.random = random.Random(seed)
+
+        self.nodes = []
+        self.on_air = []
+        self.events = []  # heap of (channel time, sequence, callback)
+        self._sequence = 0
+        self.collisions = 0
+        self.busy_time = 0.0  # channel time with at least one packet on the air
+        self._busy_until = 0.0
+
+        # APRS message id -> (origin node, TX start)
+        self.aprs_origin = {}
+
+        self.selector = selectors.DefaultSelector()
+        self.server = socket.create_server((host, port))
+        self.server.setblocking(False)
+        self.selector.register(self.server, selectors.EVENT_READ)
+        self.start_time = time.monotonic()
+
+    def now(self):
+        return (time.monotonic() - self.start_time) * self.speedup
+
+    def schedule(self, at, callback):
+        self._sequence += 1
+        heapq.heappush(self.events, (at, self._sequence, callback))
+
+    def add_node(self, node):
+        self.nodes.append(node)
+        return node
+
+    # ---------------------------------------------------------------------------------------------------------------
+    # Channel
+    # ---------------------------------------------------------------------------------------------------------------
+
+    def transmit(self, source, payload):
+        start = self.now()
+        end = start + time_on_air(len(payload))
+        transmission = Transmission(source, payload, start, end)
+
+        self.on_air = [other for other in self.on_air if other.end > start]
+        for other in self.on_air:
+            if not other.collided:
+                self.collisions += 1
+            if not transmission.collided:
+                self.collisions += 1
+            other.collided = True
+            transmission.collided = True
+        self.on_air.append(transmission)
+
+        self.busy_time += max(0.0, end - max(start, self._busy_until))
+        self._busy_until = max(self._busy_until, end)
+
+        source.tx_packets += 1
+        source.tx_bytes += len(payload)
+        source.tx_airtime += end - start
+        if source.kind == KIND_FSW:
+            self.account_repeat(transmission)
+        self.schedule(end, lambda: self.deliver(transmission))
+        return transmission
+
+    def deliver(self, transmission):
+        source = transmission.source
+        for node in self.nodes:
+            if node.is_ground() == source.is_ground():
+                continue
+            if transmission.collided:
+                node.lost_collision += 1
+                continue
+            if self.random.random() < self.loss:
+                node.lost_random += 1
+                continue
+
+            node.rx_packets += 1
+            node.rx_bytes += len(transmission.payload)
+            self.account_digipeater(node, transmission)
+            if node.conn is not None:
+                try:
+                    node.conn.sendall(encode_frame(FRAME_RX, transmission.payload))
+                except OSError:
+                    pass
+            else:
+                node.on_receive(self, transmission)
+
+    @staticmethod
+    def aprs_message_id(payload):
+        if not payload.startswith(APRS_HEADER):
+            return None
+        match = _APRS_ID_PATTERN.search(payload)
+        return int(match.group(1)) if match else None
+
+    def account_repeat(self, transmission):
+        """A satellite put a digipeated APRS packet on the air."""
+        message_id = self.aprs_message_id(transmission.payload)
+        satellite = transmission.source
+        if message_id in self.aprs_origin and b"*" in transmission.payload and message_id not in satellite.aprs_repeated:
+            satellite.aprs_repeated.add(message_id)
+            satellite.latencies.append(transmission.end - self.aprs_origin[message_id][1])
+
+    def account_digipeater(self, receiver, transmission):
+        """A packet was delivered, track APRS packets heard by satellites and repeats heard back by their origin."""
+        message_id = self.aprs_message_id(transmission.payload)
+        if message_id is None:
+            return
+        if transmission.source.kind == KIND_APRS and receiver.kind == KIND_FSW:
+            receiver.aprs_heard.add(message_id)
+        elif transmission.source.kind == KIND_FSW and message_id in self.aprs_origin:
+            origin, tx_start = self.aprs_origin[message_id]
+            if receiver is origin and message_id not in origin.aprs_repeated:
+                origin.aprs_repeated.add(message_id)
+                origin.latencies.append(transmission.end - tx_start)
+
+    # ---------------------------------------------------------------------------------------------------------------
+    # Sockets
+    # ---------------------------------------------------------------------------------------------------------------
+
+    def _accept(self):
+        conn, _ = self.server.accept()
+        conn.setblocking(True)
+        node = Node(f"pending{len(self.nodes)}", None, conn)
+        self.selector.register(conn, selectors.EVENT_READ, node)
+
+    def _read(self, node):
+        try:
+            data = node.conn.recv(4096)
+        except OSError:
+            data = b""
+        if not data:
+            self.selector.unregister(node.conn)
+            node.conn.close()
+            node.conn = None
+            return
+        frames, node.buffer = decode_frames(node.buffer + data)
+        for frame_type, payload in frames:
+            if frame_type == FRAME_HELLO:
+                node.kind, node.name = payload.decode().split(":", 1)
+                self.add_node(node)
+                print(f"[BROKER] {node.kind} node {node.name} connected")
+            elif frame_type == FRAME_TX and node.kind is not None:
+                self.transmit(node, payload)
+
+    def run(self, duration):
+        while self.now() < duration:
+            now = self.now()
+            while self.events and self.events[0][0] <= now:
+                _, _, callback = heapq.heappop(self.events)
+                callback()
+            timeout = 0.05
+            if self.events:
+                timeout = min(timeout, max(0.0, (self.events[0][0] - now) / self.speedup))
+            for key, _ in self.selector.select(timeout):
+                if key.fileobj is self.server:
+                    self._accept()
+                else:
+                    self._read(key.data)
+        self.close()
+
+    def close(self):
+        for key in list(self.selector.get_map().values()):
+            key.fileobj.close()
+        self.selector.close()
+
+    # ---------------------------------------------------------------------------------------------------------------
+    # Metrics
+    # ---------------------------------------------------------------------------------------------------------------
+
+    def report(self):
+        duration = max(self.now(), 1e-9)
+        nodes = {}
+        for node in self.nodes:
+            entry = {
+                "kind": node.kind,
+                "tx_packets": node.tx_packets,
+                "tx_throughput_Bps": node.tx_bytes / duration,
+                "tx_duty_cycle": node.tx_airtime / duration,
+                "rx_packets": node.rx_packets,
+                "rx_throughput_Bps": node.rx_bytes / duration,
+                "lost_collision": node.lost_collision,
+                "lost_random": node.lost_random,
+            }
+            if node.kind == KIND_FSW:
+                entry["aprs_heard"] = len(node.aprs_heard)
+                entry["aprs_repeated"] = len(node.aprs_repeated & node.aprs_heard)
+                # Heard but never repeated: dropped by DigipeaterRxQueue (or still queued at the end of the run)
+                entry["aprs_queue_drops"] = len(node.aprs_heard - node.aprs_repeated)
+            if node.latencies:
+                latencies = sorted(node.latencies)
+                entry["latency_mean_s"] = sum(latencies) / len(latencies)
+                entry["latency_p50_s"] = latencies[len(latencies) // 2]
+                entry["latency_p95_s"] = latencies[min(len(latencies) - 1, int(0.95 * len(latencies)))]
+                entry["latency_max_s"] = latencies[-1]
+            nodes[node.name] = entry
+        total_tx = sum(node.tx_packets for node in self.nodes)
+        return {
+            "duration_s": duration,
+            "channel_utilisation": self.busy_time / duration,
+            "collision_ratio": self.collisions / total_tx if total_tx else 0.0,
+            "nodes": nodes,
+        }
+
+
+class AprsUser(Node):
+    """Synthetic LoRa APRS user, Poisson arrivals, addressed through the satellite digipeater."""
+
+    def __init__(self, index, rate, sc_callsign):
+        super().__init__(f"aprs{index:03d}", KIND_APRS)
+        self.index = index
+        self.rate = rate
+        self.sc_callsign = sc_callsign
+        self.sequence = 0
+
+    def start(self, broker, at):
+        broker.schedule(at + broker.random.expovariate(self.rate), lambda: self.send(broker))
+
+    def send(self, broker):
+        self.sequence += 1
+        message_id = self.index * 1000000 + self.sequence
+        payload = APRS_HEADER + f"U{self.index:03d}>APLRG1,{self.sc_callsign},WIDE1-1:>ID{message_id}".encode()
+        transmission = broker.transmit(self, payload)
+        broker.aprs_origin[message_id] = (self, transmission.start)
+        broker.schedule(broker.now() + broker.random.expovariate(self.rate), lambda: self.send(broker))
+
+
+class GroundStation(Node):
+    """Ground station sending a fixed uplink periodically."""
+
+    def __init__(self, uplink, period):
+        super().__init__("gs", KIND_GS)
+        self.uplink = uplink
+        self.period = period
+
+    def start(self, broker, at):
+        broker.schedule(at, lambda: self.send(broker))
+
+    def send(self, broker):
+        broker.transmit(self, self.uplink)
+        broker.schedule(broker.now() + self.period, lambda: self.send(broker))
+
+
+def print_report(report):
+    print(
+        f"Channel: {report['duration_s']:.0f} s, utilisation {100 * report['channel_utilisation']:.1f} %, "
+        f"collision ratio {100 * report['collision_ratio']:.1f} %"
+    )
+    header = f"{'node':<10}{'tx':>7}{'tx B/s':>9}{'duty %':>8}{'rx':>7}{'rx B/s':>9}{'coll':>6}{'loss':>6}"
+    header += f"{'heard':>7}{'rep':>6}{'drops':>7}{'lat p50':>9}{'lat p95':>9}"
+    print(header)
+    for name, entry in report["nodes"].items():
+        line = (
+            f"{name:<10}{entry['tx_packets']:>7}{entry['tx_throughput_Bps']:>9.1f}{100 * entry['tx_duty_cycle']:>8.2f}"
+            f"{entry['rx_packets']:>7}{entry['rx_throughput_Bps']:>9.1f}{entry['lost_collision']:>6}{entry['lost_random']:>6}"
+        )
+        line += f"{entry.get('aprs_heard', ''):>7}{entry.get('aprs_repeated', ''):>6}{entry.get('aprs_queue_drops', ''):>7}"
+        if "latency_p50_s" in entry:
+            line += f"{entry['latency_p50_s']:>9.2f}{entry['latency_p95_s']:>9.2f}"
+        print(line)
+
+
+def arg_parse(parser):
+    parser.add_argument("--host", type=str, default="127.0.0.1", help="Address to listen on")
+    parser.add_argument("--port", type=int, default=5600, help="Port to listen on")
+    parser.add_argument("--duration", type=float, default=600.0, help="Channel time to run for [s]")
+    parser.add_argument("--speedup", type=float, default=1.0, help="Channel time / wall time, match SIM_REAL_SPEEDUP")
+    parser.add_argument("--loss", type=float, default=0.0, help="Independent loss probability per delivery")
+    parser.add_argument("--aprs_users", type=int, default=10, help="Number of synthetic APRS users")
+    parser.add_argument("--aprs_rate", type=float, default=0.02, help="Packets per second per APRS user")
+    parser.add_argument("--warmup", type=float, default=60.0, help="Channel time before traffic starts [s]")
+    parser.add_argument(
+        "--activate_digipeater",
+        action="store_true",
+        help="Uplink DIGIPEATER_ACTIVATE from a ground station node every --activate_period (needs the splat codec)",
+    )
+    parser.add_argument("--activate_period", type=float, default=60.0, help="Period of the activation uplink [s]")
+    parser.add_argument("--seed", type=int, default=None, help="Traffic and loss random seed")
+    parser.add_argument("--report", type=str, default=None, help="Write the metrics as json to this file")
+    parser.add_argument("--flight", action="store_true", help="Use flight.yaml configuration instead of ground.yaml")
+    return parser.parse_args()
+
+
+def main(args):
+    from sil.uplink import Uplink, load_config
+
+    sc_callsign = load_config("comms", args.flight)["SC_CALLSIGN"]
+    broker = ChannelBroker(args.host, args.port, speedup=args.speedup, loss=args.loss, seed=args.seed)
+    print(f"[BROKER] Listening on {args.host}:{args.port}")
+
+    for i in range(args.aprs_users):
+        broker.add_node(AprsUser(i + 1, args.aprs_rate, sc_callsign)).start(broker, args.warmup)
+    if args.activate_digipeater:
+        uplink = Uplink(args.flight).command("DIGIPEATER_ACTIVATE")
+        broker.add_node(GroundStation(uplink, args.activate_period)).start(broker, args.warmup / 2)
+
+    try:
+        broker.run(args.duration)
+    except KeyboardInterrupt:
+        broker.close()
+
+    report = broker.report()
+    print_report(report)
+    if args.report:
+        with open(args.report, "w") as file:
+            json.dump(report, file, indent=2)
+    return report
+
+
+if __name__ == "__main__":
+    main(arg_parse(argparse.ArgumentParser()))
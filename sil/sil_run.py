@@ -6,6 +6,7 @@ import signal
 import subprocess
 import sys
 import time
+from concurrent.futures import ProcessPoolExecutor, as_completed
 from datetime import datetime
 
 import yaml
@@ -24,6 +25,17 @@ from sil.fsw_plotter import collect_FSW_data, plot_FSW, plot_results
 # DEFAULT_OUTFILE = "sil_logs.log"
 # DEFAULT_N_TRIALS = 1  # Default number of trials to run
 DEFAULT_CONFIGFILE = "sil_campaign_params.yaml"
+DEFAULT_JOBS = os.cpu_count() or 1
+SIM_REAL_SPEEDUP = "275"  # same as ./run.sh simulate
+LOCKSTEP_TIMEOUT_FACTOR = 10  # lockstep trials are killed after this many times their nominal runtime
+
+current_file_path = os.path.abspath(os.path.dirname(__file__))
+configs_folder_path = os.path.join(current_file_path, "configs")
+results_folder_path = os.path.join(current_file_path, "results")
+builds_folder_path = os.path.join(project_root, "build", "sil")
+
+# Written in each trial result folder once the trial data has been collected, used to resume campaigns
+TRIAL_STATUS_FILE = "trial_status.yaml"
 
 # KEYWORD SEARCHES:
 # List of all keywords to probe the log for
@@ -31,20 +43,66 @@ DEFAULT_CONFIGFILE = "sil_campaign_params.yaml"
 KEYWORDS = {"WARNING": "\033[93m", "ERROR": "\033[91m"}
 
 
-def FSW_simulate(runtime: float, outfile: str, trial_number: int, trial_date: str, sim_set_name: str) -> None:
+def FSW_simulate(
+    runtime: float,
+    outfile: str,
+    trial_number: int,
+    trial_date: str,
+    sim_set_name: str,
+    build_folder: str,
+    sim_config_file: str,
+    lockstep: bool = False,
+) -> None:
+    """
+    Runs one emulator instance from its own build folder, with the same environment as `./run.sh simulate`.
+
+    In lockstep mode the FSW runs on a virtual clock for runtime * SIM_REAL_SPEEDUP simulated seconds, the same
+    span an accelerated run covers, and exits by itself as fast as the host allows.
+    """
+    env = dict(os.environ)
+    env.update(
+        {
+            "ARGUS_ROOT": project_root,
+            "ARGUS_SIMULATION_FLAG": "1",
+            "SIM_REAL_SPEEDUP": SIM_REAL_SPEEDUP,
+            "ARGUS_SIMULATION_TRIAL": str(trial_number),
+            "ARGUS_SIMULATION_DATE": trial_date,
+            "ARGUS_SIMULATION_SET_NAME": sim_set_name,
+            "ARGUS_SIMULATION_CONFIG": sim_config_file,
+        }
+    )
+    if lockstep:
+        env.update(
+            {
+                "SIM_LOCKSTEP": "1",
+                "SIM_LOCKSTEP_DURATION": str(runtime * int(SIM_REAL_SPEEDUP)),
+                "PYTHONHASHSEED": "0",
+            }
+        )
     try:
         with open(outfile, "w") as log_file:
             # option to run a number of simulations, and to run a specific trial
             process = subprocess.Popen(
-                ["./run.sh", "simulate", str(trial_number), trial_date, sim_set_name],
+                [sys.executable, "main.py"],
+                cwd=build_folder,
+                env=env,
                 stdout=log_file,
                 stderr=log_file,
-                preexec_fn=lambda: (os.setsid(), signal.alarm(20)),
+                preexec_fn=os.setsid if lockstep else lambda: (os.setsid(), signal.alarm(20)),
             )
-            print(f"Running simulation for {runtime} seconds, output written to {outfile}")
-            time.sleep(runtime)
-            print("Terminating...")
-            os.killpg(os.getpgid(process.pid), signal.SIGKILL)
+            if lockstep:
+                print(f"Running {sim_set_name} trial {trial_number} in lockstep, output written to {outfile}")
+                try:
+                    process.wait(timeout=LOCKSTEP_TIMEOUT_FACTOR * runtime)
+                except subprocess.TimeoutExpired:
+                    print(f"{sim_set_name} trial {trial_number} did not finish in time, terminating...")
+                    os.killpg(os.getpgid(process.pid), signal.SIGKILL)
+                    process.wait()
+            else:
+                print(f"Running {sim_set_name} trial {trial_number} for {runtime} seconds, output written to {outfile}")
+                time.sleep(runtime)
+                os.killpg(os.getpgid(process.pid), signal.SIGKILL)
+                process.wait()
 
     except Exception as e:
         print(f"Error: {e}")
@@ -81,11 +139,15 @@ def update(d, u, i):
     return d
 
 
-def generate_sim_set_params(sim_set_config):  # , i_sim_set: int):
-    # generate params.yaml for this sim set
-    configs_folder_path = os.path.join(os.path.abspath(os.path.dirname(__file__)), "configs")
+def generate_sim_set_params(sim_set_config, sim_set_name):
+    """
+    Generates the params file of a sim set from nominal_params.yaml and the set param_changes.
+    Each set gets its own params_<set>.yaml so sets can run concurrently, configs/params.yaml is kept for ./run.sh.
+
+    Returns the path of the generated params file.
+    """
     nominal_config_file_path = os.path.join(configs_folder_path, "nominal_params.yaml")
-    sim_set_config_file_path = os.path.join(configs_folder_path, "params.yaml")
+    sim_set_config_file_path = os.path.join(configs_folder_path, f"params_{sim_set_name}.yaml")
     if os.path.exists(sim_set_config_file_path):
         os.remove(sim_set_config_file_path)
     shutil.copy(nominal_config_file_path, sim_set_config_file_path)
@@ -99,32 +161,131 @@ def generate_sim_set_params(sim_set_config):  # , i_sim_set: int):
         with open(sim_set_config_file_path, "w") as file:
             yaml.dump(params_data, file)
 
-    return sim_set_config
+    shutil.copy(sim_set_config_file_path, os.path.join(configs_folder_path, "params.yaml"))
 
+    return sim_set_config_file_path
 
-def run_simulation_trial(trial_number: int, trial_date: str, sim_set_name: str, set_config_params, args) -> None:
+
+def build_emulator(build_folder):
+    """Builds the emulator once per campaign, trials copy this build into their own folder."""
+    subprocess.run(
+        [sys.executable, "build_tools/build-emulator.py", "--build_folder", build_folder],
+        cwd=project_root,
+        stdout=subprocess.DEVNULL,
+        check=True,
+    )
+
+
+def trial_result_folder(trial_date, sim_set_name, trial_number):
+    return os.path.join(results_folder_path, trial_date, sim_set_name, "trials", "trial" + str(trial_number))
+
+
+def trial_completed(trial_date, sim_set_name, trial_number):
+    return os.path.exists(os.path.join(trial_result_folder(trial_date, sim_set_name, trial_number), TRIAL_STATUS_FILE))
+
+
+def run_simulation_trial(
+    trial_number: int, trial_date: str, sim_set_name: str, set_config_params, sim_config_file, template_build_folder, args
+):
+    """
+    Runs a single trial in an isolated build folder and collects its data.
+    Runs in a worker process, returns the trial status written to the trial result folder.
+    """
+    start = time.monotonic()
+    trial_result_folder_path = trial_result_folder(trial_date, sim_set_name, trial_number)
+    # The simulator creates the trial folder itself, clear leftovers of an interrupted run
+    if os.path.exists(trial_result_folder_path):
+        shutil.rmtree(trial_result_folder_path)
+
+    build_folder = os.path.join(builds_folder_path, trial_date, f"{sim_set_name}_trial{trial_number}")
+    if os.path.exists(build_folder):
+        shutil.rmtree(build_folder)
+    shutil.copytree(template_build_folder, build_folder)
+    outfile = os.path.join(build_folder, set_config_params["outfile"])
 
     # Run FSW Simulation
     FSW_simulate(
         int(set_config_params["runtime"]),
-        set_config_params["outfile"],
+        outfile,
         trial_number=trial_number,
         trial_date=trial_date,
         sim_set_name=sim_set_name,
+        build_folder=build_folder,
+        sim_config_file=sim_config_file,
+        lockstep=args.lockstep,
     )
+
     # Collect FSW data
-    trial_result_folder_path = os.path.join(
-        current_file_path, "results", trial_date, sim_set_name, "trials", "trial" + str(trial_number)
-    )
     os.makedirs(trial_result_folder_path, exist_ok=True)
+    with open(outfile, "r", errors="replace") as log_file:
+        n_errors = sum(1 for line in log_file if "ERROR" in line)
     collect_FSW_data(
-        set_config_params["outfile"],
+        outfile,
+        os.path.join(build_folder, "sd"),
         trial_result_folder_path,
         save_sil_logs=args.store_sil_logs_results,
         erase_sil_logs=args.erase_sil_logs,
-        percent_to_log=set_config_params["fsw_percent_to_log"],
     )
-    print(f"Trial {trial_number} of {sim_set_name} completed. Results saved to {trial_result_folder_path}")
+    if not args.keep_builds:
+        shutil.rmtree(build_folder, ignore_errors=True)
+
+    status = {"trial": trial_number, "errors": n_errors, "wall_time": round(time.monotonic() - start, 1)}
+    with open(os.path.join(trial_result_folder_path, TRIAL_STATUS_FILE), "w") as file:
+        yaml.dump(status, file)
+    return status
+
+
+def finalize_sim_set(trial_date, sim_set, sim_set_config, args):
+    """
+    Runs the plotting and log checks of a sim set once all its trials are done.
+    Returns a list with the error message if any step failed, so the campaign can carry on with the other sets.
+    """
+    try:
+        _finalize_sim_set(trial_date, sim_set, sim_set_config, args)
+    except Exception as e:
+        print(f"Simulation Set {sim_set} failed: {e}")
+        return [f"{sim_set}: {e}"]
+    return []
+
+
+def _finalize_sim_set(trial_date, sim_set, sim_set_config, args):
+    # Run Plotting (Sim states)
+    sim_set_folder_path = os.path.join("sil/results", trial_date, sim_set)
+
+    # Write description.txt
+    description_file_path = os.path.join(sim_set_folder_path, "description.txt")
+    with open(description_file_path, "w") as description_file:
+        description_file.write(sim_set_config["description"])
+
+    plot_results(result_folder_path=sim_set_folder_path)
+    # plot_all(result_folder_path=result_folder_path)
+
+    # Run Plotting (from Sim and FSW logs)
+    plot_FSW(result_folder_path=sim_set_folder_path)
+
+    # Parse Logs
+    if args.store_sil_logs_results:
+        for i in range(sim_set_config["num_sims"]):
+            trial_number = i + 1
+            trial_result_folder_path = os.path.join(sim_set_folder_path, "trials/trial" + str(trial_number))
+            parse_FSW_logs(os.path.join(trial_result_folder_path, sim_set_config["outfile"]))
+
+
+def write_campaign_summary(campaign_folder_path, summary, wall_time):
+    """Prints and stores the per-set trial counts, error counts and run times of the campaign."""
+    lines = [f"Campaign wall time: {wall_time:.1f} s"]
+    for sim_set, set_summary in summary.items():
+        trial_times = [s["wall_time"] for s in set_summary["trials"].values() if s is not None]
+        mean_time = sum(trial_times) / len(trial_times) if trial_times else 0.0
+        lines.append(
+            f"{sim_set}: {set_summary['completed']}/{set_summary['total']} completed "
+            f"({set_summary['skipped']} resumed, {set_summary['failed']} failed), "
+            f"{sum(s['errors'] for s in set_summary['trials'].values() if s is not None)} FSW errors, "
+            f"mean trial time {mean_time:.1f} s"
+        )
+    print("\n".join(lines))
+    with open(os.path.join(campaign_folder_path, "campaign_summary.txt"), "w") as file:
+        file.write("\n".join(lines) + "\n")
 
 
 def arg_parse(parser):
@@ -148,6 +309,30 @@ def arg_parse(parser):
         default=False,
         help="Flag to store SIL logs for each trial in results trial folder [default: False]",
     )
+    parser.add_argument(
+        "-j",
+        "--jobs",
+        type=int,
+        default=DEFAULT_JOBS,
+        help=f"Maximum number of trials running concurrently [int, default: {DEFAULT_JOBS}]",
+    )
+    parser.add_argument(
+        "--resume",
+        default=None,
+        help="Campaign folder name (date) to resume, completed trials are skipped [string, default: new campaign]",
+    )
+    parser.add_argument(
+        "--lockstep",
+        action="store_true",
+        default=False,
+        help="Flag to run the FSW on a virtual clock in lockstep with the simulation, reproducible [default: False]",
+    )
+    parser.add_argument(
+        "--keep_builds",
+        action="store_true",
+        default=False,
+        help="Flag to keep the per-trial emulator build folders under build/sil [default: False]",
+    )
 
     # Parse Arguments
     return parser.parse_args()
@@ -161,55 +346,98 @@ if __name__ == "__main__":
     # args.store_sil_logs_results = False
     # args.erase_sil_logs = True
 
-    trial_date = datetime.now().strftime("%Y-%m-%d_%H-%M-%S")
-    current_file_path = os.path.abspath(os.path.dirname(__file__))
-    campaign_folder_path = os.path.join(current_file_path, "results", trial_date)
-    campaign_config_file_path = os.path.join(current_file_path, "configs", args.sil_campaign_config_file)
+    if args.resume:
+        trial_date = args.resume
+        campaign_folder_path = os.path.join(results_folder_path, trial_date)
+        # Resumed campaigns run with the config they were started with
+        campaign_config_file_path = os.path.join(campaign_folder_path, "sil_campaign_params.yaml")
+    else:
+        trial_date = datetime.now().strftime("%Y-%m-%d_%H-%M-%S")
+        campaign_folder_path = os.path.join(results_folder_path, trial_date)
+        campaign_config_file_path = os.path.join(configs_folder_path, args.sil_campaign_config_file)
 
     # Read sil campaign config to determine number of sim sets
     with open(campaign_config_file_path, "r") as file:
         sil_campaign_params = yaml.safe_load(file)
     sim_sets = sil_campaign_params["sil_campaign"]
-    n_sim_sets = len(sim_sets.keys())
-
-    # Run campaign script
-    os.makedirs(campaign_folder_path)
-    # Copy the campaign config file to the campaign folder
-    shutil.copy(campaign_config_file_path, os.path.join(campaign_folder_path, "sil_campaign_params.yaml"))
-    for sim_set in sim_sets.keys():
-        print(f"Running Simulation Set {sim_set}...")
-        # Generate sim set params file
-        set_config_params = generate_sim_set_params(sil_campaign_params["sil_campaign"][sim_set])
-        sim_set_folder_path = os.path.join(campaign_folder_path, sim_set)
-        n_trials = sil_campaign_params["sil_campaign"][sim_set]["num_sims"]
-        # Run simulation set script
-        for i in range(n_trials):
-            run_simulation_trial(
-                trial_number=i + 1,
-                trial_date=trial_date,
-                sim_set_name=sim_set,
-                set_config_params=set_config_params,
-                args=args,
-            )
 
-        # Run Plotting (Sim states)
-        sim_set_folder_path = os.path.join("sil/results", trial_date, sim_set)
+    if not args.resume:
+        os.makedirs(campaign_folder_path)
+        # Copy the campaign config file to the campaign folder
+        shutil.copy(campaign_config_file_path, os.path.join(campaign_folder_path, "sil_campaign_params.yaml"))
 
-        # Write description.txt
-        description_file_path = os.path.join(sim_set_folder_path, "description.txt")
-        with open(description_file_path, "w") as description_file:
-            description_file.write(sil_campaign_params["sil_campaign"][sim_set]["description"])
+    # Build the emulator once, each trial runs from a copy of it
+    template_build_folder = os.path.join(builds_folder_path, trial_date, "template")
+    build_emulator(template_build_folder)
 
-        # os.path.join(campaign_folder_path, f"sil_set_{i_sim_set}")
-        plot_results(result_folder_path=sim_set_folder_path)
-        # plot_all(result_folder_path=result_folder_path)
+    campaign_start = time.monotonic()
+    summary = {}
+    pending = {}  # future -> (sim_set, trial_number)
+    remaining = {}  # sim_set -> number of trials still running
+    set_errors = []  # plotting / log check failures, raised once the whole campaign is done
 
-        # Run Plotting (from Sim and FSW logs)
-        plot_FSW(result_folder_path=sim_set_folder_path)
+    with ProcessPoolExecutor(max_workers=max(1, args.jobs)) as executor:
+        for sim_set, sim_set_config in sim_sets.items():
+            # Generate sim set params file
+            sim_config_file = generate_sim_set_params(sim_set_config, sim_set)
+            n_trials = sim_set_config["num_sims"]
+            summary[sim_set] = {"total": n_trials, "completed": 0, "skipped": 0, "failed": 0, "trials": {}}
 
-        # Parse Logs
-        if args.store_sil_logs_results:
             for i in range(n_trials):
                 trial_number = i + 1
-                trial_result_folder_path = os.path.join(sim_set_folder_path, "trials/trial" + str(trial_number))
-                parse_FSW_logs(os.path.join(trial_result_folder_path, set_config_params["outfile"]))
+                if trial_completed(trial_date, sim_set, trial_number):
+                    status_file = os.path.join(trial_result_folder(trial_date, sim_set, trial_number), TRIAL_STATUS_FILE)
+                    with open(status_file, "r") as file:
+                        summary[sim_set]["trials"][trial_number] = yaml.safe_load(file)
+                    summary[sim_set]["completed"] += 1
+                    summary[sim_set]["skipped"] += 1
+                    continue
+
+                future = executor.submit(
+                    run_simulation_trial,
+                    trial_number,
+                    trial_date,
+                    sim_set,
+                    sim_set_config,
+                    sim_config_file,
+                    template_build_folder,
+                    args,
+                )
+                pending[future] = (sim_set, trial_number)
+                remaining[sim_set] = remaining.get(sim_set, 0) + 1
+
+            print(
+                f"Queued Simulation Set {sim_set}: {remaining.get(sim_set, 0)} trials, {summary[sim_set]['skipped']} already done"
+            )
+            if remaining.get(sim_set, 0) == 0:
+                set_errors += finalize_sim_set(trial_date, sim_set, sim_set_config, args)
+
+        n_done = 0
+        for future in as_completed(pending):
+            sim_set, trial_number = pending[future]
+            n_done += 1
+            try:
+                status = future.result()
+                summary[sim_set]["completed"] += 1
+                result = f"done in {status['wall_time']} s, {status['errors']} FSW errors"
+            except Exception as e:
+                status = None
+                summary[sim_set]["failed"] += 1
+                result = f"FAILED: {e}"
+            summary[sim_set]["trials"][trial_number] = status
+            print(f"[{n_done}/{len(pending)}] {sim_set} trial {trial_number} {result}")
+
+            # Plot each set as soon as its last trial is in, the pool keeps running the others
+            remaining[sim_set] -= 1
+            if remaining[sim_set] == 0:
+                print(f"Simulation Set {sim_set} finished, plotting...")
+                set_errors += finalize_sim_set(trial_date, sim_set, sim_sets[sim_set], args)
+
+    if not args.keep_builds:
+        shutil.rmtree(template_build_folder, ignore_errors=True)
+
+    write_campaign_summary(campaign_folder_path, summary, time.monotonic() - campaign_start)
+
+    failed_trials = sum(set_summary["failed"] for set_summary in summary.values())
+    if set_errors or failed_trials:
+        raise Exception(f"SIL campaign failed: {failed_trials} failed trials\n" + "\n".join(set_errors))
@@ -0,0 +1,85 @@
+"""
+Ground side packing of uplink commands for the host tools (RF channel broker, ground station simulator).
+
+Commands are packed with the flight splat codec and, when authentication is enabled, signed the way
+apps.comms.auth.verify_authenticated_command expects:
+    [nonce (4B)][HMAC-SHA256(key, payload + nonce) (32B)][payload]
+"""
+
+import hashlib
+import hmac
+import os
+import sys
+
+import yaml
+
+project_root = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+flight_folder_path = os.path.join(project_root, "flight")
+
+AUTH_NONCE_SIZE = 4
+AUTH_MAC_SIZE = 32
+
+_codec = None
+
+
+def load_config(section, use_flight_config=False):
+    """{KEY: value} of a section of the flight software configuration (ground.yaml or flight.yaml)."""
+    config_file = "flight.yaml" if use_flight_config else "ground.yaml"
+    with open(os.path.join(flight_folder_path, "configuration", config_file), "r") as file:
+        config_data = yaml.safe_load(file)
+    return {key: entry["value"] for key, entry in (config_data.get(section) or {}).items()}
+
+
+def codec():
+    """The splat telemetry codec module of the flight software, imported on first use."""
+    global _codec
+    if _codec is None:
+        if project_root not in sys.path:
+            sys.path.append(project_root)
+        if flight_folder_path not in sys.path:
+            sys.path.append(flight_folder_path)
+        import emulator.cp_mock  # noqa: F401, CircuitPython modules used by splat
+
+        from apps.telemetry.splat.splat import telemetry_codec
+
+        _codec = telemetry_codec
+    return _codec
+
+
+def sign(payload, auth_key, nonce=None):
+    """Prefixes a packed command with its nonce and MAC."""
+    if nonce is None:
+        nonce = os.urandom(AUTH_NONCE_SIZE)
+    mac = hmac.new(auth_key, bytes(payload) + nonce, hashlib.sha256).digest()
+    return nonce + mac + bytes(payload)
+
+
+class Uplink:
+    """Packs (and signs) commands as the configured ground station."""
+
+    def __init__(self, use_flight_config=False):
+        config = load_config("comms", use_flight_config)
+        self.gs_callsign = config["GS_CALLSIGN"]
+        self.sc_callsign = config["SC_CALLSIGN"]
+        self.auth_key = bytes.fromhex(config["AUTH_KEY_HEX"]) if config.get("AUTH_ENABLED", False) else None
+
+    def command(self, name, *args, nonce=None):
+        command = codec().Command(name)
+        if args:
+            command.set_arguments(*args)
+        packet = codec().pack(command, callsign=self.gs_callsign)
+        if self.auth_key is not None:
+            packet = sign(packet, self.auth_key, nonce)
+        return packet
+
+    @staticmethod
+    def command_id(name):
+        """Command id the FSW acknowledges a command with (Ack.cmd_id)."""
+        codec()
+        from apps.telemetry.splat.splat.telemetry_definition import COMMAND_IDS
+
+        return COMMAND_IDS[name]
+
+    def unpack(self, packet):
+        """(callsign, message object) of a downlinked packet."""
+        return codec().unpack(packet)
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""
+Benchmark of driver calls through the HAL fault-tracking proxy (hal/drivers/objectWrapper.py).
+
+Compares, on the emulator IMU driver:
+    raw       direct driver call
+    closure   previous objectWrapper, building a wrapped closure on every attribute access
+    cached    current objectWrapper, wrapping each method once per device
+
+For each, the time per call and the heap left behind by the method lookups (bytes per lookup, with the looked up
+methods kept alive so the allocation is visible to tracemalloc). A raw lookup builds a bound method; the lookup
+allocation is what each call adds to the board heap between collections.
+
+Usage:
+    python tests/bench_object_wrapper.py [calls]
+"""
+import os
+import sys
+import time
+import tracemalloc
+
+# Add project paths
+project_root = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+sys.path.insert(0, project_root)
+
+import tests.cp_mock  # noqa: E402,F401
+from emulator.drivers.imu import IMU  # noqa: E402
+from flight.hal.drivers.objectWrapper import objectWrapper  # noqa: E402
+
+
+class closureWrapper:
+    """objectWrapper before method caching, kept as the benchmark reference."""
+
+    def __init__(self, obj):
+        self.obj = obj
+        self.fnError = False
+
+    def __getattr__(self, name):
+        attr = getattr(self.obj, name)
+        if callable(attr):
+
+            def wrapped_method(*args, **kwargs):
+                try:
+                    return attr(*args, **kwargs)
+                except Exception as e:
+                    self.fnError = True
+                    raise RuntimeError(f"Error calling method '{name}': {e}")
+
+            return wrapped_method
+        return attr
+
+
+def time_per_call(device, calls):
+    start = time.perf_counter_ns()
+    for _ in range(calls):
+        device.gyro()
+        device.mag()
+    return (time.perf_counter_ns() - start) / (2 * calls)
+
+
+def bytes_per_lookup(device, lookups):
+    methods = [None] * lookups
+    device.gyro  # first access of the cached proxy builds its wrapper
+    tracemalloc.start()
+    before = tracemalloc.get_traced_memory()[0]
+    for i in range(lookups):
+        methods[i] = device.gyro
+    allocated = tracemalloc.get_traced_memory()[0] - before
+    tracemalloc.stop()
+    return allocated / lookups
+
+
+def main(calls=100000):
+    devices = {}
+    for name, proxy in (("raw", None), ("closure", closureWrapper), ("cached", objectWrapper)):
+        imu = IMU()
+        imu.enable()
+        devices[name] = imu if proxy is None else proxy(imu)
+
+    raw_ns = time_per_call(devices["raw"], calls)
+    print(f"{'':8} {'ns/call':>8} {'x raw':>6} {'B/lookup':>9}")
+    for name, device in devices.items():
+        call_ns = time_per_call(device, calls)
+        print(f"{name:8} {call_ns:8.0f} {call_ns / raw_ns:6.2f} {bytes_per_lookup(device, calls // 10):9.1f}")
+
+
+if __name__ == "__main__":
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 100000)
@@ -0,0 +1,217 @@
+import asyncio
+import sys
+from types import SimpleNamespace
+
+import numpy as np
+
+import tests.cp_mock  # noqa: F401
+from flight.apps.adcs.consts import StatusConst
+from flight.core import template_task
+from flight.core.states import STATES
+from flight.tasks import adcs_mag
+
+# Modules as imported by the flight tasks
+ADCSState = adcs_mag.ADCSState
+task_module = sys.modules[adcs_mag.TemplateTask.__module__]
+
+
+def test_mag_sampled_in_coil_off_window(monkeypatch):
+    events = []
+
+    now = [10_000_000_000]
+
+    def zero_all_coils():
+        events.append("zero")
+        ADCSState.coils_on = False
+        ADCSState.coils_off_ns = now[0]
+
+    def read_magnetometer(averaged=True):
+        events.append(("sample", averaged, ADCSState.coil_hold_off))
+        return StatusConst.OK, np.array([1.0e-5, 2.0e-5, 3.0e-5])
+
+    async def sleep(seconds):
+        events.append(("sleep", seconds, ADCSState.coil_hold_off))
+        now[0] += int(seconds * 1e9)
+
+    monkeypatch.setattr(adcs_mag, "SM", SimpleNamespace(current_state=STATES.NOMINAL))
+    monkeypatch.setattr(adcs_mag, "DH", SimpleNamespace(data_process_exists=lambda tag: True))
+    monkeypatch.setattr(adcs_mag, "field_strength", lambda unix_time: None)
+    monkeypatch.setattr(adcs_mag.time, "monotonic_ns", lambda: now[0])
+    monkeypatch.setattr(adcs_mag, "zero_all_coils", zero_all_coils)
+    monkeypatch.setattr(adcs_mag.sensors, "read_magnetometer", read_magnetometer)
+    monkeypatch.setattr(task_module, "sleep", sleep)
+    monkeypatch.setattr(ADCSState, "coils_on", True)
+    task = adcs_mag.Task(0)
+
+    # Coils driven: zeroed, held off while the field settles, then sampled from the data register
+    asyncio.run(task.main_task())
+    assert events == ["zero", ("sleep", adcs_mag._COIL_OFF_SETTLE_S, True), ("sample", False, True)]
+    assert not ADCSState.coil_hold_off
+    assert list(ADCSState.mag_data) == [1.0e-5, 2.0e-5, 3.0e-5]
+
+    # Coils off for longer than the settling time: sampled right away
+    events.clear()
+    asyncio.run(task.main_task())
+    assert events == [("sample", False, True)]
+
+    # Coils zeroed by the actuation duty cycle 30 ms ago: only the rest of the settling time is waited
+    ADCSState.coils_off_ns = now[0] - 30_000_000
+    events.clear()
+    asyncio.run(task.main_task())
+    assert len(events) == 2 and events[1] == ("sample", False, True)
+    assert events[0][0] == "sleep" and abs(events[0][1] - (adcs_mag._COIL_OFF_SETTLE_S - 0.03)) < 1e-9
+
+    # The hold off is released if the read fails
+    monkeypatch.setattr(adcs_mag.sensors, "read_magnetometer", lambda averaged=True: 1 / 0)
+    asyncio.run(task._run())
+    assert not ADCSState.coil_hold_off
+
+
+def test_mag_loop_persists_calibration(monkeypatch):
+    MagCalibration = adcs_mag.MagCalibration
+    IDX = adcs_mag.MAG_CAL_IDX
+    logged = []
+    restored = {
+        IDX.SAMPLES: 200,
+        IDX.OFFSET_X: 1.0e-6,
+        IDX.OFFSET_Y: 2.0e-6,
+        IDX.OFFSET_Z: 3.0e-6,
+        IDX.SOFT_IRON_XX: 1.1,
+        IDX.SOFT_IRON_XY: 0.01,
+        IDX.SOFT_IRON_XZ: 0.02,
+        IDX.SOFT_IRON_YY: 0.9,
+        IDX.SOFT_IRON_YZ: 0.03,
+        IDX.SOFT_IRON_ZZ: 1.0,
+        IDX.RESIDUAL: 1.0e-7,
+    }
+    registry = set()
+    fake_dh = SimpleNamespace(
+        data_process_exists=lambda tag: tag in registry,
+        register_data_process=lambda tag, *args, **kwargs: registry.add(tag),
+        get_latest_data=lambda tag: restored,
+        log_data=lambda tag, data: logged.append((tag, list(data.values()))),
+    )
+    monkeypatch.setattr(adcs_mag, "SM", SimpleNamespace(current_state=STATES.NOMINAL))
+    monkeypatch.setattr(adcs_mag, "DH", fake_dh)
+    monkeypatch.setattr(adcs_mag, "field_strength", lambda unix_time: 4.0e-5)
+    monkeypatch.setattr(adcs_mag.sensors, "read_magnetometer", lambda averaged=True: (StatusConst.OK, np.ones(3) * 1e-5))
+    monkeypatch.setattr(MagCalibration, "add_sample", classmethod(lambda cls, raw, strength, unix_time: True))
+    monkeypatch.setattr(ADCSState, "coils_on", False)
+    MagCalibration.reset()
+    task = adcs_mag.Task(0)
+
+    # Restored from the latest record on the first cycle, logged after an accepted fit
+    asyncio.run(task.main_task())
+    assert "mag_cal" in registry
+    assert np.allclose(MagCalibration.offset, [1.0e-6, 2.0e-6, 3.0e-6])
+    assert np.allclose(MagCalibration.soft_iron, [[1.1, 0.01, 0.02], [0.01, 0.9, 0.03], [0.02, 0.03, 1.0]])
+    assert len(logged) == 1 and logged[0][0] == "mag_cal"
+    assert logged[0][1][IDX.SAMPLES] == 200
+    assert np.isclose(logged[0][1][IDX.SOFT_IRON_YZ], 0.03)
+    MagCalibration.reset()
+
+
+def test_task_suspension_not_charged(monkeypatch):
+    now = [0]
+
+    class Suspend:
+        def __await__(self):
+            yield
+
+    async def main_task():
+        now[0] += 1000
+        await task.sleep(0.08)
+        now[0] += 500
+        await Suspend()  # e.g. await sleep(0) to yield to the other tasks
+        now[0] += 200
+
+    monkeypatch.setattr(template_task, "sleep", lambda seconds: Suspend())
+    monkeypatch.setattr(template_task.time, "monotonic_ns", lambda: now[0])
+    task = template_task.TemplateTask(0)
+    task.main_task = main_task
+
+    # Driven as by the scheduler, other tasks run while main_task is suspended
+    run = task._run()
+    for _ in range(2):
+        run.send(None)
+        now[0] += 80_000_000
+    try:
+        run.send(None)
+    except StopIteration:
+        pass
+    assert task.run_time_ns == 1700
+
+
+def test_gyro_loop_estimates_attitude(monkeypatch):
+    from flight.tasks import adcs_gyro
+
+    AD = adcs_gyro.AD
+    sun_eci, field_eci = np.array([0.0, 0.6, 0.8]), np.array([1.0, 0.0, 0.0])
+    now = [0]
+
+    monkeypatch.setattr(adcs_gyro, "SM", SimpleNamespace(current_state=STATES.NOMINAL))
+    monkeypatch.setattr(adcs_gyro.time, "monotonic_ns", lambda: now[0])
+    monkeypatch.setattr(adcs_gyro.sensors, "read_gyro", lambda: (StatusConst.OK, np.zeros(3)))
+    # Body frame aligned with ECI, sun in view
+    monkeypatch.setattr(adcs_gyro.sensors, "read_sun_position", lambda: (StatusConst.OK, sun_eci, np.zeros(9)))
+    monkeypatch.setattr(adcs_gyro, "reference_vectors", lambda unix_time: (sun_eci, field_eci))
+    monkeypatch.setattr(AD, "mag_count", 0)
+    task = adcs_gyro.Task(0)
+
+    # No field sample yet
+    asyncio.run(task.main_task())
+    assert not AD.attitude_valid
+
+    AD.set_mag(StatusConst.OK, 3.0e-5 * field_eci, 0)
+    for _ in range(20):
+        now[0] += 100_000_000
+        asyncio.run(task.main_task())
+        AD.set_mag(StatusConst.OK, 3.0e-5 * field_eci, 0)
+    assert AD.attitude_valid
+    assert np.allclose(AD.attitude_q, [1.0, 0.0, 0.0, 0.0], atol=1e-3)
+
+    # Lost in LOW_POWER
+    monkeypatch.setattr(adcs_gyro, "SM", SimpleNamespace(current_state=STATES.LOW_POWER))
+    asyncio.run(task.main_task())
+    assert not AD.attitude_valid
+
+
+def test_actuation_duty_cycle(monkeypatch):
+    from flight.tasks import adcs
+
+    AD = adcs.AD
+    events = []
+
+    def mcm_coil_allocator(u, b):
+        events.append(("drive", list(u)))
+        AD.coils_on = True
+        return [True] * 6
+
+    def zero_all_coils():
+        events.append("zero")
+        AD.coils_on = False
+
+    async def sleep(seconds):
+        events.append(("sleep", seconds))
+
+    monkeypatch.setattr(adcs, "CONFIG", SimpleNamespace(COIL_ON_FRACTION=0.5))
+    monkeypatch.setattr(adcs, "spin_stabilizing_controller", lambda omega, b: np.array([0.1, 0.0, -0.2]))
+    monkeypatch.setattr(adcs, "mcm_coil_allocator", mcm_coil_allocator)
+    monkeypatch.setattr(adcs, "zero_all_coils", zero_all_coils)
+    monkeypatch.setattr(task_module, "sleep", sleep)
+    monkeypatch.setattr(AD, "MODE", adcs.Modes.STABLE)
+    monkeypatch.setattr(AD, "gyro_status", StatusConst.OK)
+    monkeypatch.setattr(AD, "mag_status", StatusConst.OK)
+    task = adcs.Task(0)
+    task.set_frequency(5)
+
+    # Driven with the dipole scaled by the on-fraction for half of the 200 ms period, then zeroed
+    asyncio.run(task.actuate())
+    assert events == [("drive", [0.2, 0.0, -0.4]), ("sleep", 0.1), "zero"]
+    assert not AD.coils_on
+
+    # Not driven while the magnetometer loop samples
+    events.clear()
+    monkeypatch.setattr(AD, "coil_hold_off", True)
+    asyncio.run(task.actuate())
+    assert events == []
@@ -0,0 +1,140 @@
+# isort: skip_file
+import struct
+import sys
+from types import SimpleNamespace
+
+import numpy as np
+import pytest
+
+import tests.cp_mock  # noqa: F401
+
+
+class _Struct:
+    """Sensor data registers, subclassed by the driver and not read by the FIFO path."""
+
+    def __init__(self, *args, **kwargs):
+        pass
+
+
+# The driver only needs the bus device and register names at import time (other driver tests may have set them up)
+_registers = {
+    "adafruit_register.i2c_bit": ["ROBit", "RWBit"],
+    "adafruit_register.i2c_bits": ["ROBits", "RWBits"],
+}
+sys.modules.setdefault("ulab.numpy", sys.modules["ulab"].numpy)
+sys.modules.setdefault("adafruit_bus_device", SimpleNamespace())
+sys.modules.setdefault("adafruit_bus_device.i2c_device", SimpleNamespace(I2CDevice=object))
+sys.modules.setdefault("adafruit_register", SimpleNamespace())
+for module, names in _registers.items():
+    module = sys.modules.setdefault(module, SimpleNamespace())
+    for name in names:
+        if not hasattr(module, name):
+            setattr(module, name, lambda *args, **kwargs: None)
+_struct = sys.modules.setdefault("adafruit_register.i2c_struct", SimpleNamespace())
+if not hasattr(_struct, "Struct"):
+    _struct.Struct = _Struct
+
+from flight.hal.drivers import bmx160  # noqa: E402
+
+_ERR_REG, _FIFO_LENGTH, _FIFO_DATA, _GYRO_CONF, _MAG_CONF, _CMD = 0x02, 0x22, 0x24, 0x42, 0x44, 0x7E
+
+_GYRO = (100, -200, 300)
+_MAG = (-40, 50, -60)
+
+
+class Bits:
+    """Register field descriptor, backed by the registers of the fake bus."""
+
+    def __init__(self, num_bits, register_address, lowest_bit):
+        self.address = register_address
+        self.mask = ((1 << num_bits) - 1) << lowest_bit
+        self.lowest_bit = lowest_bit
+
+    def __get__(self, obj, objtype=None):
+        return (obj.i2c_device.regs.get(self.address, 0) & self.mask) >> self.lowest_bit
+
+    def __set__(self, obj, value):
+        regs = obj.i2c_device.regs
+        regs[self.address] = (regs.get(self.address, 0) & ~self.mask) | ((value << self.lowest_bit) & self.mask)
+
+
+class FakeBus:
+    """BMX160 on the I2C bus: register file, and a FIFO filled by sample() at the ODRs written to the sensors."""
+
+    def __init__(self):
+        self.regs = {0x00: 0xD8}
+        self.fifo = bytearray()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        pass
+
+    def write(self, buf, end=None):
+        self.regs[buf[0]] = buf[1]
+        if buf[0] == _CMD and buf[1] == 0xB0:
+            self.fifo = bytearray()
+
+    def write_then_readinto(self, out_buf, in_buf, out_end=None, in_start=0, in_end=None):
+        address = out_buf[0]
+        n = (len(in_buf) if in_end is None else in_end) - in_start
+        if address == _FIFO_DATA:
+            data, self.fifo = self.fifo[:n], self.fifo[n:]
+        elif address == _FIFO_LENGTH:
+            data = struct.pack("<H", len(self.fifo))
+        else:
+            data = bytes(self.regs.get(address + i, 0) for i in range(n))
+        in_buf[in_start : in_start + len(data)] = data
+
+    def sample(self, seconds):
+        """Headerless FIFO content after seconds: mag then gyro data of each sample instant, as the sensor writes it."""
+
+        def hz(register):
+            return 100 * 2 ** ((self.regs[register] & 0x0F) - 8)
+
+        mag_hz, gyro_hz = hz(_MAG_CONF), hz(_GYRO_CONF)
+        events = [(k / mag_hz, 0) for k in range(int(seconds * mag_hz))]
+        events += [(k / gyro_hz, 1) for k in range(int(seconds * gyro_hz))]
+        for _, sensor in sorted(events):
+            self.fifo += struct.pack("<4h", *_MAG, 0) if sensor == 0 else struct.pack("<3h", *_GYRO)
+
+
+@pytest.fixture
+def imu(monkeypatch):
+    monkeypatch.setattr(bmx160.time, "sleep", lambda seconds: None)
+    monkeypatch.setattr(bmx160, "I2CDevice", lambda i2c, address, probe=True: i2c)
+    registers = {
+        "cmd": (8, _CMD, 0),
+        "_error_status": (8, _ERR_REG, 0),
+        "error_code": (4, _ERR_REG, 1),
+        "_gyro_range": (8, 0x43, 0),
+        "_accel_range": (8, 0x41, 0),
+    }
+    for name, field in registers.items():
+        monkeypatch.setattr(bmx160.BMX160, name, Bits(*field))
+    return bmx160.BMX160(FakeBus(), 0x68)
+
+
+def test_fifo_frames_at_configured_rates(imu):
+    bus = imu.i2c_device
+    # Both sensors at 25 Hz
+    assert bus.regs[_GYRO_CONF] & 0x0F == bus.regs[_MAG_CONF] & 0x0F == 0x06
+    assert imu.gyro_odr == 25
+
+    bus.sample(1.0)
+    assert imu.drain_fifo() == 25
+    assert np.allclose(imu.fifo_gyro(), np.array(_GYRO) * imu.GYR_SCALAR)
+    assert np.allclose(imu.fifo_mag(), np.array(_MAG) * imu.MAG_SCALAR)
+    assert imu.drain_fifo() == 0
+
+    # Only the newest frames are kept
+    bus.sample(2.0)
+    assert imu.drain_fifo(max_frames=10) == 10
+    assert not bus.fifo
+
+
+def test_fifo_refuses_mixed_rates(imu):
+    imu.gyro_odr = 50
+    with pytest.raises(RuntimeError):
+        imu.init_fifo()
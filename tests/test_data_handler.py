@@ -1,11 +1,17 @@
 # isort: skip_file
+import importlib
 import os
+import shutil
+import struct
 
 import pytest
 
 import tests.cp_mock  # noqa: F401
 import flight.core.data_handler as dh
 from flight.core.data_handler import DataProcess as DP
+from flight.core.data_handler import DataRecord
+from flight.core import dh_constants
+from build_tools.data_schema import generate_data_schemas
 from flight.core.data_handler import extract_time_from_filename, get_closest_file_time
 
 DH = dh.DataHandler
@@ -101,6 +107,78 @@ def test_get_closest_file_time(file_time, expected_output):
     assert get_closest_file_time(file_time, invalid_files) is None
 
 
+_SCHEMAS = ["cdh", "eps", "eps_warning", "adcs", "mag_cal", "gps", "comms", "hal", "mem", "sched"]
+
+
+def test_data_schemas_in_sync(tmp_path):
+    """The committed core.schemas modules are the ones the build generates from data_schema.yaml."""
+    os.makedirs(tmp_path / "configuration")
+    shutil.copy("flight/configuration/data_schema.yaml", tmp_path / "configuration")
+    generate_data_schemas(str(tmp_path))
+
+    generated = sorted(os.listdir(tmp_path / "core" / "schemas"))
+    assert generated == sorted(["__init__.py"] + [f"{tag}.py" for tag in _SCHEMAS])
+    for name in generated:
+        with open(tmp_path / "core" / "schemas" / name) as file, open(os.path.join("flight/core/schemas", name)) as committed:
+            assert file.read() == committed.read(), f"{name} is out of date, rebuild to regenerate it"
+
+
+def test_data_schemas_failed_build(tmp_path):
+    """An invalid schema fails the build and leaves the previous modules in place."""
+    os.makedirs(tmp_path / "configuration")
+    with open(tmp_path / "configuration" / "data_schema.yaml", "w") as file:
+        file.write("cdh:\n  TIME: L\n  STATE: x\n")
+    os.makedirs(tmp_path / "core" / "schemas")
+    (tmp_path / "core" / "schemas" / "cdh.py").write_text("previous")
+
+    with pytest.raises(ValueError):
+        generate_data_schemas(str(tmp_path))
+    assert os.listdir(tmp_path / "core") == ["schemas"]
+    assert (tmp_path / "core" / "schemas" / "cdh.py").read_text() == "previous"
+
+
+@pytest.mark.parametrize("tag", _SCHEMAS)
+def test_data_schema_record(tag):
+    schema = importlib.import_module(f"core.schemas.{tag}")
+    assert schema.TAG == tag
+    assert len(schema.FORMAT) == dh_constants.class_length(getattr(schema, f"{tag.upper()}_IDX"))
+    assert schema.BYTESIZE == DP.compute_bytesize("<" + schema.FORMAT)
+
+    # Precomputed offsets match the ones parsed from the format
+    record = DataRecord(schema)
+    parsed = DataRecord(schema.FORMAT)
+    assert record.data_format == parsed.data_format
+    assert record._offsets == parsed._offsets
+    assert record._formats == parsed._formats
+    assert len(record.buffer) == schema.BYTESIZE
+
+
+def test_data_record():
+    record = DataRecord("LBfh")
+    assert len(record) == 4
+    assert len(record.buffer) == DP.compute_bytesize("<LBfh")
+
+    record[0] = 1700000000
+    record[1] = 7
+    record[2] = 0.25
+    record[3] = -300
+    assert record[0] == 1700000000
+    assert record[2] == 0.25
+    assert record[1:3] == [7, 0.25]
+    assert list(record) == [1700000000, 7, 0.25, -300]
+    assert bytes(record.buffer) == struct.pack("<LBfh", 1700000000, 7, 0.25, -300)
+
+    view = DataRecord("LBfh", record.buffer)
+    record[3] = 12
+    assert view[3] == 12
+
+    record.clear()
+    assert record.values() == (0, 0, 0.0, 0)
+
+    with pytest.raises(ValueError):
+        DataRecord("LBfh", bytearray(3))
+
+
 # TODO - mock filesystem
 
 
@@ -115,6 +193,39 @@ def sd_root(tmp_path):
     return sd_root
 
 
+def test_data_process_log_record(sd_root):
+    """A DataRecord is written as it is and cached in a view owned by the data process."""
+    dh._HOME_PATH = str(sd_root)
+    DH.register_data_process("test_record", "LhB", True, data_limit=1000)
+    record = DataRecord("LhB")
+
+    record[0] = 1700000000
+    record[1] = -5
+    record[2] = 3
+    DH.log_data("test_record", record)
+    latest = DH.get_latest_data("test_record")
+    assert latest is not record
+    assert latest[1] == -5
+
+    # The task refills its record for the next sample; the cache only changes on the next log
+    record[1] = 8
+    assert latest[1] == -5
+    DH.log_data("test_record", record)
+    assert DH.get_latest_data("test_record") is latest
+    assert latest[1] == 8
+
+    data_process = DH.data_process_registry["test_record"]
+    assert data_process.read_current_file()[-2:] == [(1700000000, -5, 3), (1700000000, 8, 3)]
+
+    # Records of another format are rejected
+    DH.log_data("test_record", DataRecord("LhH"))
+    assert len(data_process.read_current_file()) == 2
+
+    # The latest record is restored from the file at boot
+    DH.register_data_process("test_record", "LhB", True, data_limit=1000)
+    assert DH.get_latest_data("test_record").values() == (1700000000, 8, 3)
+
+
 def test_file_process_nominal_log(sd_root):
     """Test nominal file process logging with fixed-size packets."""
     dh._HOME_PATH = str(sd_root)  # temporary SD card
@@ -0,0 +1,61 @@
+# isort: skip_file
+import os
+import struct
+
+import numpy as np
+
+import tests.cp_mock  # noqa: F401
+import flight.core.data_handler as dh
+from flight.core.data_handler import DataProcess as DP
+from sil.dh_reader import format_to_dtype, merge_trials, read_process, read_sd, split_trials
+
+_ADCS_FORMAT = "LB" + 6 * "f" + "B" + 3 * "f" + 9 * "H" + 6 * "B"
+
+
+def _adcs_record(i):
+    return [1000 + i, i % 4] + [0.5 * i] * 6 + [1] + [0.25, -0.5, 1.0] + [i] * 9 + [0] * 6
+
+
+def test_format_to_dtype_matches_struct():
+    for data_format in [_ADCS_FORMAT, "LLbLbbbbb", "bBhHiIlLqQfde"]:
+        assert format_to_dtype(data_format).itemsize == struct.calcsize("<" + data_format)
+
+
+def test_read_process(tmp_path):
+    dh._HOME_PATH = str(tmp_path)  # temporary SD card
+    process = DP("adcs", _ADCS_FORMAT, persistent=True)
+    for i in range(50):
+        process.log(_adcs_record(i))
+    process.file.close()
+
+    # A later file ending with a partial record, as after a power cut mid-write
+    with open(os.path.join(tmp_path, "adcs", "adcs_9999999999.bin"), "wb") as file:
+        file.write(struct.pack("<" + _ADCS_FORMAT, *_adcs_record(50)))
+        file.write(b"\x00" * 7)
+
+    records = read_process(os.path.join(tmp_path, "adcs"))
+    assert len(records) == 51
+    assert np.array_equal(records["TIME_ADCS"], np.arange(1000, 1051))
+    assert np.array_equal(records["MODE"], np.arange(51) % 4)
+    assert np.allclose(records["GYRO_Z"], 0.5 * np.arange(51))
+    assert np.allclose(records["SUN_VEC_Y"], -0.5)
+    assert records["LIGHT_SENSOR_ZM"][-1] == 50
+
+    columns = read_sd(str(tmp_path))
+    assert set(key.split(".")[0] for key in columns) == {"adcs"}
+    assert len(columns["adcs.MAG_X"]) == 51
+
+
+def test_merge_and_split_trials():
+    trial_columns = {
+        2: {"cdh.TIME": np.array([5, 6, 7]), "cdh.SC_STATE": np.array([0, 1, 1])},
+        1: {"cdh.TIME": np.array([1, 2]), "cdh.SC_STATE": np.array([0, 2])},
+    }
+    store = merge_trials(trial_columns)
+    assert np.array_equal(store["cdh.trial"], [1, 1, 2, 2, 2])
+
+    trials = dict(split_trials(store, "cdh"))
+    assert list(trials) == [1, 2]
+    assert np.array_equal(trials[2]["TIME"], [5, 6, 7])
+    assert np.array_equal(trials[1]["SC_STATE"], [0, 2])
+    assert list(split_trials(store, "adcs")) == []
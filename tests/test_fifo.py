@@ -1,6 +1,7 @@
 import pytest
 
 from flight.apps.command.fifo import QUEUE_STATUS, CommandQueue
+from flight.apps.digipeater.fifo import DIGIPEATER_QUEUE_STATUS, DigipeaterRxQueue
 
 
 class MockCommand:
@@ -97,3 +98,16 @@ def test_overwrite_command(setup_single_element_queue):
     assert status == QUEUE_STATUS.OK
     assert cmd.command_id == 0x02
     assert cmd.get_arguments_list() == ["arg2"]
+
+
+def test_digipeater_queue_overflow():
+    DigipeaterRxQueue.clear()
+    DigipeaterRxQueue.configure(2)
+    drops = DigipeaterRxQueue.get_drop_count()
+    assert DigipeaterRxQueue.push_packet(b"1") == DIGIPEATER_QUEUE_STATUS.OK
+    assert DigipeaterRxQueue.push_packet(b"2") == DIGIPEATER_QUEUE_STATUS.OK
+    # Full: the oldest packet is overwritten and counted as dropped
+    assert DigipeaterRxQueue.push_packet(b"3") == DIGIPEATER_QUEUE_STATUS.OVERFLOW
+    assert DigipeaterRxQueue.get_drop_count() == drops + 1
+    assert DigipeaterRxQueue.pop_packet() == (b"2", DIGIPEATER_QUEUE_STATUS.OK)
+    DigipeaterRxQueue.clear()
@@ -0,0 +1,134 @@
+# isort: skip_file
+import struct
+import sys
+from types import SimpleNamespace
+
+import pytest
+
+import tests.cp_mock  # noqa: F401
+
+# The driver only needs the busio/digitalio names at import time
+sys.modules.setdefault("busio", SimpleNamespace(UART=object))
+sys.modules.setdefault("digitalio", SimpleNamespace(DigitalInOut=object, Direction=None))
+
+from flight.hal.drivers.s1216f8gl import GPS  # noqa: E402
+
+
+class MockUART:
+    """Byte-stream UART stand-in exposing the subset of busio.UART used by the GPS driver."""
+
+    def __init__(self):
+        self._data = bytearray()
+
+    def feed(self, data):
+        self._data.extend(data)
+
+    @property
+    def in_waiting(self):
+        return len(self._data)
+
+    def readinto(self, buf):
+        # busio.UART.readinto waits for len(buf) bytes until its timeout
+        assert len(buf) <= len(self._data), "read past in_waiting would block on the UART timeout"
+        n = min(len(buf), len(self._data))
+        buf[0:n] = self._data[:n]
+        self._data = self._data[n:]
+        return n
+
+    def write(self, data):
+        return len(data)
+
+
+def make_frame(payload):
+    cs = 0
+    for b in payload:
+        cs ^= b
+    return b"\xA0\xA1" + struct.pack(">H", len(payload)) + payload + bytes([cs]) + b"\x0D\x0A"
+
+
+def make_nav_payload(fix_mode=3, week=2400, tow=345600.5, ecef=(6778137.0, -1.5, 2.25), vel=(1.0, 7500.0, -3.0)):
+    return struct.pack(
+        ">BBBHddddfffdffffff",
+        0xDF,
+        1,
+        fix_mode,
+        week,
+        tow,
+        *ecef,
+        *vel,
+        1e-6,
+        0.5,
+        1.0,
+        1.5,
+        2.0,
+        2.5,
+        3.0,
+    )
+
+
+@pytest.fixture
+def gps():
+    uart = MockUART()
+    driver = GPS(uart, rx_buffer_size=256)
+    # Skip the one-shot receiver configuration commands
+    driver._DISABLE_NMEA_FLAG = False
+    driver._BINARY_SET_FLAG = False
+    driver._PERIODIC_NAV_FLAG = False
+    driver._DISABLE_UNNECESSARY_BINARY_FLAG = False
+    return driver, uart
+
+
+def test_parse_nav_frame(gps):
+    driver, uart = gps
+    uart.feed(make_frame(make_nav_payload()))
+    assert driver.update()
+    assert driver.fix_mode == 3
+    assert driver.week == 2400
+    assert driver.tow == 345600.5
+    assert (driver.ecef_x, driver.ecef_y, driver.ecef_z) == (6778137.0, -1.5, 2.25)
+    assert driver.ecef_vy == 7500.0
+    assert driver.tdop == 3.0
+
+
+def test_newest_nav_frame_wins_over_ack_and_older_nav(gps):
+    driver, uart = gps
+    uart.feed(b"\x00\x13garbage")
+    uart.feed(make_frame(make_nav_payload(week=1)))
+    uart.feed(make_frame(make_nav_payload(week=2)))
+    uart.feed(make_frame(b"\x83\x09"))
+    assert driver.update()
+    assert driver.week == 2
+    assert driver._rx_len == 0
+
+
+def test_frame_split_across_reads_and_ring_wrap(gps):
+    driver, uart = gps
+    frame = make_frame(make_nav_payload(week=7))
+    # Fill and consume enough to move the ring head close to the end of the buffer
+    for _ in range(2):
+        uart.feed(frame)
+        assert driver.update()
+    assert driver._rx_head + len(frame) > driver._max_rx_buffer_len
+
+    uart.feed(make_frame(make_nav_payload(week=8))[:30])
+    assert not driver.update()
+    uart.feed(make_frame(make_nav_payload(week=8))[30:])
+    assert driver.update()
+    assert driver.week == 8
+
+
+def test_bad_checksum_rejected(gps):
+    driver, uart = gps
+    frame = bytearray(make_frame(make_nav_payload()))
+    frame[-3] ^= 0xFF
+    uart.feed(frame)
+    assert not driver.update()
+    assert driver.last_update_status == "Checksum failed!"
+
+
+def test_ring_overflow_keeps_newest_data(gps):
+    driver, uart = gps
+    uart.feed(bytes(300))
+    uart.feed(make_frame(make_nav_payload(week=9)))
+    assert driver.update()
+    assert driver.week == 9
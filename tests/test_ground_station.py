@@ -0,0 +1,138 @@
+import pickle
+import random
+
+import pytest
+
+from emulator.rf_channel import time_on_air
+from sil.ground_station import GroundStation
+
+COMMAND_IDS = {"PING": 1, "CREATE_TRANS": 2, "GENERATE_X_PACKETS": 3, "CONFIRM_LAST_BATCH": 4}
+
+
+class Ack:
+    def __init__(self, status, cmd_id, response_args):
+        self.status = status
+        self.cmd_id = cmd_id
+        self.response_args = response_args
+
+
+class Fragment:
+    def __init__(self, tid, seq_number, payload):
+        self.tid = tid
+        self.seq_number = seq_number
+        self.payload = payload
+
+
+class Command:
+    def __init__(self, name, *args):
+        self.name = name
+        self.args = args
+
+    def get_arguments_list(self):
+        return list(self.args)
+
+
+class FakeUplink:
+    def command(self, name, *args):
+        return pickle.dumps((name, args))
+
+    @staticmethod
+    def command_id(name):
+        return COMMAND_IDS[name]
+
+    def unpack(self, packet):
+        return "CT6xxx", pickle.loads(packet)
+
+
+class FakeSatellite:
+    """Satellite side of the downlink protocol, answering instantly over a lossy link on a virtual clock."""
+
+    def __init__(self, file_data, fragment_size, batch_size, loss, seed=0):
+        self.file_data = file_data
+        self.fragment_size = fragment_size
+        self.batch_size = batch_size
+        self.n_packets = (len(file_data) + fragment_size - 1) // fragment_size
+        self.unconfirmed = set(range(self.n_packets))
+        self.loss = loss
+        self.random = random.Random(seed)
+        self.clock = 0.0
+        self.rx_queue = []
+
+    def now(self):
+        return self.clock
+
+    def downlink(self, message):
+        if self.random.random() >= self.loss:
+            self.rx_queue.append(pickle.dumps(message))
+
+    def send(self, packet):
+        self.clock += time_on_air(len(packet))
+        if self.random.random() < self.loss:
+            return
+        name, args = pickle.loads(packet)
+        response = []
+        if name == "CREATE_TRANS":
+            self.downlink(Command("INIT_TRANS", args[0], self.n_packets))
+            response = [args[0], self.n_packets]
+        elif name == "GENERATE_X_PACKETS":
+            batch = sorted(self.unconfirmed)[: args[1]]
+            for seq in batch:
+                payload = self.file_data[seq * self.fragment_size : (seq + 1) * self.fragment_size]
+                self.downlink(Fragment(args[0], seq, payload))
+            response = [len(batch)]
+        elif name == "CONFIRM_LAST_BATCH":
+            offset = min(self.unconfirmed, default=0) // self.batch_size * self.batch_size
+            width = min(self.batch_size, self.n_packets - offset)
+            bitmap = (args[1] << 32) | args[2]
+            for i in range(width):
+                if not bitmap & (1 << (width - 1 - i)):
+                    self.unconfirmed.discard(offset + i)
+            response = [len(self.unconfirmed)]
+        self.downlink(Ack(0, COMMAND_IDS[name], response))
+
+    def recv(self, timeout):
+        if self.rx_queue:
+            packet = self.rx_queue.pop(0)
+            self.clock += time_on_air(len(packet))
+            return packet
+        self.clock += timeout
+        return None
+
+
+def test_command_latency_and_retries():
+    satellite = FakeSatellite(b"", 100, 40, loss=0.0)
+    station = GroundStation(satellite, FakeUplink(), ack_timeout=5.0)
+    station.pass_start = satellite.now()
+
+    assert station.command("PING") == (0, [])
+    assert station.latencies["PING"] == [pytest.approx(satellite.clock)]
+
+    satellite.loss = 1.0
+    assert station.command("PING") is None
+    report = station.report()
+    assert report["commands_sent"] == 5
+    assert report["command_retries"] == 3
+    assert report["command_timeouts"] == 1
+
+
+@pytest.mark.parametrize("loss", [0.0, 0.2])
+def test_file_downlink(tmp_path, loss):
+    file_data = bytes(random.Random(1).randrange(256) for _ in range(9950))
+    satellite = FakeSatellite(file_data, 100, 40, loss=loss, seed=3)
+    station = GroundStation(satellite, FakeUplink(), ack_timeout=2.0, retries=5, save_folder=str(tmp_path))
+
+    report = station.run_pass([{"downlink_file": "sd/test.bin"}])
+
+    transfer = report["transfers"][0]
+    assert transfer["complete"]
+    assert transfer["packets"] == 100
+    assert (tmp_path / "test.bin").read_bytes() == file_data
+    assert transfer["bytes"] == len(file_data)
+    assert report["goodput_Bps"] > 0
+    assert 0 < report["pass_time_efficiency"] < 1
+    if loss == 0.0:
+        assert transfer["batches"] == 3
+        assert report["retransmission_ratio"] == 0
+        assert report["command_retries"] == 0
+    else:
+        assert report["retransmission_ratio"] > 0
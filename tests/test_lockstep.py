@@ -0,0 +1,84 @@
+import time
+
+import pytest
+
+import tests.cp_mock  # noqa: F401
+from emulator.accel_time import MockTime
+from flight.core.scheduler import scheduler
+
+
+@pytest.fixture
+def lockstep_time(monkeypatch):
+    monkeypatch.setenv("SIM_REAL_SPEEDUP", "1")
+    monkeypatch.setenv("SIM_LOCKSTEP", "1")
+    monkeypatch.setenv("SIM_LOCKSTEP_DURATION", "100")
+    mock_time = MockTime()
+    monkeypatch.setattr(scheduler, "time", mock_time)
+    monkeypatch.setattr(scheduler, "_monotonic_ns", mock_time.monotonic_ns)
+    return mock_time
+
+
+def _run_campaign():
+    loop = scheduler.Scheduler()
+    runs = {"fast": [], "slow": []}
+
+    async def fast():
+        runs["fast"].append(scheduler._monotonic_ns())
+
+    async def slow():
+        runs["slow"].append(scheduler._monotonic_ns())
+
+    loop.schedule(10, fast, 1)
+    loop.schedule(0.5, slow, 2)
+    with pytest.raises(SystemExit):
+        loop.run()
+    return runs
+
+
+def test_virtual_clock_is_strictly_increasing(lockstep_time):
+    reads = [lockstep_time.monotonic_ns() for _ in range(10)]
+    assert all(b > a for a, b in zip(reads, reads[1:]))
+
+    before = lockstep_time.monotonic_ns()
+    lockstep_time.sleep(2.5)
+    assert lockstep_time.monotonic_ns() - before == pytest.approx(2.5e9, abs=1e4)
+
+
+def test_lockstep_run_is_fast_and_exact(lockstep_time):
+    start = time.monotonic()
+    runs = _run_campaign()
+
+    # 100 virtual seconds run far faster than real time, with every invocation on its nominal period
+    assert time.monotonic() - start < 5
+    assert len(runs["fast"]) == pytest.approx(1000, abs=1)
+    assert len(runs["slow"]) == pytest.approx(50, abs=1)
+    periods = [(b - a) / 1e9 for a, b in zip(runs["fast"], runs["fast"][1:])]
+    assert max(periods) == pytest.approx(0.1, abs=1e-4)
+
+
+def test_lockstep_is_reproducible(monkeypatch):
+    results = []
+    for _ in range(2):
+        monkeypatch.setenv("SIM_REAL_SPEEDUP", "1")
+        monkeypatch.setenv("SIM_LOCKSTEP", "1")
+        monkeypatch.setenv("SIM_LOCKSTEP_DURATION", "20")
+        mock_time = MockTime()
+        monkeypatch.setattr(scheduler, "time", mock_time)
+        monkeypatch.setattr(scheduler, "_monotonic_ns", mock_time.monotonic_ns)
+        results.append(_run_campaign())
+    assert results[0] == results[1]
+
+
+def test_fast_boot_skips_settle_delays(lockstep_time, monkeypatch):
+    before = lockstep_time.monotonic_ns()
+    lockstep_time.settle(0.1)
+    assert lockstep_time.monotonic_ns() - before == pytest.approx(0.1e9, abs=1e4)
+
+    monkeypatch.setenv("SIM_FAST_BOOT", "1")
+    fast_time = MockTime()
+    before = fast_time.monotonic_ns()
+    fast_time.settle(1)
+    assert fast_time.monotonic_ns() - before < 1e4
+    # Only settle delays are skipped, timing delays still advance the clock
+    fast_time.sleep(1)
+    assert fast_time.monotonic_ns() - before == pytest.approx(1e9, abs=1e4)
@@ -0,0 +1,74 @@
+import numpy as np
+import pytest
+
+import tests.cp_mock  # noqa: F401
+from flight.apps.adcs.mag_calibration import _SAMPLE_PERIOD, _WINDOW, MagCalibration
+
+# Soft-iron matrix and hard-iron offset of the simulated magnetometer
+SOFT_IRON = np.array([[1.05, 0.03, -0.02], [0.03, 0.97, 0.04], [-0.02, 0.04, 1.02]])
+OFFSET = np.array([12.0e-6, -7.0e-6, 4.0e-6])
+
+
+def random_direction(rng):
+    v = rng.normal(size=3)
+    return v / np.linalg.norm(v)
+
+
+def raw_reading(field, noise, rng):
+    """Raw reading [T] of the true body field [T]."""
+    return np.linalg.solve(SOFT_IRON, field) + OFFSET + noise * rng.normal(size=3)
+
+
+@pytest.fixture(autouse=True)
+def reset_calibration():
+    MagCalibration.reset()
+    yield
+    MagCalibration.reset()
+
+
+@pytest.mark.parametrize("seed", [0, 1, 2])
+def test_calibration_converges(seed):
+    rng = np.random.default_rng(seed)
+    fits = 0
+    for k in range(_WINDOW + 64):
+        t = 1_800_000_000 + k * _SAMPLE_PERIOD
+        # Field strength varies with latitude along the orbit, the tumbling attitude covers all directions
+        strength = 40.0e-6 + 15.0e-6 * np.sin(2 * np.pi * k * _SAMPLE_PERIOD / 5600.0)
+        raw = raw_reading(strength * random_direction(rng), 0.2e-6, rng)
+        fits += MagCalibration.add_sample(raw, strength, t)
+
+    assert fits > 0
+    assert MagCalibration.samples >= 96
+    assert np.allclose(MagCalibration.soft_iron, SOFT_IRON, atol=0.01)
+    assert np.allclose(MagCalibration.offset, OFFSET, atol=0.5e-6)
+    assert MagCalibration.residual < 0.5e-6
+
+    # Applied in place to a raw reading
+    field = 30.0e-6 * random_direction(rng)
+    mag = raw_reading(field, 0.0, rng)
+    raw = mag.copy()
+    assert MagCalibration.apply(mag) is mag
+    assert np.allclose(mag, field, atol=0.3e-6)
+    assert np.array_equal(MagCalibration.last_raw, raw)
+
+
+def test_calibration_needs_attitude_diversity():
+    rng = np.random.default_rng(3)
+    direction = random_direction(rng)
+    for k in range(2 * _WINDOW):
+        # Fixed attitude: the field only changes in strength, the parameters are not observable
+        strength = 40.0e-6 + 15.0e-6 * np.sin(2 * np.pi * k * _SAMPLE_PERIOD / 5600.0)
+        assert not MagCalibration.add_sample(raw_reading(strength * direction, 0.2e-6, rng), strength, k * _SAMPLE_PERIOD)
+    assert MagCalibration.samples == 0
+    assert np.array_equal(MagCalibration.soft_iron, np.eye(3))
+
+
+def test_sample_period_and_load():
+    assert MagCalibration.add_sample(np.ones(3) * 1e-5, 3e-5, 100) is False
+    MagCalibration.add_sample(np.ones(3) * 1e-5, 3e-5, 100 + _SAMPLE_PERIOD - 1)
+    assert MagCalibration._count == 1
+
+    MagCalibration.load((1.0e-6, 2.0e-6, 3.0e-6), (1.1, 0.0, 0.0, 0.9, 0.0, 1.0), 200, 1.0e-7)
+    mag = np.array([11.0e-6, 2.0e-6, 3.0e-6])
+    MagCalibration.apply(mag)
+    assert np.allclose(mag, [11.0e-6, 0.0, 0.0])
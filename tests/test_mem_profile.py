@@ -0,0 +1,44 @@
+import asyncio
+
+import tests.cp_mock  # noqa: F401
+from flight.core import template_task
+from flight.core.template_task import TemplateTask
+from flight.tasks import obdh
+
+
+def test_task_memory_profile(monkeypatch):
+    heap = [10000]
+    cycle_alloc = [0]
+
+    async def main_task():
+        heap[0] += cycle_alloc[0]
+
+    monkeypatch.setattr(template_task.gc, "mem_alloc", lambda: heap[0])
+    monkeypatch.setattr(template_task.gc, "collect", lambda: heap.__setitem__(0, 10000))
+    monkeypatch.setattr(TemplateTask, "mem_profile", True)
+    task = TemplateTask(0)
+    task.main_task = main_task
+
+    for alloc in (300, 1200, 500):
+        cycle_alloc[0] = alloc
+        asyncio.run(task._run())
+    assert task.mem_alloc_bytes == 2000
+    assert task.mem_alloc_peak == 1200
+    assert task.mem_gc_count == 0
+
+    # Collection forced by the allocator during main_task: counted, allocation unknown
+    cycle_alloc[0] = -4000
+    asyncio.run(task._run())
+    assert task.mem_alloc_bytes == 2000
+    assert task.mem_gc_count == 1
+
+
+def test_largest_free_block(monkeypatch):
+    def fake_bytearray(size):
+        if size > 1234:
+            raise MemoryError
+        return b""
+
+    monkeypatch.setattr(obdh.gc, "mem_free", lambda: 50000)
+    monkeypatch.setattr(obdh, "bytearray", fake_bytearray, raising=False)
+    assert obdh.largest_free_block() == 1234
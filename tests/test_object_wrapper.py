@@ -0,0 +1,53 @@
+import pytest
+
+import tests.cp_mock  # noqa: F401
+from emulator.drivers.errors import Errors
+from flight.hal.drivers.objectWrapper import objectWrapper
+
+
+class Driver:
+    def __init__(self):
+        self.value = 1
+        self.calls = 0
+
+    def read(self, offset=0, scale=1):
+        self.calls += 1
+        return (self.value + offset) * scale
+
+    def fail(self):
+        raise OSError("I2C timeout")
+
+    @property
+    def device_errors(self):
+        return []
+
+
+def test_wrapped_methods_cached():
+    driver = Driver()
+    device = objectWrapper(driver)
+
+    assert device.read() == 1
+    assert device.read(1, scale=2) == 4
+    assert device.read is device.read
+    assert driver.calls == 2
+
+    # Data attributes are not cached
+    driver.value = 5
+    assert device.value == 5
+    assert device.device_errors == []
+
+
+def test_wrapped_method_error():
+    device = objectWrapper(Driver())
+
+    with pytest.raises(RuntimeError, match="Error calling method 'fail': I2C timeout"):
+        device.fail()
+    assert device.device_errors == [Errors.FN_CALL_ERROR]
+
+    device = objectWrapper(Driver())
+    with pytest.raises(RuntimeError, match="Error accessing attribute 'missing'"):
+        device.missing
+    assert device.fnError
+
+    with pytest.raises(RuntimeError, match="Recursive access"):
+        objectWrapper(objectWrapper(Driver())).read()
@@ -0,0 +1,107 @@
+# isort: skip_file
+import sys
+from array import array
+from types import SimpleNamespace
+
+import pytest
+
+import tests.cp_mock  # noqa: F401
+
+# The driver only needs the bus device and register names at import time
+_register = SimpleNamespace(ROBit=lambda *args, **kwargs: None, RWBit=lambda *args, **kwargs: None)
+sys.modules.setdefault("adafruit_bus_device", SimpleNamespace())
+sys.modules.setdefault("adafruit_bus_device.i2c_device", SimpleNamespace(I2CDevice=object))
+sys.modules.setdefault("adafruit_register", SimpleNamespace())
+sys.modules.setdefault("adafruit_register.i2c_bit", _register)
+sys.modules.setdefault("adafruit_register.i2c_bits", SimpleNamespace(RWBits=lambda *args, **kwargs: None))
+
+from flight.hal.drivers.opt4001 import OPT4001, RESULT_H, SOT_5X3, decode_result, decode_results  # noqa: E402
+
+
+def reference_crc(exponent, mantissa, counter):
+    """CRC bits, bit by bit as written in the datasheet"""
+
+    def bits(value, width):
+        return [(value >> i) & 1 for i in range(width)]
+
+    E, R, C = bits(exponent, 4), bits(mantissa, 20), bits(counter, 4)
+    x0 = sum(E) + sum(R) + sum(C)
+    x1 = C[1] + C[3] + sum(R[1::2]) + E[1] + E[3]
+    x2 = C[3] + R[3] + R[7] + R[11] + R[15] + R[19] + E[3]
+    x3 = R[3] + R[11] + R[19]
+    return (x3 & 1) << 3 | (x2 & 1) << 2 | (x1 & 1) << 1 | (x0 & 1)
+
+
+def result_registers(exponent, mantissa, counter, crc):
+    return bytearray([exponent << 4 | mantissa >> 16, (mantissa >> 8) & 0xFF, mantissa & 0xFF, counter << 4 | crc])
+
+
+@pytest.mark.parametrize(
+    "exponent, mantissa, counter", [(0, 0, 0), (3, 0x12345, 7), (8, 0xFFFFF, 15), (15, 0x80808, 10), (1, 0xAAAAA, 5)]
+)
+def test_decode_result(exponent, mantissa, counter):
+    crc = reference_crc(exponent, mantissa, counter)
+
+    assert decode_result(result_registers(exponent, mantissa, counter, crc)) == (exponent, mantissa, counter, True)
+    for bad_crc in range(16):
+        if bad_crc != crc:
+            assert decode_result(result_registers(exponent, mantissa, counter, bad_crc))[3] is False
+
+
+def test_decode_results():
+    results = [(0, 0, 0), (3, 0x12345, 7), (8, 0xFFFFF, 15), (15, 0x80808, 10), (1, 0xAAAAA, 5)]
+    raw = bytearray()
+    for exponent, mantissa, counter in results:
+        raw += result_registers(exponent, mantissa, counter, reference_crc(exponent, mantissa, counter))
+    raw[7] ^= 0x01  # corrupt the CRC of the second result
+    raw[9] ^= 0x10  # and a mantissa bit of the third
+    scales = array("f", [0.0004375, 0.0003125, 0.000535, 0.0004375, 0.0003125])
+    lux = array("f", [0.0] * len(results))
+    counters = bytearray(len(results))
+
+    assert decode_results(raw, scales, lux, counters) == 0b11001
+    assert list(counters) == [counter for _, _, counter in results]
+    for i, (exponent, mantissa, _) in enumerate(results):
+        if i == 2:
+            continue
+        assert lux[i] == array("f", [(mantissa << exponent) * scales[i]])[0]  # rounded once to float
+
+
+class MockI2C:
+    def __init__(self, registers):
+        self.registers = registers
+        self.reads = []
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        pass
+
+    def write_then_readinto(self, out_buffer, in_buffer, out_end=None, in_start=0, in_end=None):
+        self.reads.append(out_buffer[0])
+        in_buffer[in_start:in_end] = self.registers
+
+
+def test_read_latest():
+    sensor = OPT4001.__new__(OPT4001)
+    sensor.i2c_device = MockI2C(result_registers(2, 0x01000, 9, reference_crc(2, 0x01000, 9)))
+    sensor.buf = bytearray(3)
+    sensor.result_buf = bytearray(4)
+    sensor.package = SOT_5X3
+    sensor.lux_per_code = 0.0004375
+
+    assert sensor.read_latest() == (pytest.approx((0x01000 << 2) * 0.0004375), 9, True)
+    assert sensor.i2c_device.reads == [RESULT_H]  # one burst, no flag polling
+
+
+def test_read_result_into():
+    sensor = OPT4001.__new__(OPT4001)
+    registers = result_registers(2, 0x01000, 9, reference_crc(2, 0x01000, 9))
+    sensor.i2c_device = MockI2C(registers)
+    sensor.buf = bytearray(3)
+    raw = bytearray(12)
+
+    sensor.read_result_into(raw, 4)
+    assert raw == bytearray(4) + registers + bytearray(4)
+    assert sensor.i2c_device.reads == [RESULT_H]
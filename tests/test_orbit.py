@@ -0,0 +1,108 @@
+import numpy as np
+import pytest
+
+import tests.cp_mock  # noqa: F401
+from flight.apps.orbit import propagator
+from flight.apps.orbit.propagator import (
+    OrbitPropagator,
+    _acceleration,
+    eci_to_ecef,
+    ecef_to_eci,
+    gmst,
+    sun_direction_eci,
+)
+from flight.core.dh_constants import GPS_IDX
+
+_EPOCH = 1735689600  # 2025-01-01 00:00:00 UTC
+_R_ECEF = np.array([6778137.0, 0.0, 0.0])
+_V_ECEF = np.array([0.0, 4000.0, 6400.0])
+
+
+def _reference(r, v, duration, h=1.0):
+    """Fine-step RK4 reference solution of the same dynamics."""
+    for _ in range(int(duration / h)):
+        a1 = _acceleration(r)
+        a2 = _acceleration(r + 0.5 * h * v)
+        a3 = _acceleration(r + 0.5 * h * (v + 0.5 * h * a1))
+        a4 = _acceleration(r + h * (v + 0.5 * h * a2))
+        r, v = (
+            r + h * v + h * h / 6.0 * (a1 + a2 + a3),
+            v + h / 6.0 * (a1 + 2 * a2 + 2 * a3 + a4),
+        )
+    return r, v
+
+
+@pytest.fixture
+def gps_log(monkeypatch):
+    record = [0] * 18
+    monkeypatch.setattr(propagator.DH, "data_process_exists", lambda tag: tag == "gps")
+    monkeypatch.setattr(propagator.DH, "get_latest_data", lambda tag: record)
+    OrbitPropagator.epoch = None
+    return record
+
+
+def _log_fix(record, unix_time, r_ecef, v_ecef):
+    record[GPS_IDX.GPS_LAST_FIX_TIME] = unix_time
+    record[GPS_IDX.GPS_ECEF_X : GPS_IDX.GPS_ECEF_Z + 1] = [int(x * 100) for x in r_ecef]
+    record[GPS_IDX.GPS_ECEF_VX : GPS_IDX.GPS_ECEF_VZ + 1] = [int(x * 100) for x in v_ecef]
+
+
+def test_gmst_j2000():
+    # GMST at J2000.0 is 280.46061837 deg
+    assert np.degrees(gmst(946728000)) == pytest.approx(280.46061837, abs=1e-3)
+
+
+def test_frame_round_trip():
+    r_eci, v_eci = ecef_to_eci(_EPOCH, _R_ECEF, _V_ECEF)
+    r_ecef, v_ecef = eci_to_ecef(_EPOCH, r_eci, v_eci)
+    assert np.linalg.norm(r_eci) == pytest.approx(np.linalg.norm(_R_ECEF))
+    assert np.allclose(r_ecef, _R_ECEF, atol=1e-6)
+    assert np.allclose(v_ecef, _V_ECEF, atol=1e-6)
+
+
+def test_sun_direction():
+    # Close to the vernal equinox the sun lies near +X ECI, at the June solstice near +Y with +23.4 deg declination
+    assert sun_direction_eci(1742460000)[0] == pytest.approx(1.0, abs=1e-3)
+    solstice = sun_direction_eci(1750508400)
+    assert np.degrees(np.arcsin(solstice[2])) == pytest.approx(23.44, abs=0.05)
+
+
+def test_unseeded(gps_log):
+    assert OrbitPropagator.state_eci(_EPOCH) == (None, None)
+    assert not OrbitPropagator.is_valid(_EPOCH)
+
+
+def test_seed_from_gps_log(gps_log):
+    _log_fix(gps_log, _EPOCH, _R_ECEF, _V_ECEF)
+    r_ecef, v_ecef = OrbitPropagator.state_ecef(_EPOCH)
+    assert OrbitPropagator.epoch == _EPOCH
+    assert np.allclose(r_ecef, _R_ECEF, atol=0.01)
+    assert np.allclose(v_ecef, _V_ECEF, atol=0.01)
+
+
+def test_propagation_matches_reference(gps_log):
+    _log_fix(gps_log, _EPOCH, _R_ECEF, _V_ECEF)
+    r0, v0 = ecef_to_eci(_EPOCH, _R_ECEF, _V_ECEF)
+    r_ref, v_ref = _reference(r0, v0, 5400)
+
+    # Incremental queries stay on the fine-step reference trajectory
+    for t in range(0, 5401, 600):
+        r, v = OrbitPropagator.state_eci(_EPOCH + t)
+    assert np.linalg.norm(r - r_ref) < 5.0
+    assert np.linalg.norm(v - v_ref) < 5e-3
+
+    # Jumping back close to the seed restarts from the seed
+    r, _ = OrbitPropagator.state_eci(_EPOCH)
+    assert np.allclose(r, r0)
+
+
+def test_reseed_on_new_fix(gps_log):
+    _log_fix(gps_log, _EPOCH, _R_ECEF, _V_ECEF)
+    OrbitPropagator.state_eci(_EPOCH + 3000)
+
+    _log_fix(gps_log, _EPOCH + 6000, -_R_ECEF, -_V_ECEF)
+    r_ecef, _ = OrbitPropagator.state_ecef(_EPOCH + 6000)
+    assert OrbitPropagator.epoch == _EPOCH + 6000
+    assert np.allclose(r_ecef, -_R_ECEF, atol=0.01)
+    assert OrbitPropagator.is_valid(_EPOCH + 6000)
+    assert not OrbitPropagator.is_valid(_EPOCH + 6000 + 3 * 86400)
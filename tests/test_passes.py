@@ -0,0 +1,86 @@
+import numpy as np
+import pytest
+
+import tests.cp_mock  # noqa: F401
+from flight.apps.comms.passes import PassPredictor, sin_elevation, station_ecef
+from flight.apps.orbit import propagator
+from flight.apps.orbit.propagator import OrbitPropagator, eci_to_ecef, ecef_to_eci
+from flight.core.dh_constants import GPS_IDX
+
+_EPOCH = 1735689600  # 2025-01-01 00:00:00 UTC
+_STATION = (40.4433, -79.9436, 300.0)
+
+
+@pytest.fixture
+def seeded(monkeypatch):
+    # Start right above the station so the first pass is in progress at the epoch
+    station, up = station_ecef(*_STATION)
+    r_ecef = up * 6878137.0
+    east = np.cross(np.array([0.0, 0.0, 1.0]), up)
+    north = np.cross(up, east / np.linalg.norm(east))
+    v_eci = 7612.0 * north  # circular, heading north
+    r_eci, _ = ecef_to_eci(_EPOCH, r_ecef, np.zeros(3))
+    _, v_ecef = eci_to_ecef(_EPOCH, r_eci, v_eci)
+
+    record = [0] * 18
+    record[GPS_IDX.GPS_LAST_FIX_TIME] = _EPOCH
+    record[GPS_IDX.GPS_ECEF_X : GPS_IDX.GPS_ECEF_Z + 1] = [int(x * 100) for x in r_ecef]
+    record[GPS_IDX.GPS_ECEF_VX : GPS_IDX.GPS_ECEF_VZ + 1] = [int(x * 100) for x in v_ecef]
+    monkeypatch.setattr(propagator.DH, "data_process_exists", lambda tag: tag == "gps")
+    monkeypatch.setattr(propagator.DH, "get_latest_data", lambda tag: record)
+    monkeypatch.setattr(PassPredictor, "stations", [station_ecef(*_STATION)])
+    monkeypatch.setattr(PassPredictor, "enabled", True)
+    monkeypatch.setattr(PassPredictor, "min_sin_elevation", np.sin(np.radians(5)))
+    OrbitPropagator.epoch = None
+    PassPredictor.reset()
+
+
+def _truth_visible(unix_time):
+    station, up = station_ecef(*_STATION)
+    r_ecef, _ = OrbitPropagator.state_ecef(unix_time)
+    return sin_elevation(r_ecef, station, up) >= np.sin(np.radians(5))
+
+
+def test_unknown_without_seed(monkeypatch):
+    monkeypatch.setattr(PassPredictor, "enabled", True)
+    monkeypatch.setattr(propagator.DH, "data_process_exists", lambda tag: False)
+    OrbitPropagator.epoch = None
+    PassPredictor.update(_EPOCH)
+    assert PassPredictor.in_pass(_EPOCH) is None
+
+
+def test_station_ecef():
+    position, up = station_ecef(0.0, 0.0, 0.0)
+    assert np.allclose(position, [6378137.0, 0.0, 0.0])
+    assert np.allclose(up, [1.0, 0.0, 0.0])
+
+
+def test_windows_cover_truth(seeded):
+    PassPredictor.update(_EPOCH)
+    assert PassPredictor.in_pass(_EPOCH) is True
+
+    # Update cost is bounded: the horizon is only filled over several calls
+    assert PassPredictor._t < _EPOCH + 7200
+    while PassPredictor._t < _EPOCH + 7200:
+        PassPredictor.update(_EPOCH)
+
+    assert len(PassPredictor.windows) >= 1
+    aos, los = PassPredictor.windows[0]
+    assert aos <= _EPOCH < los
+
+    # Every instant seen by the station at 10 s resolution lies inside a predicted window
+    for t in range(_EPOCH, _EPOCH + 7200, 10):
+        if _truth_visible(t):
+            assert PassPredictor.in_pass(t) is True
+
+    # Out of pass time exists and is reported as such
+    assert any(PassPredictor.in_pass(t) is False for t in range(_EPOCH, _EPOCH + 7200, 60))
+    assert PassPredictor.in_pass(_EPOCH + 7200 + 600) is None
+
+
+def test_restart_on_new_fix(seeded):
+    PassPredictor.update(_EPOCH)
+    OrbitPropagator.epoch = None
+    propagator.DH.get_latest_data("gps")[GPS_IDX.GPS_LAST_FIX_TIME] = _EPOCH + 60
+    PassPredictor.update(_EPOCH + 60)
+    assert PassPredictor._epoch == _EPOCH + 60
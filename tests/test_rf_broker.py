@@ -0,0 +1,94 @@
+import heapq
+
+import pytest
+
+from emulator.rf_channel import FRAME_RX, FRAME_TX, decode_frames, encode_frame, time_on_air
+from sil.rf_broker import KIND_FSW, ChannelBroker, Node
+
+
+@pytest.fixture
+def broker():
+    broker = ChannelBroker("127.0.0.1", 0)
+    broker.clock = 0.0
+    broker.now = lambda: broker.clock
+    yield broker
+    broker.close()
+
+
+def _advance(broker, to):
+    while broker.events and broker.events[0][0] <= to:
+        at, _, callback = heapq.heappop(broker.events)
+        broker.clock = at
+        callback()
+    broker.clock = to
+
+
+def test_time_on_air():
+    # SF7 / 125 kHz / 4/5, 8 symbol preamble, explicit header and CRC
+    assert time_on_air(20) == pytest.approx(0.0566, abs=1e-4)
+    assert time_on_air(200) > time_on_air(100) > time_on_air(20)
+
+
+def test_frames():
+    stream = encode_frame(FRAME_TX, b"abc") + encode_frame(FRAME_RX, b"")
+    frames, rest = decode_frames(stream + encode_frame(FRAME_TX, b"partial")[:4])
+    assert frames == [(FRAME_TX, b"abc"), (FRAME_RX, b"")]
+    assert len(rest) == 4
+
+
+def test_delivery_and_collisions(broker):
+    satellite = broker.add_node(Node("sat1", KIND_FSW))
+    user1 = broker.add_node(Node("u1", "aprs"))
+    user2 = broker.add_node(Node("u2", "aprs"))
+
+    broker.transmit(user1, b"x" * 20)
+    _advance(broker, 1.0)
+    assert satellite.rx_packets == 1
+    assert user2.rx_packets == 0  # ground nodes do not hear each other
+
+    # Overlapping transmissions are both lost
+    broker.transmit(user1, b"x" * 20)
+    broker.clock += 0.01
+    broker.transmit(user2, b"x" * 20)
+    _advance(broker, 2.0)
+    assert satellite.rx_packets == 1
+    assert satellite.lost_collision == 2
+    assert broker.collisions == 2
+
+    # A satellite transmitting while an uplink is on the air loses it too (half duplex)
+    broker.transmit(satellite, b"y" * 200)
+    broker.clock += 0.1
+    broker.transmit(user1, b"x" * 20)
+    _advance(broker, 3.0)
+    assert satellite.rx_packets == 1
+    assert user1.rx_packets == 0
+
+    # Random loss
+    broker.loss = 1.0
+    broker.transmit(user1, b"x" * 20)
+    _advance(broker, 4.0)
+    assert satellite.lost_random == 1
+
+
+def test_digipeater_accounting(broker):
+    satellite = broker.add_node(Node("sat1", KIND_FSW))
+    user = broker.add_node(Node("u1", "aprs"))
+
+    heard = b"\x3c\xff\x01U001>APLRG1,CT6xxx,WIDE1-1:>ID1000001"
+    broker.transmit(user, heard)
+    broker.aprs_origin[1000001] = (user, 0.0)
+    _advance(broker, 1.0)
+    broker.transmit(user, heard.replace(b"1000001", b"1000002"))  # heard, never repeated
+    broker.aprs_origin[1000002] = (user, 1.0)
+    _advance(broker, 5.0)
+
+    repeated = heard.replace(b"CT6xxx", b"CT6xxx*")
+    broker.transmit(satellite, repeated)
+    _advance(broker, 6.0)
+
+    report = broker.report()["nodes"]
+    assert report["sat1"]["aprs_heard"] == 2
+    assert report["sat1"]["aprs_repeated"] == 1
+    assert report["sat1"]["aprs_queue_drops"] == 1
+    assert report["sat1"]["latency_p50_s"] == pytest.approx(5.0 + time_on_air(len(repeated)))
+    assert report["u1"]["latency_max_s"] == pytest.approx(report["sat1"]["latency_max_s"])
@@ -0,0 +1,130 @@
+import pytest
+
+import tests.cp_mock  # noqa: F401
+from flight.core.scheduler import scheduler
+from flight.core.scheduler.scheduler import OverrunPolicy, Scheduler
+
+_MS = 1000000
+
+
+@pytest.fixture
+def clock(monkeypatch):
+    now = [0]
+
+    def sleep(seconds):
+        now[0] += int(seconds * 1e9)
+
+    monkeypatch.setattr(scheduler, "_monotonic_ns", lambda: now[0])
+    monkeypatch.setattr(scheduler.time, "sleep", sleep)
+    return now
+
+
+def run_task(clock, overrun, work_ms, end_ms, hz=10):
+    """Runs a task taking work_ms[i] (last value repeated) on its i-th iteration, returns its start times [ms]."""
+    loop = Scheduler()
+    starts = []
+
+    async def work():
+        starts.append(clock[0] // _MS)
+        clock[0] += work_ms[min(len(starts), len(work_ms)) - 1] * _MS
+
+    task = loop.schedule(hz, work, 1, overrun=overrun)
+    while clock[0] < end_ms * _MS:
+        loop._step()
+    return task, starts
+
+
+def test_skip_drops_missed_releases(clock):
+    task, starts = run_task(clock, OverrunPolicy.SKIP, [10, 250, 10], 600)
+
+    # The 100 ms release ends at 350 ms: the 200 and 300 ms releases are dropped, back on the grid at 400 ms
+    assert starts == [0, 100, 400, 500]
+    assert task.overruns == 1
+    assert task.skipped == 2
+
+
+def test_catch_up_runs_missed_releases(clock):
+    task, starts = run_task(clock, OverrunPolicy.CATCH_UP, [10, 250, 10], 600)
+
+    # The 200 and 300 ms releases run back to back once the long iteration ends, the 200 ms one after its deadline
+    assert starts == [0, 100, 350, 360, 400, 500]
+    assert task.overruns == 2
+    assert task.skipped == 0
+
+
+def test_catch_up_bounded(clock):
+    task, starts = run_task(clock, OverrunPolicy.CATCH_UP, [10, 1000, 10], 1300)
+
+    # Too far behind to catch up: dropped as with SKIP
+    assert starts == [0, 100, 1200]
+    assert task.skipped == 10
+
+
+def test_degrade_halves_rate_then_restores(clock):
+    task, starts = run_task(clock, OverrunPolicy.DEGRADE, [300, 300, 300, 10], 1300)
+
+    # Each overrun doubles the period: 100, 200 (the 200 ms release dropped), then 400 ms, long enough for the task
+    assert starts == [0, 400, 800, 1200]
+    assert task.degrade == 4
+    assert task.overruns == 2
+    assert task.skipped == 1
+
+    # Doubled back after each run of 8 iterations within the deadline
+    while clock[0] < 10000 * _MS:
+        task._loop._step()
+    assert task.degrade == 1
+    assert starts[-1] - starts[-2] == 100
+
+
+def test_admission(clock):
+    loop = Scheduler()
+    loop.set_utilisation_bound(0.8)
+
+    async def work():
+        pass
+
+    assert loop.schedule(10, work, 1, budget=0.05).admitted
+    # Over the bound: refused and not started, unless critical
+    task = loop.schedule(1, work, 2, budget=0.4, critical=False)
+    assert not task.admitted
+    assert len(loop._tasks) == 1
+    assert loop.schedule_later(1, work, 2, budget=0.3, critical=False).admitted
+    assert loop.utilisation() == pytest.approx(0.8)
+
+    # Tasks without a budget are not counted
+    loop.schedule(100, work, 3)
+    assert loop.utilisation() == pytest.approx(0.8)
+
+    task = loop.schedule(1, work, 1, budget=0.1)
+    assert not task.admitted
+    assert len(loop._tasks) == 4
+    assert loop.utilisation() == pytest.approx(0.9)
+
+    # Rate changes are reflected in the budgeted utilisation
+    task.change_rate(0.5)
+    assert loop.utilisation() == pytest.approx(0.85)
+
+    for task in loop._tasks:
+        task.coroutine.close()
+
+
+def test_heartbeat_while_stepping(clock):
+    loop = Scheduler()
+    beats = []
+    hang = [False]
+
+    async def work():
+        if hang[0]:
+            clock[0] += 5000 * _MS
+
+    loop.set_heartbeat(lambda: beats.append(clock[0] // _MS), 1.0)
+    loop.schedule(10, work, 1)
+    while clock[0] < 3000 * _MS:
+        loop._step()
+    assert beats == [0, 1000, 2000]
+
+    # Delayed by a task blocking the loop
+    hang[0] = True
+    loop._step()
+    loop._step()
+    assert beats[-1] >= 8000
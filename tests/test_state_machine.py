@@ -0,0 +1,194 @@
+from types import SimpleNamespace
+
+import pytest
+
+import tests.cp_mock  # noqa: F401
+from flight.core import state_machine
+from flight.core.state_machine import StateManager
+from flight.core.states import STATES
+from flight.core.scheduler.scheduler import Scheduler
+from flight.core.template_task import TemplateTask
+
+_FAST, _SLOW, _LOW = 0, 1, 2
+
+
+class FakeScheduledTask:
+    def __init__(self, hz):
+        self.hz = hz
+        self.admitted = True
+
+    def change_rate(self, hz):
+        self.hz = hz
+
+    def stop(self):
+        pass
+
+
+@pytest.fixture
+def sm(monkeypatch):
+    monkeypatch.setattr(state_machine.scheduler, "schedule", lambda hz, fn, priority, **kwargs: FakeScheduledTask(hz))
+    monkeypatch.setattr(state_machine.scheduler, "set_utilisation_bound", lambda bound: None)
+    monkeypatch.setattr(state_machine.scheduler, "utilisation", lambda: 0.0)
+    monkeypatch.setattr(state_machine, "SATELLITE", SimpleNamespace(PAYLOADPOWER_AVAILABLE=False))
+    StateManager._instance = None
+    manager = StateManager()
+    manager._StateManager__task_config = {
+        _FAST: {"Task": TemplateTask, "Frequency": 5, "Priority": 1},
+        _SLOW: {"Task": TemplateTask, "Frequency": 2, "Priority": 2},
+        _LOW: {"Task": TemplateTask, "Frequency": 4, "Priority": 3},
+    }
+    manager._StateManager__state_rate_profiles = {STATES.DETUMBLING: {_FAST: 10}, STATES.LOW_POWER: {_FAST: 1}}
+    manager._StateManager__activity_rate_profiles = {0: {_SLOW: 1}}
+    manager._StateManager__cpu_budget = {
+        "Utilisation": 0.8,
+        "Restore": 0.4,
+        "Smoothing": 0.5,
+        "Dwell": 2,
+        "MinPriority": 2,
+        "MaxThrottle": 4,
+    }
+    manager._StateManager__states = [STATES.STARTUP, STATES.DETUMBLING, STATES.NOMINAL, STATES.LOW_POWER]
+    manager._StateManager__tasks = {task_id: TemplateTask(task_id) for task_id in range(3)}
+    manager.switch_to(STATES.STARTUP)
+    yield manager
+    StateManager._instance = None
+
+
+def _rates(manager):
+    return {task_id: task.hz for task_id, task in manager.scheduled_tasks.items()}
+
+
+def test_state_profiles(sm):
+    assert _rates(sm) == {_FAST: 5, _SLOW: 2, _LOW: 4}
+
+    sm.switch_to(STATES.DETUMBLING)
+    assert _rates(sm) == {_FAST: 10, _SLOW: 2, _LOW: 4}
+    assert sm._StateManager__tasks[_FAST].frequency == 10
+
+    sm.switch_to(STATES.NOMINAL)
+    assert _rates(sm) == {_FAST: 5, _SLOW: 2, _LOW: 4}
+
+    sm.switch_to(STATES.LOW_POWER)
+    assert _rates(sm)[_FAST] == 1
+
+
+def test_activity_profile(sm):
+    sm.switch_to(STATES.DETUMBLING)
+    sm.set_activity(0, True)
+    assert _rates(sm) == {_FAST: 10, _SLOW: 1, _LOW: 4}
+
+    # Activity overrides persist across state switches
+    sm.switch_to(STATES.NOMINAL)
+    assert _rates(sm) == {_FAST: 5, _SLOW: 1, _LOW: 4}
+
+    sm.set_activity(0, False)
+    assert _rates(sm)[_SLOW] == 2
+
+
+@pytest.fixture
+def govern(sm, monkeypatch):
+    """Runs the governor after a 1 s window in which each task used busy[task_id] s of CPU, io of it blocked on I/O."""
+    now = [1_000_000_000]
+    monkeypatch.setattr(state_machine.time, "monotonic_ns", lambda: now[0])
+    tasks = sm._StateManager__tasks
+    sm.govern_cpu_budget()  # first call only takes the reference
+
+    def run(busy, io=0.0):
+        now[0] += 1_000_000_000
+        for task_id, busy_s in busy.items():
+            tasks[task_id].run_time_ns += int(busy_s * 1_000_000_000)
+        tasks[_FAST].io_time_ns += int(io * 1_000_000_000)
+        sm.govern_cpu_budget()
+
+    return run
+
+
+def test_cpu_budget_governor(sm, govern):
+    # Sustained overload: the eligible task using the most CPU is throttled, not the lowest priority one, and rates
+    # change at most once per Dwell
+    rates = []
+    for _ in range(6):
+        govern({_FAST: 0.2, _SLOW: 0.7})
+        rates.append(_rates(sm)[_SLOW])
+    assert rates == [2, 2, 2, 1, 1, 0.5]  # down to 1 / MaxThrottle
+    assert _rates(sm) == {_FAST: 5, _SLOW: 0.5, _LOW: 4}
+
+    # Between Restore and the budget: hold
+    for _ in range(4):
+        govern({_FAST: 0.6})
+    assert _rates(sm)[_SLOW] == 0.5
+
+    # Under Restore: restore step by step
+    rates = []
+    for _ in range(6):
+        govern({_FAST: 0.1})
+        rates.append(_rates(sm)[_SLOW])
+    assert rates == [1, 1, 2, 2, 2, 2]
+
+
+def test_cpu_budget_governor_ignores_spikes(sm, govern):
+    # One busy window (e.g. a blocking transmission) does not throttle
+    govern({_LOW: 1.0})
+    for _ in range(6):
+        govern({_FAST: 0.03})
+    assert _rates(sm) == {_FAST: 5, _SLOW: 2, _LOW: 4}
+
+    # Time blocked on device I/O is not CPU load
+    for _ in range(6):
+        govern({_FAST: 0.95}, io=0.9)
+    assert _rates(sm) == {_FAST: 5, _SLOW: 2, _LOW: 4}
+
+
+def test_overcommit_logged_on_rate_change(sm, monkeypatch):
+    warnings = []
+    monkeypatch.setattr(state_machine.logger, "warning", warnings.append)
+    tasks = sm._StateManager__tasks
+
+    # Measured: 60 ms per iteration of the fast task, 50 ms for the others, 0.6 of the CPU at the nominal rates
+    for task_id, run_ms in ((_FAST, 60), (_SLOW, 50), (_LOW, 50)):
+        tasks[task_id].iterations = 10
+        tasks[task_id].run_time_ns = 10 * run_ms * 1_000_000
+    assert sm.utilisation() == pytest.approx(5 * 0.06 + 2 * 0.05 + 4 * 0.05)
+
+    # DETUMBLING doubles the fast task: 0.9, over the budget, logged and still applied
+    sm.switch_to(STATES.DETUMBLING)
+    assert _rates(sm)[_FAST] == 10
+    assert len(warnings) == 1
+
+    sm.switch_to(STATES.NOMINAL)
+    assert len(warnings) == 1
+
+    sm.change_task_frequency(_LOW, 10)
+    assert len(warnings) == 2
+
+
+def test_admission_at_boot(sm, monkeypatch):
+    warnings = []
+    monkeypatch.setattr(state_machine.logger, "warning", warnings.append)
+    config = sm._StateManager__task_config
+
+    def schedule_on_new_loop():
+        loop = Scheduler()
+        for name in ["schedule", "set_utilisation_bound", "utilisation"]:
+            monkeypatch.setattr(state_machine.scheduler, name, getattr(loop, name))
+        sm.schedule_tasks()
+        for task in loop._tasks:
+            task.coroutine.close()
+        tasks = sm.scheduled_tasks
+        return loop, [tasks[task_id].admitted for task_id in (_FAST, _SLOW, _LOW)]
+
+    config[_FAST]["Budget"] = 0.1  # 0.5
+    config[_SLOW]["Budget"] = 0.1  # 0.2
+    config[_LOW]["Budget"] = 0.05  # 0.2, over the 0.8 budget: not started
+    loop, admitted = schedule_on_new_loop()
+    assert admitted == [True, True, False]
+    assert len(loop._tasks) == 2
+    assert loop.utilisation() == pytest.approx(0.7)
+    assert len(warnings) == 1
+
+    # Critical tasks (priority below MinPriority) run even if their budget does not fit
+    config[_FAST]["Budget"] = 0.2  # 1.0
+    loop, admitted = schedule_on_new_loop()
+    assert admitted == [False, False, False]
+    assert len(loop._tasks) == 1
+    assert len(warnings) == 4
@@ -3,6 +3,7 @@ import pytest
 
 import tests.cp_mock  # noqa: F401
 from flight.apps.adcs.consts import StatusConst
+from flight.apps.adcs import sun
 from flight.apps.adcs.sun import _ERROR_LUX, compute_body_sun_vector_from_lux
 
 
@@ -60,3 +61,60 @@ def test_compute_body_sun_vector_from_lux(I_vec, expected):
 
 if __name__ == "__main__":
     pytest.main()
+
+
+class FakeLightSensor:
+    def __init__(self, lux):
+        self.lux = lux
+        self.counter = 0
+        self.crc_ok = True
+
+
+class FakeSatellite:
+    def __init__(self):
+        self.LIGHT_SENSORS = {face: FakeLightSensor(1000.0 * (i + 1)) for i, face in enumerate(sun._FACES)}
+
+    def LIGHT_SENSOR_AVAILABLE(self, face):
+        return face != "ZM"
+
+    def READ_LIGHT_SENSORS(self, faces, lux, counters):
+        valid = 0
+        for i, face in enumerate(faces):
+            sensor = self.LIGHT_SENSORS[face]
+            lux[i], counters[i] = sensor.lux, sensor.counter
+            if self.LIGHT_SENSOR_AVAILABLE(face) and sensor.crc_ok:
+                valid |= 1 << i
+        return valid
+
+
+def test_read_light_sensors_stale_and_crc(monkeypatch):
+    satellite = FakeSatellite()
+    monkeypatch.setattr(sun, "SATELLITE", satellite)
+    monkeypatch.setattr(sun, "_last_counter", [-1] * 9)
+    monkeypatch.setattr(sun, "stale_reads", [0] * 9)
+    sensors = satellite.LIGHT_SENSORS
+
+    assert sun.read_light_sensors() == [1000.0 * (i + 1) for i in range(8)] + [_ERROR_LUX]
+
+    # XP stops converting: its last result is used until it has been stale for _MAX_STALE_READS reads
+    for face, sensor in sensors.items():
+        sensor.counter = 1
+    sensors["XP"].counter = 0
+    sensors["XM"].crc_ok = False
+    readings = sun.read_light_sensors()
+    assert readings[:3] == [1000.0, _ERROR_LUX, 3000.0]
+    assert sun.stale_reads[0] == 1
+
+    for counter in (2, 3):
+        for face, sensor in sensors.items():
+            if face != "XP":
+                sensor.counter = counter
+        readings = sun.read_light_sensors()
+    assert readings[0] == _ERROR_LUX
+    assert readings[2] == 3000.0
+    assert sun.stale_reads[:3] == [3, 0, 0]
+
+    # A new conversion clears the stale tag
+    sensors["XP"].counter = 5
+    assert sun.read_light_sensors()[0] == 1000.0
+    assert sun.stale_reads[0] == 0
@@ -0,0 +1,97 @@
+# isort: skip_file
+import sys
+from types import SimpleNamespace
+
+import pytest
+
+import tests.cp_mock  # noqa: F401
+
+# The drivers only need the bus device and register names at import time (other driver tests may have set them up)
+_registers = {
+    "adafruit_register.i2c_bit": ["ROBit", "RWBit"],
+    "adafruit_register.i2c_bits": ["ROBits", "RWBits"],
+    "adafruit_register.i2c_struct": ["UnaryStruct"],
+}
+sys.modules.setdefault("adafruit_bus_device", SimpleNamespace())
+sys.modules.setdefault("adafruit_bus_device.i2c_device", SimpleNamespace(I2CDevice=object))
+sys.modules.setdefault("adafruit_register", SimpleNamespace())
+for module, names in _registers.items():
+    module = sys.modules.setdefault(module, SimpleNamespace())
+    for name in names:
+        if not hasattr(module, name):
+            setattr(module, name, lambda *args, **kwargs: None)
+
+from flight.hal.drivers import drv8235, drv8830  # noqa: E402
+
+
+class Register:
+    """Register descriptor counting the writes to it"""
+
+    def __init__(self, writes, name):
+        self.writes = writes
+        self.name = name
+
+    def __get__(self, obj, objtype=None):
+        return obj.__dict__.get(self.name, 0)
+
+    def __set__(self, obj, value):
+        obj.__dict__[self.name] = value
+        self.writes.append((self.name, value))
+
+
+@pytest.fixture
+def writes(monkeypatch):
+    writes = []
+    monkeypatch.setattr(drv8830, "I2CDevice", lambda i2c_bus, address: None)
+    monkeypatch.setattr(drv8235, "I2CDevice", lambda i2c_bus, address: None)
+    for name in ["_control", "_clear"]:
+        monkeypatch.setattr(drv8830.DRV8830, name, Register(writes, name))
+    for name in ["_wset_vset", "_dir", "_clear"]:
+        monkeypatch.setattr(drv8235.DRV8235, name, Register(writes, name))
+    return writes
+
+
+def test_drv8830_single_write_per_change(writes):
+    driver = drv8830.DRV8830(None)
+    writes.clear()
+
+    driver.set_throttle(0.5)
+    driver.set_throttle(0.5)
+    driver.set_throttle(0.501)  # same VSET code
+    assert writes == [("_control", 31 << 2 | drv8830.BridgeControl.FORWARD)]
+
+    writes.clear()
+    driver.set_throttle(-0.5)
+    driver.set_throttle(0)
+    driver.set_throttle(0)
+    assert writes == [("_control", 31 << 2 | drv8830.BridgeControl.REVERSE), ("_control", drv8830.BridgeControl.BRAKE)]
+
+    # Rewritten after a fault was cleared
+    driver.clear_faults()
+    writes.clear()
+    driver.set_throttle(0)
+    assert writes == [("_control", drv8830.BridgeControl.BRAKE)]
+
+
+def test_drv8235_writes_changed_registers(writes):
+    driver = drv8235.DRV8235(None, 0x30)
+    writes.clear()
+
+    driver.set_throttle(1.0)
+    driver.set_throttle(1.0)
+    assert writes == [("_wset_vset", 40), ("_dir", drv8235.BridgeControl.FORWARD)]
+
+    # Only the voltage changes
+    writes.clear()
+    driver.set_throttle(0.5)
+    assert writes == [("_wset_vset", 20)]
+
+    # Only the direction changes
+    writes.clear()
+    driver.set_throttle(-0.5)
+    assert writes == [("_dir", drv8235.BridgeControl.REVERSE)]
+
+    driver.clear_faults()
+    writes.clear()
+    driver.set_throttle(-0.5)
+    assert writes == [("_wset_vset", 20), ("_dir", drv8235.BridgeControl.REVERSE)]
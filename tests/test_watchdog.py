@@ -0,0 +1,112 @@
+# isort: skip_file
+import asyncio
+import sys
+from types import SimpleNamespace
+
+import tests.cp_mock  # noqa: F401
+
+sys.modules.setdefault("digitalio", SimpleNamespace())
+
+from flight.hal.drivers import watchdog as driver  # noqa: E402
+from flight.tasks import watchdog  # noqa: E402
+
+
+class FakeWatchdog:
+    def __init__(self, timer_backed):
+        self.timer_backed = timer_backed
+        self.enabled = False
+        self.input = True
+        self.events = []
+
+    def heartbeat(self, window):
+        self.events.append(("heartbeat", window))
+
+    def enable(self):
+        self.events.append("enable")
+        self.enabled = True
+
+    def input_low(self):
+        self.events.append("low")
+        self.input = False
+
+    def input_high(self):
+        self.events.append("high")
+        self.input = True
+
+
+def test_pio_watchdog_gated_by_scheduler_heartbeat(monkeypatch):
+    device = FakeWatchdog(timer_backed=True)
+    registered = []
+    monkeypatch.setattr(watchdog, "SATELLITE", SimpleNamespace(WATCHDOG_AVAILABLE=True, WATCHDOG=device))
+    monkeypatch.setattr(watchdog, "set_heartbeat", lambda callback, period: registered.append((callback, period)))
+    monkeypatch.setattr(watchdog, "CONFIG", SimpleNamespace(HEARTBEAT_WINDOW=10, HEARTBEAT_PERIOD=1))
+    task = watchdog.Task(0)
+
+    # Credit written before the watchdog is enabled, then refreshed from the scheduler loop only
+    asyncio.run(task.main_task())
+    asyncio.run(task.main_task())
+    assert device.events == [("heartbeat", 10), "enable"]
+    assert registered == [(task.heartbeat, 1)]
+    registered[0][0]()
+    assert device.events[-1] == ("heartbeat", 10)
+
+
+def test_gpio_watchdog_toggled_by_task(monkeypatch):
+    device = FakeWatchdog(timer_backed=False)
+    monkeypatch.setattr(watchdog, "SATELLITE", SimpleNamespace(WATCHDOG_AVAILABLE=True, WATCHDOG=device))
+    monkeypatch.setattr(watchdog, "set_heartbeat", lambda callback, period: 1 / 0)
+    task = watchdog.Task(0)
+
+    asyncio.run(task.main_task())
+    asyncio.run(task.main_task())
+    assert device.events == ["low", "enable", "high"]
+
+
+def run_pio(credits, seconds):
+    """
+    Runs the watchdog PIO program, credits being (time [s], word) FIFO writes. Returns the WDI edge times [s].
+    Only the instructions of the program are decoded: pull noblock, mov x osr, set, jmp (always, !x, x--, y--).
+    """
+    program, frequency = driver._PIO_PROGRAM, driver._PIO_PERIOD_CYCLES / driver.PIO_PERIOD
+    credits = list(credits)
+    pc = x = y = osr = cycle = 0
+    pin, fifo, edges = 1, [], []
+    while cycle < seconds * frequency:
+        while credits and credits[0][0] * frequency <= cycle:
+            fifo.append(credits.pop(0)[1])
+        word = program[pc]
+        op, delay, arg = word >> 13, (word >> 8) & 0x1F, word & 0xFF
+        pc = (pc + 1) % len(program)
+        if op == 0:  # jmp
+            cond, address = arg >> 5, arg & 0x1F
+            taken = (cond == 0) or (cond == 1 and x == 0) or (cond == 2 and x != 0) or (cond == 4 and y != 0)
+            x = (x - 1) & 0xFFFFFFFF if cond == 2 else x
+            y = (y - 1) & 0xFFFFFFFF if cond == 4 else y
+            pc = address if taken else pc
+        elif op == 4:  # pull noblock
+            osr = fifo.pop(0) if fifo else x
+        elif op == 5:  # mov x, osr
+            x = osr
+        elif op == 7:  # set
+            dest, data = arg >> 5, arg & 0x1F
+            if dest == 0 and data != pin:
+                pin = data
+                edges.append(cycle / frequency)
+            elif dest == 2:
+                y = data
+        cycle += 1 + delay
+    return edges
+
+
+def test_pio_program_toggles_while_credit_lasts():
+    # No credit: WDI held high
+    assert run_pio([], 3) == []
+
+    # 2 s of credit: an edge every quarter period
+    edges = run_pio([(0, int(2 / driver.PIO_PERIOD))], 6)
+    assert len(edges) == 7
+    assert all(abs(b - a - driver.PIO_PERIOD / 2) < 0.01 for a, b in zip(edges, edges[1:]))
+
+    # Replaced at 1.2 s: 4 more periods from the next one at 1.5 s, the last one low from 3.25 s
+    edges = run_pio([(0, 4), (1.2, 4)], 6)
+    assert 3.2 < edges[-1] < 3.3